@@ -14,7 +14,9 @@
 # ********************************************************************/
 
 HEADERS += src/infoview/htmlinfoview.h \
+        src/infoview/iconpixmapcache.h \
         src/infoview/scalediconframe.h
 
 SOURCES += src/infoview/htmlinfoview.cpp \
+        src/infoview/iconpixmapcache.cpp \
         src/infoview/scalediconframe.cpp
@@ -24,6 +24,7 @@ HEADERS += \
     src/items/jumperitem.h \
     src/items/layerkinpaletteitem.h \
     src/items/led.h \
+    src/items/levelofdetail.h \
     src/items/logoitem.h \
     src/items/moduleidnames.h \
     src/items/mysterypart.h \
@@ -64,6 +65,7 @@ SOURCES += \
     src/items/jumperitem.cpp \
     src/items/layerkinpaletteitem.cpp \
     src/items/led.cpp \
+    src/items/levelofdetail.cpp \
     src/items/logoitem.cpp \
     src/items/moduleidnames.cpp \
     src/items/mysterypart.cpp \
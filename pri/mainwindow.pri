@@ -14,6 +14,7 @@
 # ********************************************************************/
 HEADERS += \
 	src/mainwindow/fprobeactions.h \
+    src/mainwindow/exportsession.h \
     src/mainwindow/fdockwidget.h \
     src/mainwindow/fritzingwindow.h \
     src/mainwindow/mainwindow.h \
@@ -25,6 +26,7 @@ HEADERS += \
 
 SOURCES += \
 	src/mainwindow/fprobeactions.cpp \
+    src/mainwindow/exportsession.cpp \
     src/mainwindow/fdockwidget.cpp \
     src/mainwindow/fritzingwindow.cpp \
     src/mainwindow/mainwindow.cpp \
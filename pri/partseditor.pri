@@ -52,6 +52,7 @@ HEADERS += \
     src/partseditor/petoolview.h \
     src/partseditor/peutils.h \
     src/partseditor/pegraphicsitem.h \
+    src/partseditor/pesvgelementindex.h \
     src/partseditor/kicadmoduledialog.h \
     src/partseditor/hashpopulatewidget.h \
     src/partseditor/baseremovebutton.h \
@@ -87,5 +88,6 @@ SOURCES += \
     src/partseditor/petoolview.cpp \
     src/partseditor/peutils.cpp \
     src/partseditor/pegraphicsitem.cpp \
+    src/partseditor/pesvgelementindex.cpp \
     src/partseditor/kicadmoduledialog.cpp \
     src/partseditor/hashpopulatewidget.cpp \
@@ -1,10 +1,12 @@
 HEADERS += \
   src/simulation/FProbeStartSimulator.h \
   src/simulation/simulator.h \
-  src/simulation/ngspice_simulator.h
+  src/simulation/ngspice_simulator.h \
+  src/simulation/spicenetlistdiff.h
 
 SOURCES += \
   src/simulation/FProbeStartSimulator.cpp \
   src/simulation/simulator.cpp \
-  src/simulation/ngspice_simulator.cpp
+  src/simulation/ngspice_simulator.cpp \
+  src/simulation/spicenetlistdiff.cpp
 
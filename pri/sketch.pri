@@ -24,6 +24,8 @@ HEADERS += \
     src/sketch/zoomablegraphicsview.h \
     src/sketch/subpartswapmanager.h \
 	src/sketch/swapthing.h \
+	src/sketch/tilecache.h \
+	src/sketch/localclipboard.h \
 
 
 SOURCES += \
@@ -38,3 +40,5 @@ SOURCES += \
     src/sketch/zoomablegraphicsview.cpp \
     src/sketch/subpartswapmanager.cpp \
 	src/sketch/swapthing.cpp \
+	src/sketch/tilecache.cpp \
+	src/sketch/localclipboard.cpp \
@@ -31,6 +31,8 @@ HEADERS += src/svg/svgfilesplitter.h \
     src/svg/gedaelementgrammar_p.h \
     src/svg/gedaelementlexer.h \
     src/svg/clipperhelpers.h \
+    src/svg/contourtracer.h \
+    src/svg/svgpreloader.h \
     $$PWD/../src/svg/svgtext.h
 
 SOURCES += src/svg/svgfilesplitter.cpp \
@@ -51,4 +53,6 @@ SOURCES += src/svg/svgfilesplitter.cpp \
     src/svg/gedaelementparser.cpp \
     src/svg/gedaelementgrammar.cpp \
     src/svg/gedaelementlexer.cpp \
+    src/svg/svgpreloader.cpp \
+    src/svg/contourtracer.cpp \
     $$PWD/../src/svg/svgtext.cpp
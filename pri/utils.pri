@@ -38,12 +38,15 @@ src/utils/resizehandle.h \
 src/utils/folderutils.h \
 src/utils/graphicsutils.h \
 src/utils/graphutils.h \
+src/utils/gridindex.h \
 src/utils/ratsnestcolors.h \
 src/utils/schematicrectconstants.h \
 src/utils/s2s.h \
 src/utils/textutils.h \
 src/utils/zoomslider.h \
+src/utils/ziputils.h \
 src/utils/FMessageLogProbe.h \
+src/utils/FTimingProbe.h \
 src/utils/uploadpair.h
 
 SOURCES += \
@@ -66,10 +69,13 @@ src/utils/resizehandle.cpp \
 src/utils/folderutils.cpp \
 src/utils/graphicsutils.cpp \
 src/utils/graphutils.cpp \
+src/utils/gridindex.cpp \
 src/utils/ratsnestcolors.cpp \
 src/utils/schematicrectconstants.cpp \
 src/utils/s2s.cpp \
 src/utils/textutils.cpp \
 src/utils/zoomslider.cpp \
+src/utils/ziputils.cpp \
 src/utils/FMessageLogProbe.cpp \
+src/utils/FTimingProbe.cpp \
 src/utils/uploadpair.cpp
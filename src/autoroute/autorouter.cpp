@@ -281,6 +281,7 @@ void Autorouter::addUndoConnection(bool connect, ConnectorItem * connectorItem,
 
 void Autorouter::restoreOriginalState(QUndoCommand * parentCommand) {
 	QUndoStack undoStack;
+	CommandBatch batch;		// after the stack, so its clean ups run while parentCommand still exists
 	undoStack.push(parentCommand);
 	undoStack.undo();
 }
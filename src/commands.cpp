@@ -26,6 +26,12 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "items/moduleidnames.h"
 #include "utils/bezier.h"
 
+#include <QDomNode>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static constexpr qint64 DomNodeCost = 96;			// a QDomNodePrivate with its allocation overhead
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void CommandProgress::setActive(bool active) {
@@ -42,20 +48,99 @@ void CommandProgress::emitRedo() {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+int CommandBatch::Depth = 0;
+QList< QPointer<MainWindow> > CommandBatch::Simulators;
+QList<CommandBatch::CleanUp> CommandBatch::CleanUps;
+
+CommandBatch::CommandBatch() {
+	Depth++;
+}
+
+CommandBatch::~CommandBatch() {
+	if (--Depth == 0) {
+		flush();
+	}
+}
+
+bool CommandBatch::active() {
+	return Depth > 0;
+}
+
+void CommandBatch::triggerSimulator(MainWindow * mainWindow) {
+	if (mainWindow == nullptr) return;
+
+	if (!active()) {
+		mainWindow->triggerSimulator();
+		return;
+	}
+
+	if (!Simulators.contains(mainWindow)) {
+		Simulators.append(mainWindow);
+	}
+}
+
+void CommandBatch::cleanUpWires(SketchWidget * sketchWidget, bool doEmit, CleanUpWiresCommand * command) {
+	if (!active()) {
+		sketchWidget->cleanUpWiresForCommand(doEmit, command);
+		return;
+	}
+
+	for (CleanUp & cleanUp : CleanUps) {
+		if (cleanUp.sketchWidget == sketchWidget) {
+			cleanUp.doEmit = cleanUp.doEmit || doEmit;
+			// any routing status change is recorded on the last redo clean up, as it would have been unbatched
+			if (command != nullptr) cleanUp.command = command;
+			return;
+		}
+	}
+
+	CleanUp cleanUp;
+	cleanUp.sketchWidget = sketchWidget;
+	cleanUp.doEmit = doEmit;
+	cleanUp.command = command;
+	CleanUps.append(cleanUp);
+}
+
+void CommandBatch::flush() {
+	// the ratsnest changes are queued in each view, so one routing status update per view picks all of them up
+	QList<CleanUp> cleanUps = CleanUps;
+	QList< QPointer<MainWindow> > simulators = Simulators;
+	CleanUps.clear();
+	Simulators.clear();
+
+	Q_FOREACH (CleanUp cleanUp, cleanUps) {
+		if (cleanUp.sketchWidget) {
+			cleanUp.sketchWidget->cleanUpWiresForCommand(cleanUp.doEmit, cleanUp.command);
+		}
+	}
+	Q_FOREACH (QPointer<MainWindow> mainWindow, simulators) {
+		if (mainWindow) {
+			mainWindow->triggerSimulator();
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 
 int SelectItemCommand::selectItemCommandID = 3;
 int ChangeNoteTextCommand::changeNoteTextCommandID = 5;
 int BaseCommand::nextIndex = 0;
 CommandProgress BaseCommand::m_commandProgress;
+QSet<QString> BaseCommand::Interned;
+qsizetype BaseCommand::InternedPruneSize = 1024;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 BaseCommand::BaseCommand(BaseCommand::CrossViewType crossViewType, SketchWidget* sketchWidget, QUndoCommand *parent)
 	: QUndoCommand(parent),
-	m_crossViewType(crossViewType),
 	m_sketchWidget(sketchWidget),
 	m_parentCommand(parent),
-	m_index(BaseCommand::nextIndex++)
+	m_index(BaseCommand::nextIndex++),
+	m_crossViewType(crossViewType),
+	m_undoOnly(false),
+	m_redoOnly(false),
+	m_skipFirstRedo(false)
 {
 }
 
@@ -101,6 +186,34 @@ QString BaseCommand::getParamString() const {
 	       .arg((m_crossViewType == BaseCommand::SingleView) ? "single-view" : "cross-view");
 }
 
+qint64 BaseCommand::memoryCost() const {
+	return baseCost(sizeof(BaseCommand));
+}
+
+qint64 BaseCommand::baseCost(size_t objectSize) const {
+	// the subcommands themselves are counted by whoever walks them
+	return (qint64) objectSize + text().capacity() * (qint64) sizeof(QChar) + m_commands.capacity() * (qint64) sizeof(BaseCommand *);
+}
+
+qint64 BaseCommand::stringCost(const QString & string) {
+	// interned strings are shared by all commands, so don't go through here
+	return string.capacity() * (qint64) sizeof(QChar);
+}
+
+qint64 BaseCommand::domCost(const QDomNode & node) {
+	if (node.isNull()) return 0;
+
+	qint64 cost = DomNodeCost + stringCost(node.nodeName()) + stringCost(node.nodeValue());
+	QDomNamedNodeMap attributes = node.attributes();
+	for (int i = 0; i < attributes.count(); i++) {
+		cost += domCost(attributes.item(i));
+	}
+	for (QDomNode child = node.firstChild(); !child.isNull(); child = child.nextSibling()) {
+		cost += domCost(child);
+	}
+	return cost;
+}
+
 int BaseCommand::subCommandCount() const {
 	return m_commands.count();
 }
@@ -171,6 +284,26 @@ void BaseCommand::clearProgress() {
 	m_commandProgress.setActive(false);
 }
 
+QString BaseCommand::intern(const QString & string) {
+	// the same few IDs are read over and over from xml or built with QString::arg,
+	// each time into a new allocation; commands keep one shared copy instead
+	if (string.isEmpty()) return QString();
+
+	auto it = Interned.constFind(string);
+	if (it != Interned.constEnd()) return *it;
+
+	if (Interned.size() >= InternedPruneSize) {
+		// drop what no command refers to any more
+		for (auto i = Interned.begin(); i != Interned.end(); ) {
+			if (i->isDetached()) i = Interned.erase(i);
+			else ++i;
+		}
+		InternedPruneSize = qMax<qsizetype>(1024, Interned.size() * 2);
+	}
+
+	return *Interned.insert(string);
+}
+
 int BaseCommand::totalChildCount(const QUndoCommand * command) {
 	int cc = command->childCount();
 	int tcc = cc;
@@ -184,7 +317,7 @@ int BaseCommand::totalChildCount(const QUndoCommand * command) {
 
 AddDeleteItemCommand::AddDeleteItemCommand(SketchWidget* sketchWidget, BaseCommand::CrossViewType crossViewType, QString moduleID, ViewLayer::ViewLayerPlacement viewLayerPlacement, ViewGeometry & viewGeometry, qint64 id, long modelIndex, QHash<QString, QString> * localConnectors, QUndoCommand *parent)
 	: SimulationCommand(crossViewType, sketchWidget, parent),
-	m_moduleID(moduleID),
+	m_moduleID(intern(moduleID)),
 	m_itemID(id),
 	m_viewGeometry(viewGeometry),
 	m_modelIndex(modelIndex),
@@ -222,6 +355,17 @@ SketchWidget * AddDeleteItemCommand::dropOrigin() {
 	return m_dropOrigin;
 }
 
+qint64 AddDeleteItemCommand::memoryCost() const {
+	qint64 cost = baseCost(sizeof(*this));
+	if (m_localConnectors != nullptr) {
+		cost += sizeof(QHash<QString, QString>);
+		for (auto it = m_localConnectors->cbegin(); it != m_localConnectors->cend(); ++it) {
+			cost += 2 * sizeof(QString) + stringCost(it.key()) + stringCost(it.value());
+		}
+	}
+	return cost;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 SimulationCommand::SimulationCommand(BaseCommand::CrossViewType crossViewType, SketchWidget* sketchWidget, QUndoCommand *parent)
@@ -232,16 +376,12 @@ SimulationCommand::SimulationCommand(BaseCommand::CrossViewType crossViewType, S
 
 void SimulationCommand::undo() {
 	BaseCommand::undo();
-	if(m_mainWindow) {
-		m_mainWindow->triggerSimulator();
-	}
+	CommandBatch::triggerSimulator(m_mainWindow);
 }
 
 void SimulationCommand::redo() {
 	BaseCommand::redo();
-	if(m_mainWindow) {
-		m_mainWindow->triggerSimulator();
-	}
+	CommandBatch::triggerSimulator(m_mainWindow);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -344,6 +484,10 @@ void MoveItemCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 MoveItemCommand::memoryCost() const {
+	return baseCost(sizeof(*this));
+}
+
 QString MoveItemCommand::getParamString() const {
 	return QString("MoveItemCommand ")
 	       + BaseCommand::getParamString() +
@@ -424,9 +568,13 @@ void MoveItemsCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 MoveItemsCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_wires.size() * (qint64) (sizeof(long) + sizeof(QString)) + m_items.capacity() * (qint64) sizeof(MoveItemThing);
+}
+
 void MoveItemsCommand::addWire(long id, const QString & connectorID)
 {
-	m_wires.insert(id, connectorID);
+	m_wires.insert(id, intern(connectorID));
 }
 
 void MoveItemsCommand::addItem(long id, const QPointF & oldPos, const QPointF & newPos)
@@ -518,9 +666,9 @@ ChangeConnectionCommand::ChangeConnectionCommand(SketchWidget * sketchWidget, Ba
 	//DebugDialog::debug(QString("ccc: from %1 %2; to %3 %4, connect %5, layer %6").arg(fromID).arg(fromConnectorID).arg(toID).arg(toConnectorID).arg(connect).arg(viewLayerPlacement) );
 	m_enabled = true;
 	m_fromID = fromID;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = intern(fromConnectorID);
 	m_toID = toID;
-	m_toConnectorID = toConnectorID;
+	m_toConnectorID = intern(toConnectorID);
 	m_connect = connect;
 	m_updateConnections = true;
 	m_viewLayerPlacement = viewLayerPlacement;
@@ -542,6 +690,10 @@ void ChangeConnectionCommand::redo()
 	}
 }
 
+qint64 ChangeConnectionCommand::memoryCost() const {
+	return baseCost(sizeof(*this));
+}
+
 void ChangeConnectionCommand::setUpdateConnections(bool updatem) {
 	m_updateConnections = updatem;
 }
@@ -596,6 +748,10 @@ void ChangeWireCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 ChangeWireCommand::memoryCost() const {
+	return baseCost(sizeof(*this));
+}
+
 QString ChangeWireCommand::getParamString() const {
 	return QString("ChangeWireCommand ")
 	       + BaseCommand::getParamString() +
@@ -649,6 +805,10 @@ void ChangeWireCurveCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 ChangeWireCurveCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + (m_newBezier ? sizeof(Bezier) : 0) + (m_oldBezier ? sizeof(Bezier) : 0);
+}
+
 QString ChangeWireCurveCommand::getParamString() const {
 	QString oldBezier;
 	QString newBezier;
@@ -676,7 +836,7 @@ ChangeLegCommand::ChangeLegCommand(SketchWidget* sketchWidget, long fromID, cons
                                    const QPolygonF & oldLeg, const QPolygonF & newLeg, bool relative, bool active,
                                    const QString & why, QUndoCommand *parent)
 	: SimulationCommand(BaseCommand::SingleView, sketchWidget, parent),
-	m_fromConnectorID(fromConnectorID),
+	m_fromConnectorID(intern(fromConnectorID)),
 	m_fromID(fromID),
 	m_newLeg(newLeg),
 	m_oldLeg(oldLeg),
@@ -713,6 +873,10 @@ void ChangeLegCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 ChangeLegCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + (m_newLeg.capacity() + m_oldLeg.capacity()) * (qint64) sizeof(QPointF) + stringCost(m_why);
+}
+
 QString ChangeLegCommand::getParamString() const {
 
 	QString oldLeg;
@@ -743,7 +907,7 @@ MoveLegBendpointCommand::MoveLegBendpointCommand(SketchWidget* sketchWidget, lon
 	m_fromID = fromID;
 	m_oldPos = oldPos;
 	m_newPos = newPos;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = intern(fromConnectorID);
 	m_index = index;
 }
 
@@ -816,6 +980,10 @@ void ChangeLegCurveCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 ChangeLegCurveCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + (m_newBezier ? sizeof(Bezier) : 0) + (m_oldBezier ? sizeof(Bezier) : 0);
+}
+
 QString ChangeLegCurveCommand::getParamString() const {
 	QString oldBezier;
 	QString newBezier;
@@ -893,6 +1061,10 @@ void ChangeLegBendpointCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 ChangeLegBendpointCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + (m_bezier0 ? sizeof(Bezier) : 0) + (m_bezier1 ? sizeof(Bezier) : 0) + (m_bezier2 ? sizeof(Bezier) : 0);
+}
+
 QString ChangeLegBendpointCommand::getParamString() const {
 	QString bezier;
 	if (m_bezier0) {
@@ -916,7 +1088,7 @@ RotateLegCommand::RotateLegCommand(SketchWidget* sketchWidget, long fromID, cons
 {
 	m_fromID = fromID;
 	m_oldLeg = oldLeg;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = intern(fromConnectorID);
 	m_active = active;
 }
 
@@ -931,6 +1103,10 @@ void RotateLegCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 RotateLegCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_oldLeg.capacity() * (qint64) sizeof(QPointF);
+}
+
 QString RotateLegCommand::getParamString() const {
 
 	QString oldLeg;
@@ -1069,6 +1245,10 @@ void SelectItemCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 SelectItemCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + (m_undoIDs.capacity() + m_redoIDs.capacity()) * (qint64) sizeof(long);
+}
+
 void SelectItemCommand::selectAllFromStack(QList<long> & stack, bool select, bool updateInfoView) {
 	m_sketchWidget->clearSelection();
 	for (long i : stack) {
@@ -1133,6 +1313,10 @@ void ChangeZCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 ChangeZCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_triplets.size() * (qint64) (sizeof(long) + sizeof(RealPair *) + sizeof(RealPair));
+}
+
 double ChangeZCommand::first(RealPair * pair) {
 	return pair->first;
 }
@@ -1157,24 +1341,16 @@ CheckStickyCommand::CheckStickyCommand(SketchWidget* sketchWidget, BaseCommand::
 	m_skipFirstRedo = true;
 }
 
-CheckStickyCommand::~CheckStickyCommand() {
-	Q_FOREACH (StickyThing * stickyThing, m_stickyList) {
-		delete stickyThing;
-	}
-
-	m_stickyList.clear();
-}
-
 void CheckStickyCommand::undo()
 {
 	if (m_checkType == RedoOnly) return;
 
-	Q_FOREACH (StickyThing * stickyThing, m_stickyList) {
+	for (const StickyThing & stickyThing : std::as_const(m_stickyList)) {
 		if (m_checkType == RemoveOnly) {
-			stickyThing->sketchWidget->stickemForCommand(stickyThing->fromID, stickyThing->toID, !stickyThing->stickem);
+			stickyThing.sketchWidget->stickemForCommand(stickyThing.fromID, stickyThing.toID, !stickyThing.stickem);
 		}
 		else {
-			stickyThing->sketchWidget->stickemForCommand(stickyThing->fromID, stickyThing->toID, stickyThing->stickem);
+			stickyThing.sketchWidget->stickemForCommand(stickyThing.fromID, stickyThing.toID, stickyThing.stickem);
 		}
 	}
 	BaseCommand::undo();
@@ -1189,13 +1365,17 @@ void CheckStickyCommand::redo()
 		m_skipFirstRedo = false;
 	}
 	else {
-		Q_FOREACH (StickyThing * stickyThing, m_stickyList) {
-			stickyThing->sketchWidget->stickemForCommand(stickyThing->fromID, stickyThing->toID, stickyThing->stickem);
+		for (const StickyThing & stickyThing : std::as_const(m_stickyList)) {
+			stickyThing.sketchWidget->stickemForCommand(stickyThing.fromID, stickyThing.toID, stickyThing.stickem);
 		}
 	}
 	BaseCommand::redo();
 }
 
+qint64 CheckStickyCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_stickyList.capacity() * (qint64) sizeof(StickyThing);
+}
+
 QString CheckStickyCommand::getParamString() const {
 	return QString("CheckStickyCommand ")
 	       + BaseCommand::getParamString()
@@ -1204,11 +1384,11 @@ QString CheckStickyCommand::getParamString() const {
 }
 
 void CheckStickyCommand::stick(SketchWidget * sketchWidget, long fromID, long toID, bool stickem) {
-	auto * stickyThing = new StickyThing;
-	stickyThing->sketchWidget = sketchWidget;
-	stickyThing->fromID = fromID;
-	stickyThing->toID = toID;
-	stickyThing->stickem = stickem;
+	StickyThing stickyThing;
+	stickyThing.sketchWidget = sketchWidget;
+	stickyThing.fromID = fromID;
+	stickyThing.toID = toID;
+	stickyThing.stickem = stickem;
 	m_stickyList.append(stickyThing);
 }
 
@@ -1231,7 +1411,7 @@ void CleanUpWiresCommand::undo()
 	}
 
 	if (m_direction == UndoOnly) {
-		m_sketchWidget->cleanUpWiresForCommand(m_crossViewType == BaseCommand::CrossView, nullptr);
+		CommandBatch::cleanUpWires(m_sketchWidget, m_crossViewType == BaseCommand::CrossView, nullptr);
 	}
 	SimulationCommand::undo();
 }
@@ -1247,16 +1427,20 @@ void CleanUpWiresCommand::redo()
 	}
 
 	if (m_direction == RedoOnly) {
-		m_sketchWidget->cleanUpWiresForCommand(m_crossViewType == BaseCommand::CrossView, this);
+		CommandBatch::cleanUpWires(m_sketchWidget, m_crossViewType == BaseCommand::CrossView, this);
 	}
 	SimulationCommand::redo();
 }
 
+qint64 CleanUpWiresCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_sketchWidgets.size() * (qint64) sizeof(SketchWidget *) + m_ratsnestConnectThings.capacity() * (qint64) sizeof(RatsnestConnectThing);
+}
+
 void CleanUpWiresCommand::addRatsnestConnect(long id, const QString & connectorID, bool connect)
 {
 	RatsnestConnectThing rct;
 	rct.id = id;
-	rct.connectorID = connectorID;
+	rct.connectorID = intern(connectorID);
 	rct.connect = connect;
 	m_ratsnestConnectThings.append(rct);
 }
@@ -1357,8 +1541,8 @@ QString CleanUpRatsnestsCommand::getParamString() const {
 WireColorChangeCommand::WireColorChangeCommand(SketchWidget* sketchWidget, long wireId, const QString &oldColor, const QString &newColor, double oldOpacity, double newOpacity, QUndoCommand *parent)
 	: BaseCommand(BaseCommand::SingleView, sketchWidget, parent),
 	m_wireId(wireId),
-	m_oldColor(oldColor),
-	m_newColor(newColor),
+	m_oldColor(intern(oldColor)),
+	m_newColor(intern(newColor)),
 	m_oldOpacity(oldOpacity),
 	m_newOpacity(newOpacity)
 {
@@ -1491,6 +1675,10 @@ void RestoreLabelCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 RestoreLabelCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + domCost(m_oldLabelGeometry) + domCost(m_newLabelGeometry);
+}
+
 QString RestoreLabelCommand::getParamString() const {
 	return QString("RestoreLabelCommand ")
 	       + BaseCommand::getParamString()
@@ -1615,6 +1803,10 @@ void ChangeLabelTextCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 ChangeLabelTextCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + stringCost(m_oldText) + stringCost(m_newText);
+}
+
 QString ChangeLabelTextCommand::getParamString() const {
 	return QString("ChangeLabelTextCommand ")
 	       + BaseCommand::getParamString()
@@ -1684,6 +1876,10 @@ void ChangeNoteTextCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 ChangeNoteTextCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + stringCost(m_oldText) + stringCost(m_newText);
+}
+
 int ChangeNoteTextCommand::id() const {
 	return changeNoteTextCommandID;
 }
@@ -1838,6 +2034,10 @@ void TransformItemCommand::redo()
 	SimulationCommand::redo();
 }
 
+qint64 TransformItemCommand::memoryCost() const {
+	return baseCost(sizeof(*this));
+}
+
 QString TransformItemCommand::getParamString() const {
 	return QString("TransformItemCommand ")
 	       + BaseCommand::getParamString() +
@@ -1867,6 +2067,10 @@ void SetResistanceCommand::redo() {
 	SimulationCommand::redo();
 }
 
+qint64 SetResistanceCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + stringCost(m_oldResistance) + stringCost(m_newResistance) + stringCost(m_oldPinSpacing) + stringCost(m_newPinSpacing);
+}
+
 QString SetResistanceCommand::getParamString() const {
 
 	return QString("SetResistanceCommand ")
@@ -1882,7 +2086,7 @@ QString SetResistanceCommand::getParamString() const {
 SetPropCommand::SetPropCommand(SketchWidget * sketchWidget, long itemID, QString prop, QString oldValue, QString newValue, bool redraw, QUndoCommand * parent)
 	: SimulationCommand(BaseCommand::CrossView, sketchWidget, parent),
 	m_redraw(redraw),
-	m_prop(prop),
+	m_prop(intern(prop)),
 	m_oldValue(oldValue),
 	m_newValue(newValue),
 	m_itemID(itemID)
@@ -1899,6 +2103,10 @@ void SetPropCommand::redo() {
 	SimulationCommand::redo();
 }
 
+qint64 SetPropCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + stringCost(m_oldValue) + stringCost(m_newValue);
+}
+
 QString SetPropCommand::getParamString() const {
 
 	return QString("SetPropCommand ")
@@ -1972,6 +2180,10 @@ void ShowLabelCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 ShowLabelCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_idStates.size() * (qint64) (sizeof(long) + sizeof(int));
+}
+
 void ShowLabelCommand::add(long id, bool prev, bool post)
 {
 	int v = 0;
@@ -2018,6 +2230,10 @@ void LoadLogoImageCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 LoadLogoImageCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + stringCost(m_oldSvg) + stringCost(m_oldFilename) + stringCost(m_newFilename);
+}
+
 QString LoadLogoImageCommand::getParamString() const {
 	return QString("LoadLogoImageCommand ")
 	       + BaseCommand::getParamString()
@@ -2108,6 +2324,13 @@ void RenamePinsCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 RenamePinsCommand::memoryCost() const {
+	qint64 cost = baseCost(sizeof(*this)) + (m_oldLabels.capacity() + m_newLabels.capacity()) * (qint64) sizeof(QString);
+	for (const QString & label : m_oldLabels) cost += stringCost(label);
+	for (const QString & label : m_newLabels) cost += stringCost(label);
+	return cost;
+}
+
 QString RenamePinsCommand::getParamString() const {
 	return QString("RenamePinsCommand ")
 	       + BaseCommand::getParamString()
@@ -2140,6 +2363,10 @@ void GroundFillSeedCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 GroundFillSeedCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_items.capacity() * (qint64) sizeof(GFSThing);
+}
+
 void GroundFillSeedCommand::addItem(long id, const QString & connectorID, bool seed)
 {
 	GFSThing gfsThing;
@@ -2186,6 +2413,10 @@ void WireExtrasCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 WireExtrasCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + domCost(m_oldExtras) + domCost(m_newExtras);
+}
+
 QString WireExtrasCommand::getParamString() const {
 	return QString("WireExtrasCommand ")
 	       + BaseCommand::getParamString() +
@@ -2326,6 +2557,10 @@ void PackItemsCommand::redo()
 	BaseCommand::redo();
 }
 
+qint64 PackItemsCommand::memoryCost() const {
+	return baseCost(sizeof(*this)) + m_ids.capacity() * (qint64) sizeof(long);
+}
+
 QString PackItemsCommand::getParamString() const {
 	return QString("PackItemsCommand ")
 	       + BaseCommand::getParamString() +
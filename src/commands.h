@@ -24,6 +24,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QUndoCommand>
 #include <QHash>
 #include <QPainterPath>
+#include <QPointer>
+#include <QSet>
 
 #include "viewgeometry.h"
 #include "viewlayer.h"
@@ -55,6 +57,39 @@ protected:
 
 /////////////////////////////////////////////
 class SketchWidget;
+
+/**
+ * While a CommandBatch is alive, simulator triggers and wire clean ups requested by commands are
+ * only noted; the outermost batch runs them once per window and view when it goes away.
+ * Pushing, undoing and redoing run inside a batch, so a macro with thousands of children
+ * updates the routing status and restarts the simulator timer once.
+ */
+class CommandBatch
+{
+public:
+	CommandBatch();
+	~CommandBatch();
+
+	static bool active();
+	static void triggerSimulator(MainWindow *);
+	static void cleanUpWires(SketchWidget *, bool doEmit, class CleanUpWiresCommand *);
+
+protected:
+	static void flush();
+
+protected:
+	struct CleanUp {
+		QPointer<SketchWidget> sketchWidget;
+		bool doEmit = false;
+		class CleanUpWiresCommand * command = nullptr;
+	};
+
+	static int Depth;
+	static QList< QPointer<MainWindow> > Simulators;
+	static QList<CleanUp> CleanUps;
+};
+
+/////////////////////////////////////////////
 class BaseCommand : public QUndoCommand
 {
 public:
@@ -85,27 +120,35 @@ public:
 	void setSkipFirstRedo();
 	void undo();
 	void redo();
+	virtual qint64 memoryCost() const;		// bytes held by this command, not counting its children and subcommands
 
 	static int totalChildCount(const QUndoCommand *);
 	static CommandProgress * initProgress();
 	static void clearProgress();
+	static QString intern(const QString &);
 
 protected:
 	virtual QString getParamString() const;
+	qint64 baseCost(size_t objectSize) const;
+	static qint64 stringCost(const QString &);
+	static qint64 domCost(const class QDomNode &);
 
 	static int nextIndex;
 
 protected:
-	BaseCommand::CrossViewType m_crossViewType;
+	// a big macro holds hundreds of thousands of commands, so keep these small
 	SketchWidget *m_sketchWidget = nullptr;
-	QList<BaseCommand *> m_commands;
 	QUndoCommand * m_parentCommand = nullptr;
+	QList<BaseCommand *> m_commands;
 	int m_index = 0;
-	bool m_undoOnly = false;
-	bool m_redoOnly = false;
-	bool m_skipFirstRedo = false;
+	BaseCommand::CrossViewType m_crossViewType : 2;
+	bool m_undoOnly : 1;
+	bool m_redoOnly : 1;
+	bool m_skipFirstRedo : 1;
 
 	static CommandProgress m_commandProgress;
+	static QSet<QString> Interned;		// module and connector IDs, property names, shared by all commands
+	static qsizetype InternedPruneSize;
 };
 
 /////////////////////////////////////////////
@@ -131,6 +174,7 @@ public:
 	long itemID() const;
 	void setDropOrigin(SketchWidget *);
 	SketchWidget * dropOrigin();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -186,6 +230,7 @@ public:
 	MoveItemCommand(SketchWidget *sketchWidget, long id, ViewGeometry & oldG, ViewGeometry & newG, bool updateRatsnest, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -229,6 +274,7 @@ public:
 	MoveItemsCommand(SketchWidget *sketchWidget, bool updateRatsnest, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void addItem(long id, const QPointF & oldPos, const QPointF & newPos);
 	void addWire(long id, const QString & connectorID);
 
@@ -285,6 +331,7 @@ public:
 	TransformItemCommand(SketchWidget *sketchWidget, long id, const QTransform & oldMatrix, const class QTransform & newMatrix, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -307,6 +354,7 @@ public:
 	                        bool connect, QUndoCommand * parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void setUpdateConnections(bool updatem);
 	void disable();
 
@@ -336,6 +384,7 @@ public:
 	                  QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -360,6 +409,7 @@ public:
 	                       QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -380,6 +430,7 @@ public:
 	                 const QPolygonF & oldLeg, const QPolygonF & newLeg, bool relative, bool active, const QString & why, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 	void setSimple();
 
@@ -427,6 +478,7 @@ public:
 	                      QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -449,6 +501,7 @@ public:
 	                          const class Bezier *, const class Bezier *, const class Bezier *, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -474,6 +527,7 @@ public:
 	                 const QPolygonF & oldLeg, bool active, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -525,6 +579,7 @@ public:
 
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void addUndo(long id);
 	void addRedo(long id);
 	void clearRedo();
@@ -561,6 +616,7 @@ public:
 	void addTriplet(long id, double oldZ, double newZ);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -593,10 +649,10 @@ public:
 
 public:
 	CheckStickyCommand(SketchWidget *sketchWidget, BaseCommand::CrossViewType, long itemID, bool checkCurrent, CheckType, QUndoCommand *parent);
-	~CheckStickyCommand();
 
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void stick(SketchWidget *, long fromID, long toID, bool stickem);
 
 
@@ -605,7 +661,7 @@ protected:
 
 protected:
 	long m_itemID = 0;
-	QList<StickyThing *> m_stickyList;
+	QList<StickyThing> m_stickyList;
 	bool m_checkCurrent = false;
 	CheckType m_checkType;
 };
@@ -695,6 +751,7 @@ public:
 	CleanUpWiresCommand(class SketchWidget * sketchWidget, CleanUpWiresCommand::Direction, QUndoCommand * parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void addRoutingStatus(SketchWidget *, const RoutingStatus & oldRoutingStatus, const RoutingStatus & newRoutingStatus);
 	void setDirection(CleanUpWiresCommand::Direction);
 	void addTrace(SketchWidget * sketchWidget, Wire * wire);
@@ -733,6 +790,7 @@ public:
 	RestoreLabelCommand(class SketchWidget *sketchWidget, long id, QDomElement & oldLabelGeometry, QDomElement & newLabelGeometry, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -839,6 +897,7 @@ public:
 	ChangeLabelTextCommand(class SketchWidget *sketchWidget, long id, const QString & oldText, const QString & newText, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -857,6 +916,7 @@ public:
 	ChangeNoteTextCommand(class SketchWidget *sketchWidget, long id, const QString & oldText, const QString & newText, QSizeF oldSize, QSizeF newSize, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	int id() const;
 	bool mergeWith(const QUndoCommand *other);
 
@@ -937,6 +997,7 @@ public:
 	SetResistanceCommand(class SketchWidget *, long itemID, QString oldResistance, QString newResistance, QString oldPinSpacing, QString newPinSpacing, QUndoCommand * parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -957,6 +1018,7 @@ public:
 	SetPropCommand(class SketchWidget *, long itemID, QString prop, QString oldValue, QString newValue, bool redraw, QUndoCommand * parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -1000,6 +1062,7 @@ public:
 
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void add(long id, bool prev, bool post);
 
 protected:
@@ -1018,6 +1081,7 @@ public:
 	LoadLogoImageCommand(class SketchWidget *sketchWidget, long id, const QString & oldSvg, const QSizeF oldAspectRatio, const QString & oldFilename, const QString & newFilename, bool addName, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -1073,6 +1137,7 @@ public:
 	RenamePinsCommand(class SketchWidget *sketchWidget, long id, const QStringList & oldOnes, const QStringList & newOnes, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -1097,6 +1162,7 @@ public:
 	GroundFillSeedCommand(class SketchWidget *sketchWidget, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 	void addItem(long id, const QString & connectorID, bool seed);
 
 protected:
@@ -1116,6 +1182,7 @@ public:
 	                  QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
@@ -1208,6 +1275,7 @@ public:
 	PackItemsCommand(class SketchWidget *sketchWidget, int columns, const QList<long> & ids, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryCost() const;
 
 protected:
 	QString getParamString() const;
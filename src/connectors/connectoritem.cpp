@@ -216,6 +216,7 @@ parts editor support
 #include "bus.h"
 #include "../items/wire.h"
 #include "../items/virtualwire.h"
+#include "../items/levelofdetail.h"
 #include "../model/modelpart.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/graphutils.h"
@@ -244,6 +245,35 @@ static double MAX_DOUBLE = std::numeric_limits<double>::max();
 
 const QColor LegConnectorUnderColor = QColor("#8c8c8c"); // TODO: don't hardcode color
 
+// same result as QGraphicsScene::items(scenePos), except that the connectors of boards with
+// a connector grid come from the board's grid; the scene is only asked for everything else
+static QList<QGraphicsItem *> itemsAt(QGraphicsScene * scene, QPointF scenePos)
+{
+	QList<QGraphicsItem *> items;
+	QList<QGraphicsItem *> boards;
+	Q_FOREACH (ItemBase * board, ItemBase::connectorGridItems(scene)) {
+		boards.append(board);
+		if (!board->isVisible()) continue;
+		if (!board->sceneBoundingRect().contains(scenePos)) continue;
+
+		QList<ConnectorItem *> connectorItems;
+		board->connectorItemsAt(scenePos, connectorItems);
+		Q_FOREACH (ConnectorItem * connectorItem, connectorItems) {
+			items.append(connectorItem);
+		}
+	}
+
+	Q_FOREACH (QGraphicsItem * item, scene->items(scenePos, Qt::IntersectsItemBoundingRect)) {
+		if (boards.contains(item->parentItem()) && dynamic_cast<ConnectorItem *>(item) != nullptr) {
+			continue;  // already answered by the grid
+		}
+
+		if (item->contains(item->mapFromScene(scenePos))) items.append(item);
+	}
+
+	return items;
+}
+
 bool wireLessThan(ConnectorItem * c1, ConnectorItem * c2)
 {
 	if (c1->connectorType() == c2->connectorType()) {
@@ -489,10 +519,9 @@ ConnectorItem * ConnectorItem::removeConnection(ItemBase * itemBase) {
 			}
 			restoreColor(visited);
 			if (itemBase) {
-				DebugDialog::debug(QString("remove from:%1 to:%2 count%3")
-						   .arg((long) this, 0, 16)
-						   .arg(itemBase->modelPartShared()->title())
-						   .arg(m_connectedTo.count()) );
+				DebugDialog::stream() << "remove from:" << QString::number((long) this, 16)
+						   << " to:" << itemBase->modelPartShared()->title()
+						   << " count" << m_connectedTo.count();
 			}
 			return removed;
 		}
@@ -1523,11 +1552,10 @@ void ConnectorItem::updateTooltip() {
 		} else {
 			id = match.captured(0);
 		}
-        DebugDialog::debug(QString("Name: %1, Description: %2, ID: %3, Attached To: %4")
-                               .arg(name,
-                                    descr.isEmpty() ? "N/A" : descr,
-                                    id.isEmpty() ? "N/A" : id,
-                                    attachedToTitle()));
+        DebugDialog::stream() << "Name: " << name
+                              << ", Description: " << (descr.isEmpty() ? "N/A" : descr)
+                              << ", ID: " << (id.isEmpty() ? "N/A" : id)
+                              << ", Attached To: " << attachedToTitle();
         setToolTip(FToolTip::createNonWireItemTooltipHtml(name, descr, attachedToTitle()));
 		return;
 	}
@@ -1665,11 +1693,23 @@ void ConnectorItem::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
 	if (m_hybrid) return;
 	if (doNotPaint()) return;
 
+	double levelOfDetail = LevelOfDetail::of(option, painter, widget);
 	if (m_legPolygon.count() > 1) {
+		if (LevelOfDetail::tooSmall(m_legPolygon.boundingRect(), levelOfDetail)) return;
+
+		if (LevelOfDetail::simplified(levelOfDetail)) {
+			// zoomed out: only the leg itself, without bendpoints, hover highlight or connector end
+			painter->setPen(legPen());
+			paintLeg(painter, true);
+			return;
+		}
+
 		paintLeg(painter);
 		return;
 	}
 
+	if (LevelOfDetail::tooSmall(rect(), levelOfDetail)) return;
+
 	if (m_effectively == EffectivelyUnknown) {
 		if (!m_circular && m_shape.isEmpty()) {
 			if (this->attachedTo()->viewID() == ViewLayer::PCBView) {
@@ -1977,7 +2017,7 @@ double ConnectorItem::minDimension() {
 ConnectorItem * ConnectorItem::findConnectorUnder(bool useTerminalPoint, bool allowAlready, const QList<ConnectorItem *> & exclude, bool displayDragTooltip, ConnectorItem * other)
 {
 	QList<QGraphicsItem *> items = useTerminalPoint
-	                               ? this->scene()->items(this->sceneAdjustedTerminalPoint(nullptr))
+	                               ? itemsAt(this->scene(), this->sceneAdjustedTerminalPoint(nullptr))
 	                               : this->scene()->items(mapToScene(this->rect()));  // only wires use rect
 	QList<ConnectorItem *> candidates;
 	// for the moment, take the topmost ConnectorItem that doesn't belong to me
@@ -2412,39 +2452,13 @@ void ConnectorItem::calcConnectorEnd()
 
 	bezier->set_endpoints(p0, p1);
 	m_connectorDetectT = m_connectorDrawT = 0;
-	double blen = bezier->computeCubicCurveLength(1.0, 24);
+	double blen = bezier->length();
 	if (blen < StandardLegConnectorDetectLength) {
 		return;
 	}
 
-	m_connectorDetectT = findT(bezier, blen, StandardLegConnectorDetectLength);
-	m_connectorDrawT = findT(bezier, blen, StandardLegConnectorDrawEnabledLength);
-}
-
-double ConnectorItem::findT(Bezier * bezier, double blen, double length)
-{
-	// use binary search to find a value for t
-	double tmax = 1.0;
-	double tmin = 0;
-	double t = 1.0 - (length / blen);
-	while (true) {
-		double l = bezier->computeCubicCurveLength(t, 24);
-		if (qAbs(blen - length - l) < .0001) {
-			return t;
-		}
-
-		if (blen - length - l > 0) {
-			// too short
-			tmin = t;
-			t = (t + tmax) / 2;
-		}
-		else {
-			// too long
-			tmax = t;
-			t = (t + tmin) / 2;
-		}
-	}
-	return t;
+	m_connectorDetectT = bezier->tAtLength(blen - StandardLegConnectorDetectLength);
+	m_connectorDrawT = bezier->tAtLength(blen - StandardLegConnectorDrawEnabledLength);
 }
 
 const QString & ConnectorItem::legID(ViewLayer::ViewID viewID, ViewLayer::ViewLayerID viewLayerID) {
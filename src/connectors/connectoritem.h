@@ -202,7 +202,6 @@ protected:
 	void updateLegCursor(QPointF p, Qt::KeyboardModifiers modifiers);
 	void updateWireCursor(Qt::KeyboardModifiers modifiers);
 	bool curvyWiresIndicated(Qt::KeyboardModifiers);
-	double findT(Bezier * bezier, double blen, double length);
 
 protected:
 	QPointer<Connector> m_connector;
@@ -22,9 +22,6 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "debugdialog.h"
 #include "qevent.h"
-#ifndef QT_NO_DEBUG
-#include "utils/folderutils.h"
-#endif
 #include <QEvent>
 #include <QCoreApplication>
 #include <QFile>
@@ -32,6 +29,12 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDir>
 #include <QtDebug>
 #include <QIcon>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QThread>
+#include <QWaitCondition>
 
 const QMap<QString, QString> DebugDialog::colorMap = {
 	{ "<RESET>", "\033[0m" },
@@ -104,6 +107,8 @@ const QMap<QString, QString> DebugDialog::colorMap = {
 };
 
 bool DebugDialog::coloringEnabled = false;
+bool DebugDialog::m_synchronous = false;
+DebugDialog::DebugLevel DebugDialog::m_debugLevel = DebugDialog::Debug;
 
 DebugDialog* DebugDialog::singleton = nullptr;
 QFile DebugDialog::m_file;
@@ -116,41 +121,163 @@ bool DebugDialog::m_enabled = true;
 
 QEvent::Type DebugEventType = (QEvent::Type) (QEvent::User + 1);
 
-class DebugEvent : public QEvent
+struct DebugMessage
 {
-public:
 	QString m_message;
-	QObject * m_ancestor;
 	DebugDialog::DebugLevel m_debugLevel;
+	QObject * m_ancestor;
+};
+
+// Messages waiting to be shown in the dialog.  A single DebugEventType event
+// is posted when the list goes from empty to non-empty; the dialog then takes
+// the whole batch at once.
+static QMutex PendingMutex;
+static QList<DebugMessage> PendingMessages;
+
+// m_file is written from the writer thread, or from any caller in synchronous mode
+static QMutex FileMutex;
+
+////////////////////////////////////////
+
+// Background writer: callers only queue the raw message; coloring, qDebug and
+// the file writes happen here in batches, with the file kept open.
+class DebugLogWriter : public QThread
+{
+public:
+	void enqueue(const DebugMessage & message) {
+		QMutexLocker locker(&m_mutex);
+		m_queue.append(message);
+		m_wake.wakeOne();
+	}
+
+	void waitUntilIdle() {
+		QMutexLocker locker(&m_mutex);
+		while (m_busy || !m_queue.isEmpty()) {
+			m_idle.wait(&m_mutex);
+		}
+	}
+
+	void setFileName(const QString & fileName) {
+		QMutexLocker locker(&m_mutex);
+		while (m_busy || !m_queue.isEmpty()) {
+			m_idle.wait(&m_mutex);
+		}
+		QMutexLocker fileLocker(&FileMutex);
+		DebugDialog::m_file.close();
+		DebugDialog::m_file.setFileName(fileName);
+	}
 
-	DebugEvent(QString message, DebugDialog::DebugLevel debugLevel, QObject * ancestor) : QEvent(DebugEventType) {
-		this->m_message = message;
-		this->m_ancestor = ancestor;
-		this->m_debugLevel = debugLevel;
+	void stop() {
+		{
+			QMutexLocker locker(&m_mutex);
+			m_stop = true;
+			m_wake.wakeOne();
+		}
+		wait();
 	}
+
+protected:
+	void run() override {
+		QList<DebugMessage> batch;
+		while (true) {
+			{
+				QMutexLocker locker(&m_mutex);
+				m_busy = false;
+				m_idle.wakeAll();
+				while (m_queue.isEmpty() && !m_stop) {
+					m_wake.wait(&m_mutex);
+				}
+				if (m_queue.isEmpty()) break;
+
+				batch.swap(m_queue);
+				m_busy = true;
+			}
+
+			for (DebugMessage & debugMessage : batch) {
+				debugMessage.m_message = DebugDialog::colorize(debugMessage.m_message);
+				DebugDialog::writeMessage(debugMessage.m_message, true);
+			}
+			{
+				QMutexLocker fileLocker(&FileMutex);
+				if (DebugDialog::m_file.isOpen()) {
+					DebugDialog::m_file.flush();
+				}
+			}
+			for (const DebugMessage & debugMessage : batch) {
+				DebugDialog::post(debugMessage.m_message, debugMessage.m_debugLevel, debugMessage.m_ancestor);
+			}
+			batch.clear();
+		}
+
+		QMutexLocker fileLocker(&FileMutex);
+		DebugDialog::m_file.close();
+	}
+
+protected:
+	QMutex m_mutex;
+	QWaitCondition m_wake;
+	QWaitCondition m_idle;
+	QList<DebugMessage> m_queue;
+	bool m_busy = false;
+	bool m_stop = false;
 };
 
+static DebugLogWriter * TheWriter = nullptr;
+static QMutex WriterMutex;
+
+// The writer does not depend on the dialog, so logging from a worker thread
+// can start it before the GUI thread has created the dialog.
+static DebugLogWriter * startWriter() {
+	QMutexLocker locker(&WriterMutex);
+	if (TheWriter == nullptr) {
+		TheWriter = new DebugLogWriter();
+		TheWriter->start(QThread::LowPriority);
+	}
+	return TheWriter;
+}
+
+static void stopWriter() {
+	QMutexLocker locker(&WriterMutex);
+	if (TheWriter != nullptr) {
+		TheWriter->stop();
+		delete TheWriter;
+		TheWriter = nullptr;
+	}
+}
+
+static bool onGuiThread() {
+	QCoreApplication * app = QCoreApplication::instance();
+	return app != nullptr && QThread::currentThread() == app->thread();
+}
+
+static QString defaultFileName() {
+	QString path;
+#ifndef QT_NO_DEBUG
+	// FolderUtils::getTopLevelUserDataStorePath(), without linking FolderUtils here
+	path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).absolutePath();
+#endif
+	return path + "/debug.txt";
+}
+
+////////////////////////////////////////
+
 DebugDialog::DebugDialog(QWidget *parent)
 	: QDialog(parent)
 {
 	// Let's set the icon
 	this->setWindowIcon(QIcon(QPixmap(":resources/images/fritzing_icon.png")));
 
-	singleton = this;
-	m_debugLevel = DebugDialog::Debug;
 	setWindowTitle(tr("for debugging"));
 	resize(400, 300);
 	m_textEdit = new QTextEdit(this);
 	m_textEdit->setGeometry(QRect(10, 10, 381, 281));
 
-	QString path;
-#ifndef QT_NO_DEBUG
-	path = FolderUtils::getTopLevelUserDataStorePath();
-#endif
-	path += "/debug.txt";
-
-	m_file.setFileName(path);
-	m_file.remove();
+	// messages logged before the dialog existed are shown now
+	QMutexLocker locker(&PendingMutex);
+	singleton = this;
+	if (!PendingMessages.isEmpty()) {
+		QCoreApplication::postEvent(singleton, new QEvent(DebugEventType));
+	}
 }
 
 DebugDialog::~DebugDialog()
@@ -162,10 +289,22 @@ DebugDialog::~DebugDialog()
 
 bool DebugDialog::event(QEvent *e) {
 	if (e->type() == DebugEventType) {
-		this->m_textEdit->append(((DebugEvent *) e)->m_message);
-		Q_EMIT debugBroadcast(((DebugEvent *) e)->m_message, ((DebugEvent *) e)->m_debugLevel,((DebugEvent *) e)->m_ancestor);
-		// need to delete these events at some point...
-		// but it's tricky if the message is being used elsewhere
+		QList<DebugMessage> messages;
+		{
+			QMutexLocker locker(&PendingMutex);
+			messages.swap(PendingMessages);
+		}
+		if (messages.isEmpty()) return true;
+
+		QStringList lines;
+		lines.reserve(messages.count());
+		for (const DebugMessage & debugMessage : messages) {
+			lines.append(debugMessage.m_message);
+		}
+		this->m_textEdit->append(lines.join("\n"));
+		for (const DebugMessage & debugMessage : messages) {
+			Q_EMIT debugBroadcast(debugMessage.m_message, debugMessage.m_debugLevel, debugMessage.m_ancestor);
+		}
 		return true;
 	}
 	else {
@@ -234,45 +373,119 @@ void DebugDialog::debug_ts(QString message, DebugLevel debugLevel, QObject * anc
 
 void DebugDialog::debug(QString message, DebugLevel debugLevel, QObject * ancestor) {
 
-	if (!m_enabled) return;
+	if (!enabled(debugLevel)) return;
 
-
-	if (singleton == nullptr) {
+	// the dialog is a widget, so only the GUI thread may create it
+	if (singleton == nullptr && onGuiThread()) {
 		new DebugDialog();
 		//singleton->show();
 	}
 
-	if (debugLevel < singleton->m_debugLevel) {
+	if (!m_synchronous) {
+		DebugLogWriter * writer = startWriter();
+		writer->enqueue(DebugMessage{message, debugLevel, ancestor});
+		if (debugLevel >= Error) {
+			// errors are on disk before the caller goes on, in case it is about to crash
+			writer->waitUntilIdle();
+		}
 		return;
 	}
 
-	if (coloringEnabled) {
-		bool hasColor = false;
-		for (auto it = colorMap.constBegin(); it != colorMap.constEnd(); ++it) {
-			if (message.contains(it.key())) {
-				hasColor = true;
-				message.replace(it.key(), it.value());
-			}
-		}
+	message = colorize(message);
+	writeMessage(message, false);
+	post(message, debugLevel, ancestor);
+}
 
-		if (hasColor) {
-			message.append(colorMap.value("<RESET>"));
-		}
+QString DebugDialog::colorize(const QString & message) {
+	if (!coloringEnabled) return message;
+
+	// one pass over the message instead of one search per color
+	static const QRegularExpression ColorTag("<[A-Z_]+>");
+	if (!message.contains('<')) return message;
+
+	QString result;
+	int last = 0;
+	bool hasColor = false;
+	QRegularExpressionMatchIterator it = ColorTag.globalMatch(message);
+	while (it.hasNext()) {
+		QRegularExpressionMatch match = it.next();
+		auto color = colorMap.constFind(match.captured());
+		if (color == colorMap.constEnd()) continue;
+
+		result.append(QStringView(message).mid(last, match.capturedStart() - last));
+		result.append(color.value());
+		last = match.capturedEnd();
+		hasColor = true;
+	}
+	if (!hasColor) return message;
+
+	result.append(QStringView(message).mid(last));
+	result.append(colorMap.value("<RESET>"));
+	return result;
+}
+
+void DebugDialog::writeMessage(const QString & message, bool keepOpen) {
+	if (coloringEnabled) {
 		qDebug().noquote() << message;
 	} else {
 		qDebug() << message;
 	}
 
-	if (m_file.open(QIODevice::Append | QIODevice::Text)) {
-		QTextStream out(&m_file);
+	QMutexLocker locker(&FileMutex);
+	if (m_file.fileName().isEmpty()) {
+		m_file.setFileName(defaultFileName());
+		m_file.remove();
+	}
+	if (!m_file.isOpen() && !m_file.open(QIODevice::Append | QIODevice::Text)) {
+		return;
+	}
+
+	QTextStream out(&m_file);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-		out.setCodec("UTF-8");
+	out.setCodec("UTF-8");
 #endif
-		out << message << "\n";
+	out << message << "\n";
+	out.flush();
+	if (!keepOpen) {
 		m_file.close();
 	}
-	auto* de = new DebugEvent(message, debugLevel, ancestor);
-	QCoreApplication::postEvent(singleton, de);
+}
+
+void DebugDialog::post(const QString & message, DebugLevel debugLevel, QObject * ancestor) {
+	QMutexLocker locker(&PendingMutex);
+	bool wasEmpty = PendingMessages.isEmpty();
+	PendingMessages.append(DebugMessage{message, debugLevel, ancestor});
+	if (wasEmpty && singleton != nullptr) {
+		QCoreApplication::postEvent(singleton, new QEvent(DebugEventType));
+	}
+}
+
+void DebugDialog::flush() {
+	QMutexLocker locker(&WriterMutex);
+	if (TheWriter != nullptr && QThread::currentThread() != TheWriter) {
+		TheWriter->waitUntilIdle();
+	}
+}
+
+void DebugDialog::setSynchronous(bool synchronous) {
+	m_synchronous = synchronous;
+	if (synchronous) {
+		stopWriter();
+	}
+}
+
+void DebugDialog::setLogFileName(const QString & fileName) {
+	{
+		QMutexLocker locker(&WriterMutex);
+		if (TheWriter != nullptr) {
+			TheWriter->setFileName(fileName);
+			return;
+		}
+	}
+
+	QMutexLocker locker(&FileMutex);
+	m_file.close();
+	m_file.setFileName(fileName);
 }
 
 void DebugDialog::hideDebug() {
@@ -311,15 +524,12 @@ bool DebugDialog::connectToBroadcast(QObject * receiver, const char* slot) {
 }
 
 void DebugDialog::setDebugLevel(DebugLevel debugLevel) {
-	if (singleton == nullptr) {
-		new DebugDialog();
-
-	}
-
-	singleton->m_debugLevel = debugLevel;
+	m_debugLevel = debugLevel;
 }
 
 void DebugDialog::cleanup() {
+	stopWriter();
+
 	if (singleton != nullptr) {
 		delete singleton;
 		singleton = nullptr;
@@ -29,6 +29,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPointer>
 #include <QSettings>
 
+// messages below this level are compiled out of DebugDialog::enabled() checks
+#ifndef DEBUG_DIALOG_MINIMUM_LEVEL
+#define DEBUG_DIALOG_MINIMUM_LEVEL Debug
+#endif
 
 class DebugDialog : public QDialog
 {
@@ -46,41 +50,45 @@ public:
 		Error
 	};
 
+	// Formatting is skipped entirely when the level is filtered out,
+	// so streaming is the cheap way to log from hot loops.
 	class DebugStream {
 	public:
 		DebugStream(DebugDialog::DebugLevel level = DebugDialog::Debug, QObject* ancestor = nullptr)
-			: m_level(level), m_ancestor(ancestor) {}
+			: m_level(level), m_ancestor(ancestor), m_active(DebugDialog::enabled(level)) {}
 		~DebugStream() {
-			DebugDialog::debug(m_buffer, m_level, m_ancestor);
+			if (m_active) {
+				DebugDialog::debug(m_buffer, m_level, m_ancestor);
+			}
 		}
 
 		// Overload for QString
 		DebugStream& operator<<(const QString& value) {
-			m_buffer += value;
+			if (m_active) m_buffer += value;
 			return *this;
 		}
 
 		// Overload for std::string
 		DebugStream& operator<<(const std::string& value) {
-			m_buffer += QString::fromStdString(value);
+			if (m_active) m_buffer += QString::fromStdString(value);
 			return *this;
 		}
 
 		// Overload for C-style strings
 		DebugStream& operator<<(const char* value) {
-			m_buffer += QString(value);
+			if (m_active) m_buffer += QString(value);
 			return *this;
 		}
 
 		// Template for other types (int, double, etc.)
 		template<typename T>
 		DebugStream& operator<<(const T& value) {
-			m_buffer += QString::fromStdString(std::to_string(value));
+			if (m_active) m_buffer += QString::fromStdString(std::to_string(value));
 			return *this;
 		}
 
 		DebugStream& operator<<(std::ostream& (*manip)(std::ostream&)) {
-			if (manip == static_cast<std::ostream& (*)(std::ostream&)>(std::endl)) {
+			if (m_active && manip == static_cast<std::ostream& (*)(std::ostream&)>(std::endl)) {
 				m_buffer += "\n";
 			}
 			return *this;
@@ -90,6 +98,7 @@ public:
 		QString m_buffer;
 		DebugDialog::DebugLevel m_level;
 		QObject* m_ancestor;
+		bool m_active;
 	};
 
 	static DebugStream stream(DebugLevel level = Debug, QObject* ancestor = nullptr);
@@ -110,22 +119,35 @@ public:
 	static void cleanup();
 	static void setEnabled(bool);
 	static bool enabled();
+	static bool enabled(DebugLevel level) {
+		return level >= DEBUG_DIALOG_MINIMUM_LEVEL && m_enabled && level >= m_debugLevel;
+	}
 	static void setColoringEnabled(bool enabled);
+	static void setSynchronous(bool);
+	static void setLogFileName(const QString &);
+	static void flush();
 
 	static QString createKeyTag(const QKeyEvent *event);
 protected:
 	bool event ( QEvent * e );
 	void resizeEvent ( QResizeEvent * event );
 
+	static QString colorize(const QString & message);
+	static void writeMessage(const QString & message, bool keepOpen);
+	static void post(const QString & message, DebugLevel, QObject * ancestor);
+
+	friend class DebugLogWriter;
+
 protected:
 	static DebugDialog* singleton;
 	static QFile m_file;
 	static bool m_enabled;
 	static const QMap<QString, QString> colorMap;
 	static bool coloringEnabled;
+	static bool m_synchronous;
+	static DebugLevel m_debugLevel;
 
 	QPointer<QTextEdit> m_textEdit;
-	DebugLevel m_debugLevel;
 
 Q_SIGNALS:
 	void debugBroadcast(const QString & message, DebugDialog::DebugLevel, QObject * ancestor);
@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "setcolordialog.h"
 #include "../sketch/zoomablegraphicsview.h"
 #include "../mainwindow/mainwindow.h"
+#include "../waitpushundostack.h"
 #include "../utils/folderutils.h"
 
 #include <QFormLayout>
@@ -122,6 +123,7 @@ void PrefsDialog::initGeneral(QWidget * widget, QFileInfoList & languages)
 	vLayout->addWidget(createColorForm());
 	vLayout->addWidget(createZoomerForm());
 	vLayout->addWidget(createAutosaveForm());
+	vLayout->addWidget(createUndoHistoryForm());
 
 	vLayout->addWidget(createOtherForm());
 
@@ -168,6 +170,7 @@ void PrefsDialog::initBetaFeatures(QWidget * widget)
 {
 	QVBoxLayout * vLayout = new QVBoxLayout();
 	vLayout->addWidget(createGerberBetaFeaturesForm());
+	vLayout->addWidget(createRenderingBetaFeaturesForm());
 	vLayout->addWidget(createProjectPropertiesForm());
 	vLayout->addSpacerItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 	widget->setLayout(vLayout);
@@ -235,6 +238,38 @@ QWidget * PrefsDialog::createAutosaveForm() {
 	return autosave;
 }
 
+QWidget * PrefsDialog::createUndoHistoryForm() {
+	auto * undoHistory = new QGroupBox(tr("Undo History"), this );
+
+	auto * zhlayout = new QHBoxLayout();
+	zhlayout->setSpacing(SPACING);
+
+	auto * label = new QLabel(tr("Memory limit:"));
+	label->setFixedWidth(FORMLABELWIDTH);
+	zhlayout->addWidget(label);
+
+	auto * spinBox = new QSpinBox;
+	spinBox->setMinimum(0);
+	spinBox->setMaximum(16384);
+	spinBox->setSingleStep(64);
+	spinBox->setSpecialValueText(tr("none"));
+	spinBox->setValue(WaitPushUndoStack::memoryBudget());
+	spinBox->setMaximumWidth(80);
+	spinBox->setToolTip(tr("When the undo history grows past this, its oldest steps can no longer be undone."));
+	zhlayout->addWidget(spinBox);
+
+	auto * unitLabel = new QLabel(tr("MB"));
+	zhlayout->addWidget(unitLabel);
+
+	zhlayout->addSpacerItem(new QSpacerItem(0,0,QSizePolicy::Expanding));
+
+	undoHistory->setLayout(zhlayout);
+
+	connect(spinBox, SIGNAL(valueChanged(int)), this, SLOT(changeUndoMemoryBudget(int)));
+
+	return undoHistory;
+}
+
 QWidget * PrefsDialog::createLanguageForm(QFileInfoList & languages)
 {
 	auto * formGroupBox = new QGroupBox(tr("Language"));
@@ -467,6 +502,32 @@ QWidget * PrefsDialog::createGerberBetaFeaturesForm() {
 	return gerberGroup;
 }
 
+QWidget * PrefsDialog::createRenderingBetaFeaturesForm() {
+	QSettings settings;
+	QGroupBox * renderingGroup = new QGroupBox(tr("Rendering"), this);
+
+	QVBoxLayout * layout = new QVBoxLayout();
+
+	QLabel * label = new QLabel(tr("Parts that are not being edited, such as a breadboard or a board, are drawn from "
+	                               "pre-rendered tiles, so panning and zooming large sketches stays smooth."));
+	label->setWordWrap(true);
+	layout->addWidget(label);
+	layout->addSpacing(10);
+
+	QCheckBox * box = new QCheckBox(tr("Cache static parts while panning and zooming"));
+	box->setFixedWidth(FORMLABELWIDTH * 2);
+	box->setChecked(settings.value("tileCacheEnabled", false).toBool());
+	layout->addWidget(box);
+
+	renderingGroup->setLayout(layout);
+
+	connect(box, &QCheckBox::clicked, this, [this](bool checked) {
+		m_settings.insert("tileCacheEnabled", QString::number(checked));
+	});
+
+	return renderingGroup;
+}
+
 QWidget *PrefsDialog::createProjectPropertiesForm() {
 	QGroupBox * projectPropertiesBox = new QGroupBox(tr("Project properties"), this );
 
@@ -658,6 +719,10 @@ void PrefsDialog::changeAutosavePeriod(int value) {
 	m_settings.insert("autosavePeriod", QString("%1").arg(value));
 }
 
+void PrefsDialog::changeUndoMemoryBudget(int value) {
+	m_settings.insert("undoMemoryBudget", QString("%1").arg(value));
+}
+
 QWidget* PrefsDialog::createCurvyForm(ViewInfoThing * viewInfoThing)
 {
 	auto * groupBox = new QGroupBox(tr("Curvy vs. straight wires"));
@@ -65,8 +65,10 @@ protected:
 	QWidget* createColorForm();
 	QWidget * createZoomerForm();
 	QWidget * createAutosaveForm();
+	QWidget * createUndoHistoryForm();
 	QWidget *createProgrammerForm(QList<Platform *> platforms);
 	QWidget *createGerberBetaFeaturesForm();
+	QWidget *createRenderingBetaFeaturesForm();
 	QWidget *createProjectPropertiesForm();
 	void updateWheelText();
 	void initGeneral(QWidget * general, QFileInfoList & languages);
@@ -85,6 +87,7 @@ protected Q_SLOTS:
 	void changeWheelBehavior();
 	void toggleAutosave(bool);
 	void changeAutosavePeriod(int);
+	void changeUndoMemoryBudget(int);
 	void curvyChanged();
 	void chooseProgrammer();
     void setSimulationTimeStepMode(const bool &timeStepMode);
@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "debugdialog.h"
 #include "utils/misc.h"
 #include "mainwindow/mainwindow.h"
+#include "mainwindow/exportsession.h"
 #include "fsplashscreen.h"
 #include "version/version.h"
 #include "dialogs/prefsdialog.h"
@@ -36,6 +37,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "utils/lockmanager.h"
 #include "utils/fmessagebox.h"
 #include "utils/FMessageLogProbe.h"
+#include "utils/FTimingProbe.h"
 #include "dialogs/translatorlistmodel.h"
 #include "partsbinpalette/partsbinview.h"
 #include "partsbinpalette/svgiconwidget.h"
@@ -58,6 +60,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "autoroute/checker.h"
 #include "sketch/sketchwidget.h"
 #include "sketch/pcbsketchwidget.h"
+#include "commands.h"
+#include "waitpushundostack.h"
 #include "help/firsttimehelpdialog.h"
 #include "help/aboutbox.h"
 #include "version/partschecker.h"
@@ -70,6 +74,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QSettings>
 #include <QKeyEvent>
 #include <QFileInfo>
+#include <QFile>
 #include <QDesktopServices>
 #include <QLocale>
 #include <QFileOpenEvent>
@@ -84,6 +89,12 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QTemporaryFile>
 #include <QDir>
 #include <QMetaType>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScrollBar>
+#include <QtConcurrentMap>
 
 #ifdef LINUX_32
 #define PLATFORM_NAME "linux-32bit"
@@ -108,6 +119,13 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 #endif
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+#ifdef Q_OS_MACOS
+#include <mach/mach.h>
+#endif
+
 static constexpr double LoadProgressStart = 0.085;
 static constexpr double LoadProgressEnd = 0.6;
 
@@ -532,6 +550,13 @@ int FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-benchmark", Qt::CaseInsensitive) == 0)||
+			(m_arguments[i].compare("--benchmark", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::BenchmarkService;
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
 		if (m_arguments[i].compare("-ep", Qt::CaseInsensitive) == 0) {
 			m_externalProcessPath = m_arguments[i + 1];
 			toRemove << i << i + 1;
@@ -558,6 +583,7 @@ int FApplication::init() {
 	m_lastTopmostWindow = nullptr;
 
 	new FMessageLogProbe();
+	new FTimingProbe();
 
 	connect(&m_activationTimer, SIGNAL(timeout()), this, SLOT(updateActivation()));
 	m_activationTimer.setInterval(10);
@@ -853,13 +879,7 @@ bool FApplication::loadReferenceModel(const QString &  databaseName, bool fullLo
 }
 
 MainWindow * FApplication::openWindowForService(bool lockFiles, int initialTab) {
-	// our MainWindows use WA_DeleteOnClose so this has to be added to the heap (via new) rather than the stack (for local vars)
-	MainWindow * mainWindow = MainWindow::newMainWindow(m_referenceModel, "", false, lockFiles, initialTab);   // this is also slow
-	mainWindow->setReportMissingModules(false);
-	mainWindow->noBackup();
-	mainWindow->noSchematicConversion();
-
-	return mainWindow;
+	return ExportSession::openWindow(m_referenceModel, lockFiles, initialTab);
 }
 
 int FApplication::serviceStartup() {
@@ -909,6 +929,10 @@ int FApplication::serviceStartup() {
 		runExampleService();
 		return 0;
 
+	case ServiceType::BenchmarkService:
+		runBenchmarkService();
+		return 0;
+
 	default:
 		DebugDialog::debug("unknown service");
 		return -1;
@@ -928,22 +952,22 @@ QString FApplication::runServiceAux(ExportFunction exportFunc, int mainWindowArg
 	QStringList filenames = dir.entryList(filters, QDir::Files);
 	bool fail = false;
 	QStringList failedFiles;
+
+	// one window for the whole folder: each sketch is cleared out of it before the next is loaded
+	ExportSession session(m_referenceModel, mainWindowArg);
 	Q_FOREACH (QString filename, filenames) {
 		QString filepath = dir.absoluteFilePath(filename);
-		MainWindow * mainWindow = openWindowForService(false, mainWindowArg);
 		m_started = true;
 
 		FolderUtils::setOpenSaveFolderAux(m_outputFolder);
-		if (mainWindow->loadWhich(filepath, false, false, false, "")) {
+		MainWindow * mainWindow = session.load(filepath);
+		if (mainWindow != nullptr) {
 			exportFunc(mainWindow, filepath, dir);
 		} else {
 			fail = true;
 			failedFiles.append(filepath);
 			DebugDialog::debug(QString("FApplication: failed to load file: %1").arg(filepath));
 		}
-
-		mainWindow->setCloseSilently(true);
-		mainWindow->close();
 	}
 	if (fail) {
 		return "Loading failed for files: " + failedFiles.join(", ");
@@ -970,7 +994,10 @@ QString FApplication::runIpcServiceAux() {
     return runServiceAux([](MainWindow* mainWindow, const QString& filepath, const QDir& /*dir*/) {
 		QFileInfo info(filepath);
 		QString filepathIPC = filepath;
-		TextUtils::writeUtf8(filepathIPC.replace(".fzz", ".ipc"), mainWindow->exportIPC_D_356A());
+		QFile ipcFile(filepathIPC.replace(".fzz", ".ipc"));
+		if (ipcFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			mainWindow->exportIPC_D_356A(ipcFile);
+		}
 	});
 }
 
@@ -997,7 +1024,10 @@ void FApplication::runExportAllServiceAux() {
 		TextUtils::writeUtf8(filepathCsv.replace(".fzz", "_bom.csv"), mainWindow->getExportBOM_CSV());
 
 		QString filepathIPC = filepath;
-		TextUtils::writeUtf8(filepathIPC.replace(".fzz", ".ipc"), mainWindow->exportIPC_D_356A());
+		QFile ipcFile(filepathIPC.replace(".fzz", ".ipc"));
+		if (ipcFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			mainWindow->exportIPC_D_356A(ipcFile);
+		}
 	});
 }
 
@@ -1010,7 +1040,10 @@ QString FApplication::runExportAllPlusSvgServiceAux() {
 		TextUtils::writeUtf8(filepathCsv.replace(".fzz", "_bom.csv"), mainWindow->getExportBOM_CSV());
 
 		QString filepathIPC = filepath;
-		TextUtils::writeUtf8(filepathIPC.replace(".fzz", ".ipc"), mainWindow->exportIPC_D_356A());
+		QFile ipcFile(filepathIPC.replace(".fzz", ".ipc"));
+		if (ipcFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			mainWindow->exportIPC_D_356A(ipcFile);
+		}
 
 		QList<ViewLayer::ViewID> ids;
 		ids << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
@@ -1075,27 +1108,31 @@ void FApplication::runDatabaseService()
 }
 
 void FApplication::runGedaService() {
-	try {
-		QDir dir(m_outputFolder);
-		QStringList filters;
-		filters << "*.fp";
-		QStringList filenames = dir.entryList(filters, QDir::Files);
-		Q_FOREACH (QString filename, filenames) {
-			QString filepath = dir.absoluteFilePath(filename);
+	QDir dir(m_outputFolder);
+	QStringList filters;
+	filters << "*.fp";
+	QStringList filepaths;
+	Q_FOREACH (QString filename, dir.entryList(filters, QDir::Files)) {
+		filepaths.append(dir.absoluteFilePath(filename));
+	}
+
+	// one footprint per file, so the files convert independently of each other
+	QtConcurrent::blockingMap(filepaths, [](const QString & filepath) {
+		try {
 			QString newfilepath = filepath;
 			newfilepath.replace(".fp", ".svg");
 			GedaElement2Svg geda;
 			QString svg = geda.convert(filepath, false);
 			TextUtils::writeUtf8(newfilepath, svg);
 		}
-	}
-	catch (const QString & msg) {
-		DebugDialog::debug(msg);
-	}
-	catch (...) {
-		// Not sure why this was originally added.
-		DebugDialog::debug("runGedaService: discarding exception");
-	}
+		catch (const QString & msg) {
+			DebugDialog::debug(msg);
+		}
+		catch (...) {
+			// Not sure why this was originally added.
+			DebugDialog::debug("runGedaService: discarding exception");
+		}
+	});
 }
 
 
@@ -1155,40 +1192,272 @@ void FApplication::runDRCService() {
 	}
 }
 
+static void benchmarkViewport(SketchWidget * sketchWidget) {
+	static const int Steps = 20;
+	static const struct {
+		int zoom;
+		const char * name;
+	} RenderZooms[] = {
+		{ 100, "render 100%" },
+		{ 50, "render 50%" },
+		{ 25, "render 25%" },
+		{ 10, "render 10%" },
+		{ 5, "render 5%" },
+	};
+
+	sketchWidget->fitInWindow();
+	{
+		FTimingScope timingScope("zoom");
+		for (int i = 0; i < Steps; i++) {
+			sketchWidget->relativeZoom(i < Steps / 2 ? 20 : -20, false);
+			sketchWidget->viewport()->repaint();
+		}
+	}
+
+	sketchWidget->absoluteZoom(400);
+	{
+		FTimingScope timingScope("pan");
+		QScrollBar * h = sketchWidget->horizontalScrollBar();
+		QScrollBar * v = sketchWidget->verticalScrollBar();
+		for (int i = 0; i <= Steps; i++) {
+			h->setValue(h->minimum() + (h->maximum() - h->minimum()) * i / Steps);
+			v->setValue(v->minimum() + (v->maximum() - v->minimum()) * i / Steps);
+			sketchWidget->viewport()->repaint();
+		}
+	}
+
+	// whole repaints at fixed zoom levels, where the level of detail decides what gets drawn
+	for (const auto & renderZoom : RenderZooms) {
+		sketchWidget->fitInWindow();
+		sketchWidget->absoluteZoom(renderZoom.zoom);
+		sketchWidget->viewport()->repaint();
+		FTimingScope timingScope(renderZoom.name);
+		for (int i = 0; i < Steps; i++) {
+			sketchWidget->viewport()->repaint();
+		}
+	}
+}
+
+// the process's resident set in bytes, or -1 where it can't be had
+static qint64 residentBytes() {
+#if defined(Q_OS_LINUX)
+	QFile file("/proc/self/statm");
+	if (!file.open(QIODevice::ReadOnly)) return -1;
+
+	QList<QByteArray> fields = file.readAll().split(' ');
+	if (fields.count() < 2) return -1;
+
+	return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#elif defined(Q_OS_MACOS)
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) != KERN_SUCCESS) return -1;
+
+	return info.resident_size;
+#else
+	return -1;
+#endif
+}
+
+static void benchmarkUndo(SketchWidget * sketchWidget, QJsonObject & result) {
+	static const int Commands = 10000;
+
+	QList<ItemBase *> itemBases;
+	Q_FOREACH (QGraphicsItem * item, sketchWidget->scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == nullptr || itemBase->parentItem() != nullptr) continue;
+
+		itemBases.append(itemBase);
+	}
+	if (itemBases.isEmpty()) return;
+
+	// a macro of moves that leave every part where it is; the memory budget goes by the
+	// estimate, the resident set shows how far off it is (allocator slack included)
+	WaitPushUndoStack * undoStack = sketchWidget->undoStack();
+	undoStack->clear();
+	qint64 residentBefore = residentBytes();
+	auto * parentCommand = new QUndoCommand("benchmark");
+	for (int i = 0; i < Commands; i++) {
+		ItemBase * itemBase = itemBases.at(i % itemBases.count());
+		ViewGeometry oldGeometry = itemBase->getViewGeometry();
+		ViewGeometry newGeometry = oldGeometry;
+		new MoveItemCommand(sketchWidget, itemBase->id(), oldGeometry, newGeometry, false, parentCommand);
+	}
+	result["undoMacroEstimatedBytes"] = WaitPushUndoStack::estimatedCost(parentCommand);
+
+	{
+		FTimingScope timingScope("undo macro push");
+		undoStack->push(parentCommand);
+	}
+	qint64 residentAfter = residentBytes();
+	if (residentBefore >= 0 && residentAfter >= 0) {
+		result["undoMacroResidentBytes"] = residentAfter - residentBefore;
+	}
+	{
+		FTimingScope timingScope("undo macro undo");
+		undoStack->undo();
+	}
+	{
+		FTimingScope timingScope("undo macro redo");
+		undoStack->redo();
+	}
+	result["undoStackEstimatedBytes"] = undoStack->estimatedCost();
+	{
+		FTimingScope timingScope("undo stack clear");
+		undoStack->clear();
+	}
+}
+
+void FApplication::runBenchmarkService() {
+	m_started = true;
+	FMessageBox::BlockMessages = true;
+	initService();
+
+	QDir dir(m_outputFolder);
+	QStringList filters;
+	filters << "*" + FritzingSketchExtension << "*" + FritzingBundleExtension;
+	QStringList filenames = dir.entryList(filters, QDir::Files, QDir::Name);
+
+	QTemporaryDir tempDir;
+	if (!tempDir.isValid()) {
+		DebugDialog::debug("runBenchmarkService: unable to create temporary folder");
+		return;
+	}
+
+	QJsonArray results;
+	Q_FOREACH (QString filename, filenames) {
+		QString filepath = dir.absoluteFilePath(filename);
+		FTimingProbe::clear();
+
+		MainWindow * mainWindow = openWindowForService(false, 3);
+		if (mainWindow == nullptr) continue;
+
+		mainWindow->setCloseSilently(true);
+
+		QJsonObject result;
+		result["file"] = filename;
+		if (!mainWindow->loadWhich(filepath, false, false, false, "")) {
+			DebugDialog::debug(QString("runBenchmarkService: failed to load '%1'").arg(filepath));
+			result["error"] = QString("load failed");
+			results.append(result);
+			mainWindow->close();
+			delete mainWindow;
+			continue;
+		}
+
+		Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
+			mainWindow->setCurrentView(sketchWidget->viewID());
+			benchmarkViewport(sketchWidget);
+		}
+
+		mainWindow->showPCBView();
+
+		RoutingStatus routingStatus;
+		routingStatus.zero();
+		mainWindow->pcbView()->updateRoutingStatus(routingStatus, true);
+
+		QFileInfo info(filepath);
+		mainWindow->saveAsAux(QDir(tempDir.path()).absoluteFilePath(info.completeBaseName() + FritzingBundleExtension));
+
+		QList<ItemBase *> boards = mainWindow->pcbView()->findBoard();
+		if (boards.count() > 0) {
+			mainWindow->pcbView()->selectAllItems(false, false);
+			boards.first()->setSelected(true);
+			mainWindow->newDesignRulesCheck(false);
+			GerberGenerator::exportToGerber(info.completeBaseName(), tempDir.path(), boards.first(), mainWindow->pcbView(), false);
+			// autoroute last, it modifies the sketch
+			QMetaObject::invokeMethod(mainWindow, "newAutoroute", Qt::DirectConnection);
+		}
+
+		benchmarkUndo(mainWindow->pcbView(), result);
+
+		// copy everything once, then paste it twice through the local clipboard
+		mainWindow->setCurrentView(ViewLayer::BreadboardView);
+		QMetaObject::invokeMethod(mainWindow, "selectAll", Qt::DirectConnection);
+		{
+			FTimingScope timingScope("duplicate");
+			QMetaObject::invokeMethod(mainWindow, "duplicate", Qt::DirectConnection);
+		}
+		{
+			FTimingScope timingScope("paste");
+			QMetaObject::invokeMethod(mainWindow, "paste", Qt::DirectConnection);
+		}
+
+		result["timings"] = FTimingProbe::timings();
+		results.append(result);
+
+		mainWindow->close();
+		delete mainWindow;
+	}
+
+	QJsonObject root;
+	root["fritzingVersion"] = Version::versionString();
+	root["results"] = results;
+	QString resultsPath = dir.absoluteFilePath("benchmark-results.json");
+	TextUtils::writeUtf8(resultsPath, QString(QJsonDocument(root).toJson(QJsonDocument::Indented)));
+	DebugDialog::debug(QString("runBenchmarkService: results written to '%1'").arg(resultsPath));
+}
+
 void FApplication::runKicadFootprintService() {
+	struct FootprintJob {
+		QString newFilePath;
+		QStringList moduleNames;		// every module that maps to newFilePath, in index order
+	};
+
 	QDir dir(m_outputFolder);
 	QStringList filters;
 	filters << "*.mod";
 	QStringList filenames = dir.entryList(filters, QDir::Files);
 	Q_FOREACH (QString filename, filenames) {
 		QString filepath = dir.absoluteFilePath(filename);
-		QStringList moduleNames = KicadModule2Svg::listModules(filepath);
-		Q_FOREACH (QString moduleName, moduleNames) {
-			KicadModule2Svg kicad;
-			try {
-				QString svg = kicad.convert(filepath, moduleName, false);
-				if (svg.isEmpty()) {
-					DebugDialog::debug("svg is empty " + filepath + " " + moduleName);
-					continue;
-				}
-				Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
-					moduleName.remove(c);
-				}
+		KicadModule2Svg::Library library;
+		if (!library.load(filepath)) continue;
+
+		QList<FootprintJob> jobs;
+		QHash<QString, int> jobIndexes;
+		Q_FOREACH (QString moduleName, library.moduleNames) {
+			QString safeName = moduleName;
+			Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
+				safeName.remove(c);
+			}
 
-				QString newFilePath = dir.absoluteFilePath(moduleName + "_" + filename);
-				newFilePath.replace(".mod", ".svg");
+			QString newFilePath = dir.absoluteFilePath(safeName + "_" + filename);
+			newFilePath.replace(".mod", ".svg");
 
-				if (!TextUtils::writeUtf8(newFilePath, svg)) {
-					DebugDialog::debug("unable to open file " + newFilePath);
-				}
+			int index = jobIndexes.value(newFilePath, -1);
+			if (index < 0) {
+				index = jobs.count();
+				jobIndexes.insert(newFilePath, index);
+				jobs.append(FootprintJob { newFilePath, QStringList() });
 			}
-			catch (const QString & msg) {
-				DebugDialog::debug(msg);
-			}
-			catch (...) {
-				DebugDialog::debug("who knows");
+			jobs[index].moduleNames.append(moduleName);
+		}
+
+		// when several modules share an output file, the last one that converts is the one that lands there
+		QtConcurrent::blockingMap(jobs, [&library, &filepath](FootprintJob & job) {
+			for (int i = job.moduleNames.count() - 1; i >= 0; i--) {
+				const QString & moduleName = job.moduleNames.at(i);
+				KicadModule2Svg kicad;
+				try {
+					QString svg = kicad.convert(library, moduleName, false);
+					if (svg.isEmpty()) {
+						DebugDialog::debug("svg is empty " + filepath + " " + moduleName);
+						continue;
+					}
+
+					if (!TextUtils::writeUtf8(job.newFilePath, svg)) {
+						DebugDialog::debug("unable to open file " + job.newFilePath);
+					}
+					return;
+				}
+				catch (const QString & msg) {
+					DebugDialog::debug(msg);
+				}
+				catch (...) {
+					DebugDialog::debug("who knows");
+				}
 			}
-		}
+		});
 	}
 }
 
@@ -1454,6 +1723,16 @@ void FApplication::updatePrefs(PrefsDialog & prefsDialog)
 		else if (key.compare("autosaveEnabled") == 0) {
 			MainWindow::setAutosaveEnabled(hash.value(key).toInt() != 0);
 		}
+		else if (key.compare("undoMemoryBudget") == 0) {
+			WaitPushUndoStack::setMemoryBudget(hash.value(key).toInt());
+		}
+		else if (key.compare("tileCacheEnabled") == 0) {
+			Q_FOREACH (MainWindow * mainWindow, mainWindows) {
+				Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
+					sketchWidget->setTileCacheEnabled(hash.value(key).toInt() != 0);
+				}
+			}
+		}
 		else if (key.contains("curvy", Qt::CaseInsensitive)) {
 			Q_FOREACH (MainWindow * mainWindow, mainWindows) {
 				Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
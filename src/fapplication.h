@@ -183,6 +183,7 @@ protected:
 	QString runSvgServiceAux();
 	void runExampleService();
 	void runExampleService(QDir &);
+	void runBenchmarkService();
 	QList<class MainWindow *> recoverBackups();
 	QList<MainWindow *> loadLastOpenSketch();
 	void doLoadPrevious(MainWindow *);
@@ -208,6 +209,7 @@ protected:
 		PortService,
 		DRCService,
 		ExportAllService,
+		BenchmarkService,
 		NoService
 	};
 
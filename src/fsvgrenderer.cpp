@@ -35,12 +35,16 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <qnumeric.h>
 
+#include <atomic>
+
 /////////////////////////////////////////////
 
 QString FSvgRenderer::NonConnectorName("nonconn");
 
 static ConnectorInfo VanillaConnectorInfo;
 
+static std::atomic<quint64> NextContentSerial(0);
+
 FSvgRenderer::FSvgRenderer(QObject * parent) : QSvgRenderer(parent)
 {
 	m_defaultSizeF = QSizeF(0,0);
@@ -114,12 +118,12 @@ QByteArray FSvgRenderer::loadSvg(const QByteArray & contents, const LoadInfo & l
 	return loadAux(contents, loadInfo);
 }
 
-QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo & loadInfo)
+QByteArray FSvgRenderer::cleanSvg(const QByteArray & contents)
 {
-	QByteArray cleanContents(theContents);
+	// no member access here: SvgPreloader calls this from worker threads
 	bool cleaned = false;
 
-	QString string(cleanContents);
+	QString string(contents);
 	if (TextUtils::fixMuch(string, false)) {
 		cleaned = true;
 	}
@@ -127,9 +131,16 @@ QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo
 		cleaned = true;
 	}
 	if (cleaned) {
-		cleanContents = string.toUtf8();
+		return string.toUtf8();
 	}
 
+	return contents;
+}
+
+QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo & loadInfo)
+{
+	QByteArray cleanContents = loadInfo.cleanContents.isEmpty() ? cleanSvg(theContents) : loadInfo.cleanContents;
+
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
@@ -189,6 +200,7 @@ QByteArray FSvgRenderer::finalLoad(QByteArray & cleanContents, const QString & f
 	}
 
 	result = QSvgRenderer::load(cleanContents);
+	m_contentSerial = ++NextContentSerial;
 	if (result) {
 		m_filename = filename;
 		return cleanContents;
@@ -198,9 +210,14 @@ QByteArray FSvgRenderer::finalLoad(QByteArray & cleanContents, const QString & f
 }
 
 bool FSvgRenderer::fastLoad(const QByteArray & contents) {
+	m_contentSerial = ++NextContentSerial;
 	return QSvgRenderer::load(contents);
 }
 
+quint64 FSvgRenderer::contentSerial() const {
+	return m_contentSerial;
+}
+
 QPixmap * FSvgRenderer::getPixmap(QSvgRenderer * renderer, QSize size)
 {
 	auto *pixmap = new QPixmap(size);
@@ -225,6 +242,32 @@ QPixmap * FSvgRenderer::getPixmap(QSvgRenderer * renderer, QSize size)
 	return pixmap;
 }
 
+QImage FSvgRenderer::getImage(QSvgRenderer * renderer, QSize size, double devicePixelRatio)
+{
+	// same layout as getPixmap, but safe to call off the gui thread, and sharp on high dpi screens
+	QSize deviceSize = size * devicePixelRatio;
+	QImage image(deviceSize, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+	QPainter painter(&image);
+	QSizeF def = renderer->defaultSize();
+	auto * frenderer = qobject_cast<FSvgRenderer *>(renderer);
+	if (frenderer != nullptr) {
+		def = frenderer->defaultSizeF();
+	}
+	double newW = deviceSize.width();
+	double newH = newW * def.height() / def.width();
+	if (newH > deviceSize.height()) {
+		newH = deviceSize.height();
+		newW = newH * def.width() / def.height();
+	}
+	QRectF bounds((deviceSize.width() - newW) / 2.0, (deviceSize.height() - newH) / 2.0, newW, newH);
+	renderer->render(&painter, bounds);
+	painter.end();
+
+	image.setDevicePixelRatio(devicePixelRatio);
+	return image;
+}
+
 bool FSvgRenderer::determineDefaultSize(QXmlStreamReader & xml)
 {
 	QSizeF size = parseForWidthAndHeight(xml);
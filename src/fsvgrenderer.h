@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define FSVGRENDERER_H
 
 #include <QHash>
+#include <QImage>
 #include <QSvgRenderer>
 #include <QXmlStreamReader>
 #include <QDomDocument>
@@ -55,6 +56,7 @@ struct LoadInfo {
 	QString colorElementID;
 	bool findNonConnectors = false;
 	bool parsePaths = false;;
+	QByteArray cleanContents;		// already run through cleanSvg, e.g. by SvgPreloader
 
 	LoadInfo() = default;
     LoadInfo(const QString& file, bool _findNonConnector = false) : filename(file), findNonConnectors(_findNonConnector) { }
@@ -77,13 +79,16 @@ public:
 	QByteArray finalLoad(QByteArray & cleanContents, const QString & filename);
 	constexpr const QString & filename() const noexcept { return m_filename; }
 	QSizeF defaultSizeF();
+	quint64 contentSerial() const;
 	bool setUpConnector(class SvgIdLayer * svgIdLayer, bool ignoreTerminalPoint, ViewLayer::ViewLayerPlacement);
 	QList<SvgIdLayer *> setUpNonConnectors(ViewLayer::ViewLayerPlacement);
 
 public:
 	static void cleanup();
 	static QSizeF parseForWidthAndHeight(QXmlStreamReader &);
+	static QByteArray cleanSvg(const QByteArray & contents);
 	static QPixmap * getPixmap(QSvgRenderer * renderer, QSize size);
+	static QImage getImage(QSvgRenderer * renderer, QSize size, double devicePixelRatio);
 	static void initNames();
 
 protected:
@@ -108,6 +113,7 @@ protected:
 protected:
 	QString m_filename;
 	QSizeF m_defaultSizeF;
+	quint64 m_contentSerial = 0;	// changes with every load, unique across renderers
 	QHash<QString, ConnectorInfo *> m_connectorInfoHash;
 	QHash<QString, ConnectorInfo *> m_nonConnectorInfoHash;
 
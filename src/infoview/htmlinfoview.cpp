@@ -28,8 +28,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "htmlinfoview.h"
 #include "scalediconframe.h"
+#include "iconpixmapcache.h"
 #include "../sketch/infographicsview.h"
 #include "../debugdialog.h"
+#include "../fsvgrenderer.h"
 #include "../connectors/connector.h"
 #include "../utils/flineedit.h"
 #include "../utils/clickablelabel.h"
@@ -155,6 +157,7 @@ void HtmlInfoView::init(bool tinyMode) {
 
 	m_iconFrame = new ScaledIconFrame(this);
 	vlo->addWidget(m_iconFrame);
+	connect(IconPixmapCache::instance(), &IconPixmapCache::pixmapReady, this, &HtmlInfoView::iconReady);
 
 	m_partUrl = new TagLabel(this);
 	m_partUrl->setWordWrap(false);
@@ -662,25 +665,53 @@ void HtmlInfoView::setUpIcons(ItemBase * itemBase, bool swappingEnabled) {
 
 	m_lastIconItemBase = itemBase;
 
-	QPixmap *pixmap1 = nullptr;
-	QPixmap *pixmap2 = nullptr;
-	QPixmap *pixmap3 = nullptr;
-
 	QSize size = QSize(ScaledIconFrame::STANDARD_ICON_IMG_WIDTH, ScaledIconFrame::STANDARD_ICON_IMG_HEIGHT);
+	double devicePixelRatio = devicePixelRatioF();
+	IconPixmapCache * cache = IconPixmapCache::instance();
+
+	static const ViewLayer::ViewID ViewIDs[] = { ViewLayer::BreadboardView, ViewLayer::SchematicView, ViewLayer::PCBView };
+	for (int i = 0; i < 3; i++) {
+		m_iconPixmaps[i] = QPixmap();
+		m_pendingIconKeys[i].clear();
+		if (itemBase == nullptr) continue;
+
+		QSvgRenderer * renderer = nullptr;
+		QString filename;
+		if (!itemBase->getPixmapSource(ViewIDs[i], swappingEnabled, renderer, filename)) continue;
+
+		if (renderer != nullptr) {
+			auto * fsvgRenderer = qobject_cast<FSvgRenderer *>(renderer);
+			QString key = (fsvgRenderer == nullptr) ? QString() : IconPixmapCache::rendererKey(fsvgRenderer->contentSerial(), size, devicePixelRatio);
+			if (key.isEmpty() || !cache->find(key, m_iconPixmaps[i])) {
+				m_iconPixmaps[i] = QPixmap::fromImage(FSvgRenderer::getImage(renderer, size, devicePixelRatio));
+				if (!key.isEmpty()) cache->insert(key, m_iconPixmaps[i]);
+			}
+			continue;
+		}
 
-	if (itemBase != nullptr) {
-		itemBase->getPixmaps(pixmap1, pixmap2, pixmap3, swappingEnabled, size);
+		// rendering from the file is the slow part: leave it to the thread pool, and fill in the icon in iconReady()
+		QString key = IconPixmapCache::fileKey(itemBase->moduleID(), ViewIDs[i], swappingEnabled, size, devicePixelRatio);
+		if (!cache->find(key, m_iconPixmaps[i])) {
+			m_pendingIconKeys[i] = key;
+			cache->requestFile(key, filename, size, devicePixelRatio);
+		}
 	}
 
-	QPixmap* use1 = pixmap1;
-	QPixmap* use2 = pixmap2;
-	QPixmap* use3 = pixmap3;
+	m_iconFrame->setIcons(&m_iconPixmaps[0], &m_iconPixmaps[1], &m_iconPixmaps[2]);
+}
+
+void HtmlInfoView::iconReady(const QString & key) {
+	bool changed = false;
+	for (int i = 0; i < 3; i++) {
+		if (m_pendingIconKeys[i] != key) continue;
 
-	m_iconFrame->setIcons(use1, use2, use3);
+		m_pendingIconKeys[i].clear();
+		changed = IconPixmapCache::instance()->find(key, m_iconPixmaps[i]) || changed;
+	}
 
-	if (pixmap1 != nullptr) delete pixmap1;
-	if (pixmap2 != nullptr) delete pixmap2;
-	if (pixmap3 != nullptr) delete pixmap3;
+	if (changed) {
+		m_iconFrame->setIcons(&m_iconPixmaps[0], &m_iconPixmaps[1], &m_iconPixmaps[2]);
+	}
 }
 
 void HtmlInfoView::addSpice(ModelPart * modelPart) {
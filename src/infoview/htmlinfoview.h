@@ -107,6 +107,7 @@ protected Q_SLOTS:
 	void xyEntry();
 	void unitsClicked();
 	void rotEntry();
+	void iconReady(const QString & key);
 
 protected:
 	void appendStuff(ItemBase* item, bool swappingEnabled); //finds out if it's a wire or something else
@@ -196,6 +197,8 @@ protected:
 
 private:
 	ScaledIconFrame * m_iconFrame;
+	QPixmap m_iconPixmaps[3];
+	QString m_pendingIconKeys[3];		// icons still being rendered by IconPixmapCache
 	QSize m_lastSizeWithScrollbarsAlwaysOn;
 
 };
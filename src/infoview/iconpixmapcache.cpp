@@ -0,0 +1,91 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "iconpixmapcache.h"
+#include "../fsvgrenderer.h"
+
+#include <QSvgRenderer>
+#include <QtConcurrentRun>
+
+const int IconPixmapCache::MaxCost = 16 * 1024;
+
+static IconPixmapCache * TheIconPixmapCache = nullptr;
+
+IconPixmapCache::IconPixmapCache() : QObject()
+{
+	m_cache.setMaxCost(MaxCost);
+}
+
+IconPixmapCache * IconPixmapCache::instance()
+{
+	// never deleted: renders still running at exit report back to it
+	if (TheIconPixmapCache == nullptr) {
+		TheIconPixmapCache = new IconPixmapCache();
+	}
+
+	return TheIconPixmapCache;
+}
+
+QString IconPixmapCache::fileKey(const QString & moduleID, ViewLayer::ViewID viewID, bool swappingEnabled, QSize size, double devicePixelRatio)
+{
+	return QString("%1|%2|%3|%4x%5|%6").arg(moduleID).arg(viewID).arg(swappingEnabled).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+}
+
+QString IconPixmapCache::rendererKey(quint64 contentSerial, QSize size, double devicePixelRatio)
+{
+	return QString("#%1|%2x%3|%4").arg(contentSerial).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+}
+
+bool IconPixmapCache::find(const QString & key, QPixmap & pixmap)
+{
+	QPixmap * cached = m_cache.object(key);
+	if (cached == nullptr) return false;
+
+	pixmap = *cached;
+	return true;
+}
+
+void IconPixmapCache::insert(const QString & key, const QPixmap & pixmap)
+{
+	qint64 bytes = (qint64) pixmap.width() * pixmap.height() * 4;
+	m_cache.insert(key, new QPixmap(pixmap), qMax<qint64>(1, bytes / 1024));
+}
+
+void IconPixmapCache::requestFile(const QString & key, const QString & filename, QSize size, double devicePixelRatio)
+{
+	if (m_pending.contains(key)) return;
+
+	m_pending.insert(key);
+	(void) QtConcurrent::run([this, key, filename, size, devicePixelRatio]() {
+		QSvgRenderer renderer(filename);
+		QImage image = FSvgRenderer::getImage(&renderer, size, devicePixelRatio);
+		QMetaObject::invokeMethod(this, [this, key, image]() {
+			imageReady(key, image);
+		}, Qt::QueuedConnection);
+	});
+}
+
+void IconPixmapCache::imageReady(const QString & key, const QImage & image)
+{
+	// QPixmaps can only be made on the gui thread
+	m_pending.remove(key);
+	insert(key, QPixmap::fromImage(image));
+	Q_EMIT pixmapReady(key);
+}
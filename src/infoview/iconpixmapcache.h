@@ -0,0 +1,70 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef ICONPIXMAPCACHE_H
+#define ICONPIXMAPCACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+
+#include "../viewlayer.h"
+
+// Least recently used cache of the Inspector's view icons, shared by all windows.
+//
+// Icons rendered straight from a part's svg file are keyed by module ID, view, swap state, size and
+// device pixel ratio, and rendered on the thread pool; pixmapReady() says when one has arrived.
+// Icons of instantiated items are keyed by their renderer's content serial instead, since
+// properties can change what an instance looks like.
+
+class IconPixmapCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	static IconPixmapCache * instance();
+	static QString fileKey(const QString & moduleID, ViewLayer::ViewID, bool swappingEnabled, QSize, double devicePixelRatio);
+	static QString rendererKey(quint64 contentSerial, QSize, double devicePixelRatio);
+
+public:
+	bool find(const QString & key, QPixmap & pixmap);
+	void insert(const QString & key, const QPixmap & pixmap);
+	void requestFile(const QString & key, const QString & filename, QSize, double devicePixelRatio);
+
+Q_SIGNALS:
+	void pixmapReady(const QString & key);
+
+protected:
+	IconPixmapCache();
+
+	void imageReady(const QString & key, const QImage & image);
+
+protected:
+	QCache<QString, QPixmap> m_cache;		// cost in kilobytes
+	QSet<QString> m_pending;
+
+	static const int MaxCost;
+};
+
+#endif
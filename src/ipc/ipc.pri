@@ -5,6 +5,8 @@
 
 INCLUDEPATH += $$PWD
 
-HEADERS += $$PWD/ipc_d_356.h
-SOURCES += $$PWD/ipc_d_356.cpp
+HEADERS += $$PWD/ipc_d_356.h \
+	$$PWD/ipc_d_356_writer.h
+SOURCES += $$PWD/ipc_d_356.cpp \
+	$$PWD/ipc_d_356_writer.cpp
 
@@ -1,9 +1,14 @@
 #include <QString>
 #include <QList>
 
+#include "ipc_d_356_writer.h"
+
 class ItemBase;
 class ConnectorItem;
+class QIODevice;
 
+QList<IPCD356ARecord> collectIPC_D_356A(ItemBase * board, QList< QList<ConnectorItem *>* > netList);
+bool exportIPC_D_356A(QIODevice & device, ItemBase * board, const QString & basename, QList< QList<ConnectorItem *>* > netList);
 QString getExportIPC_D_356A(ItemBase * board, QString basename, QList< QList<ConnectorItem *>* > netList);
 
 
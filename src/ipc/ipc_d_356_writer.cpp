@@ -0,0 +1,144 @@
+# /*******************************************************************
+# Part of the Fritzing project - https://fritzing.org
+# Copyright (c) 2024 Fritzing GmbH
+# ********************************************************************/
+
+#include "ipc_d_356_writer.h"
+
+#include <QIODevice>
+#include <QRegularExpression>
+
+// records are collected here and written to the device in chunks of about this size
+static constexpr int WriteBufferSize = 64 * 1024;
+
+QString getPinNumberOrIdentifier(const QString & connectorId, const QString & connectorName) {
+	QString pin;
+
+	static const QRegularExpression matcher("\\d+"); // Matches one or more digits
+	QRegularExpressionMatch match = matcher.match(connectorId);
+
+	if(connectorId.length() <= 4) {
+		pin = connectorId;
+	} else if(match.hasMatch()) {
+		QString numberStr = match.captured(0);
+		pin = numberStr.length() > 4 ? numberStr.left(4) : numberStr;
+	} else {
+		pin = connectorId.left(4);
+	}
+
+	if (connectorName.contains("anode", Qt::CaseInsensitive)) pin = "A";
+	if (connectorName.contains("catho", Qt::CaseInsensitive)) pin = "C";
+	// Use the connector number instead of "GND" to avoid duplicate naming
+	//	if (connectorName.contains("gnd", Qt::CaseInsensitive)) pin = "GND";
+	if (connectorName == "-") pin = "-";
+	if (connectorName == "+") pin = "+";
+	return pin;
+}
+
+QString electricalTestRecord(const IPCD356ARecord & record) {
+// Standard electrical test record (setr)
+//		Column      Data            Description      Number      Meaning
+//			1 P,C,3  C=comment, P=parameter, 3=test record
+//			2 1,2,5,6 1=through hole, 2=SMT feature, 3=tooling feature/hole, 4=tooling hole only
+//			3 7 Always a 7 for a test record 999      =      end      of      file
+//			4-17 Net Name Alphanumeric string (yes, nets name are limited to 14 characters)
+//			18-20  --- These fields are left blank for finished PCBs.
+//			21-32  Ref Des This is where the reference designator goes if it is known.
+//				21-26 ID,VIA RefDes (U or IC) or “VIA” if it is a via
+//				27  - Always a dash. ie U-17 or IC-12
+//				28-31 Alpha# Component pin number
+//				32  M M means a point in the middle of a net. Blank means the end of a net.
+//			33-38  Hole type Hole definition field
+//				33-37 D##### D=diameter, #=size in .0001 inches or .001 mm.
+//				38  P or U P=plated, U=unplated
+//			39-41  A## A=access side of PCB.  ##=00 if point is available from both sides. 01 if Primary side only. >01 means internal layers.
+//			42-57  Coords X, Y coordinates of test location.
+//				42  X Start of X coordinate
+//				43  +- or blank X coordinate polarity
+//				44-49 value  6 digits to .0001 inches. (No decimal points.) Leading zeros surpressed.
+//				50  Y Start of Y coordinate
+//				51  +- or blank Y coordinate polarity
+//				52-57 value  6 digits to .0001 inches. (No decimal points.) Leading zeros surpressed.
+//			58-71  Rect Data Dimensions for rectangular test feature.
+//				58-62 X####  X dimension of feature in .0001 inches
+//				63-67 Y####  Y dimension of feature in .0001 inches (Fields 68 - 80 are often left blank.)
+//				68-71 R### Rotation of feature in whole degrees.
+//			72 Not used. Must be left blank.
+//			73-74  S# Optional solder mask information.
+//			75-80  Optional test record. Commonly left blank.
+
+	int soldermask = 0;
+
+	QString pin = getPinNumberOrIdentifier(record.connectorId, record.connectorName);
+
+	int angle = (record.ccw_angle % 360 + 360) % 360;
+
+	const char setr[]{"%03d%-14.14s   %-6.6s-%4.4s%1.1s%1.1s%04d%1sA%02dX%+07dY%+07dX%04dY%04dR%03d S%1d     \n"};
+	QString s = QString::asprintf(setr,
+								  record.cmd,
+								  record.netLabel.toStdString().c_str(),
+								  record.partLabel.toStdString().c_str(),
+								  pin.toStdString().c_str(),
+								  record.isMiddle ? "M" : " ",
+								  record.isDrilled ? "D" : " ",
+								  record.r,
+								  record.isPlated ? "P" : "U",
+								  record.access,
+								  record.x,
+								  record.y,
+								  record.w,
+								  record.h,
+								  angle,
+								  soldermask
+								  );
+	return s;
+}
+
+/**
+ * Writes an IPC-D-356A netlist: comment lines, the parameter header, the records and the end marker.
+ * Only touches its arguments, so it can run on a worker thread once the records are collected.
+ */
+bool writeIPC_D_356A(QIODevice & device, const QString & basename, const QStringList & comments, const QList<IPCD356ARecord> & records) {
+	const char comment[]{"C  %.66s\n"};
+	const char header3[]{"P  %.3s   %.62s\n"};
+	const char header4[]{"P  %.4s  %.62s\n"};
+	const char header5[]{"P  %.5s %.62s\n"};
+	const char ende[]{"999\n"};
+
+	QByteArray buffer;
+	buffer.reserve(WriteBufferSize + 256);
+	bool ok = true;
+	auto flush = [&device, &buffer, &ok]() {
+		if (ok && device.write(buffer) != buffer.size()) {
+			ok = false;
+		}
+		buffer.clear();
+	};
+
+	Q_FOREACH (QString line, comments) {
+		buffer += QString::asprintf(comment, line.toStdString().c_str()).toUtf8();
+	}
+//	buffer += QString::asprintf(header, "JOB", "TEST").toUtf8();
+	buffer += QString::asprintf(header4, "CODE", "00").toUtf8();
+
+	//	 SI Metric
+	//	 CUST 0 or CUST Inches and degrees
+	//	 CUST 1 Millimeters and degrees
+	//	 CUST 2 Inches and radians
+	buffer += QString::asprintf(header5, "UNITS", "CUST 1").toUtf8();
+	buffer += QString::asprintf(header5, "TITLE", basename.toStdString().c_str()).toUtf8();
+	//buffer += QString::asprintf(header3, "NUM", NA).toUtf8();
+	//buffer += QString::asprintf(header3, "REV", NA).toUtf8();
+	buffer += QString::asprintf(header3, "VER", "IPC-D-356A").toUtf8();
+
+	for (const IPCD356ARecord & record : records) {
+		buffer += electricalTestRecord(record).toUtf8();
+		if (buffer.size() >= WriteBufferSize) {
+			flush();
+		}
+	}
+
+	buffer += ende;
+	flush();
+	return ok;
+}
@@ -0,0 +1,49 @@
+# /*******************************************************************
+# Part of the Fritzing project - https://fritzing.org
+# Copyright (c) 2024 Fritzing GmbH
+# ********************************************************************/
+
+#ifndef IPC_D_356_WRITER_H
+#define IPC_D_356_WRITER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class QIODevice;
+
+class IPCD356A {
+public:
+	enum OperationCodes {
+		ThroughHole = 317,
+		ThroughHoleContinuation = 17,
+		SurfaceMount = 327,
+		BlindVia = 307
+	};
+};
+
+// One test record, with everything already converted to ipc units.
+// Plain data, so records can be collected on the gui thread and written from anywhere.
+struct IPCD356ARecord {
+	int cmd = IPCD356A::SurfaceMount;
+	QString netLabel;
+	QString partLabel;
+	QString connectorName;
+	QString connectorId;
+	bool isMiddle = false;
+	bool isPlated = false;
+	bool isDrilled = false;
+	int r = 0;
+	int x = 0;
+	int y = 0;
+	int w = 0;
+	int h = 0;
+	int access = 0;
+	int ccw_angle = 0;
+};
+
+QString getPinNumberOrIdentifier(const QString & connectorId, const QString & connectorName);
+QString electricalTestRecord(const IPCD356ARecord &);
+bool writeIPC_D_356A(QIODevice & device, const QString & basename, const QStringList & comments, const QList<IPCD356ARecord> & records);
+
+#endif
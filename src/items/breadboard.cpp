@@ -48,6 +48,10 @@ void Breadboard::paintHover(QPainter *painter, const QStyleOptionGraphicsItem *o
 	Q_UNUSED(widget);
 }
 
+bool Breadboard::paintsHover() {
+	return false;
+}
+
 bool Breadboard::stickyEnabled() {
 	return false;
 }
@@ -55,3 +59,7 @@ bool Breadboard::stickyEnabled() {
 bool Breadboard::canFindConnectorsUnder() {
 	return false;
 }
+
+bool Breadboard::hasConnectorGrid() {
+	return true;
+}
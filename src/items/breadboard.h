@@ -35,8 +35,10 @@ public:
 	PluralType isPlural();
 	void hoverUpdate();
 	void paintHover(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+	bool paintsHover();
 	bool stickyEnabled();
 	bool canFindConnectorsUnder();
+	bool hasConnectorGrid();
 
 
 public:
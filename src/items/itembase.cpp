@@ -28,15 +28,18 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../connectors/connector.h"
 #include "../connectors/bus.h"
 #include "partlabel.h"
+#include "levelofdetail.h"
 #include "../layerattributes.h"
 #include "../fsvgrenderer.h"
 #include "../svg/svgfilesplitter.h"
 #include "../svg/svgflattener.h"
+#include "../svg/svgpreloader.h"
 #include "../utils/folderutils.h"
 #include "../utils/textutils.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/cursormaster.h"
 #include "../utils/clickablelabel.h"
+#include "../utils/gridindex.h"
 #include "../utils/familypropertycombobox.h"
 #include "../referencemodel/referencemodel.h"
 #include "../items/FProbeSwitchProperty.h"
@@ -102,6 +105,9 @@ QBrush ItemBase::EqualPotentialBrush(QColor(255,255,0));
 
 static QHash<QString, QStringList> CachedValues;
 
+// the items in each scene whose connectors are found through a GridIndex
+static QHash<QGraphicsScene *, QList<ItemBase *>> ConnectorGridItems;
+
 ///////////////////////////////////////////////////
 
 ItemBase::ItemBase( ModelPart* modelPart, ViewLayer::ViewID viewID, const ViewGeometry & viewGeometry, long id, QMenu * itemMenu )
@@ -148,6 +154,11 @@ ItemBase::~ItemBase() {
 		delete m_fsvgRenderer;
 	}
 
+	if (scene() != nullptr) {
+		ConnectorGridItems[scene()].removeOne(this);
+	}
+	delete m_connectorGridIndex;
+
 	//m_simItem is a child of this object, it gets delated by the destructor
 	m_simItem = nullptr;
 	// DebugDialog::debug(QString("deleted itembase %1").arg((qintptr)this, 0, 16));
@@ -712,7 +723,7 @@ bool ItemBase::inHover() {
 }
 
 void ItemBase::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
-	if (inHover()) {
+	if (inHover() && !LevelOfDetail::tooSmall(boundingRect(), LevelOfDetail::of(option, painter, widget))) {
 		//DebugDialog::debug(QString("chc:%1 hc:%2 chc2:%3").arg(m_connectorHoverCount).arg(m_hoverCount).arg(m_connectorHoverCount2));
 		layerKinChief()->paintHover(painter, option, widget);
 	}
@@ -725,7 +736,9 @@ void ItemBase::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 		painter->setOpacity(InactiveOpacity);
 	}
 
-	paintBody(painter, option, widget);
+	if (!paintedFromTiles(painter, widget)) {
+		paintBody(painter, option, widget);
+	}
 
 	if (option->state & QStyle::State_Selected) {
 		layerKinChief()->paintSelected(painter, option, widget);
@@ -736,10 +749,27 @@ void ItemBase::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 	}
 }
 
-void ItemBase::paintBody(QPainter *painter, const QStyleOptionGraphicsItem * /* option */, QWidget * /* widget */)
+void ItemBase::paintBody(QPainter *painter, const QStyleOptionGraphicsItem * option, QWidget * widget)
 {
 	// Qt's SVG renderer's defaultSize is not correct when the svg has a fractional pixel size
-	fsvgRenderer()->render(painter, boundingRectWithoutLegs());
+	FSvgRenderer * renderer = fsvgRenderer();
+	QRectF bounds = boundingRectWithoutLegs();
+	if (LevelOfDetail::paintPixmap(painter, renderer, renderer->contentSerial(), bounds, LevelOfDetail::of(option, painter, widget))) return;
+
+	renderer->render(painter, bounds);
+}
+
+bool ItemBase::paintedFromTiles(QPainter *painter, QWidget *widget)
+{
+	// only the view's own viewport paints from tiles, never printing or export
+	if (widget == nullptr || painter->device() != widget) return false;
+
+	InfoGraphicsView * infoGraphicsView = InfoGraphicsView::getInfoGraphicsView(this);
+	return infoGraphicsView != nullptr && infoGraphicsView->paintedFromTiles(this);
+}
+
+bool ItemBase::paintsHover() {
+	return true;
 }
 
 void ItemBase::paintHover(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -1200,6 +1230,16 @@ QVariant ItemBase::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
 			m_partLabel->ownerSelected(value.toBool());
 		}
 
+		break;
+	case QGraphicsItem::ItemSceneChange:
+		if (scene() != nullptr) {
+			ConnectorGridItems[scene()].removeOne(this);
+		}
+		break;
+	case QGraphicsItem::ItemSceneHasChanged:
+		if (scene() != nullptr && layerKinChief()->hasConnectorGrid()) {
+			ConnectorGridItems[scene()].append(this);
+		}
 		break;
 	default:
 		break;
@@ -1367,7 +1407,19 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 	QDomDocument flipDoc;
 	getFlipDoc(modelPart, filename, layerAttributes.viewLayerID, layerAttributes.viewLayerPlacement, flipDoc, layerAttributes.orientation);
 	QByteArray bytesToLoad;
-	if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
+	QByteArray cleanBytes;
+	PreloadedSvg preloadedSvg;
+	bool multipleLayers = (layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID);
+	QString preloadLayerName = multipleLayers ? ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID) : QString();
+	if (flipDoc.isNull() && SvgPreloader::lookup(filename, layerAttributes.viewLayerID, preloadLayerName, preloadedSvg)) {
+		if (!preloadedSvg.hasText) {
+			delete newRenderer;
+			return nullptr;
+		}
+		bytesToLoad = preloadedSvg.bytes;
+		cleanBytes = preloadedSvg.cleanBytes;
+	}
+	else if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
 		bytesToLoad = SvgFileSplitter::hideText(filename);
 	}
 	else if (layerAttributes.viewLayerID == ViewLayer::SchematicText) {
@@ -1377,7 +1429,7 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 			return nullptr;
 		}
 	}
-	else if ((layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID)) {
+	else if (multipleLayers) {
 		QString layerName = ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID);
 		// need to treat create "virtual" svg file for each layer
 		SvgFileSplitter svgFileSplitter;
@@ -1408,6 +1460,7 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 	QByteArray resultBytes;
 	if (!bytesToLoad.isEmpty()) {
 		if (makeLocalModifications(bytesToLoad, filename)) {
+			cleanBytes.clear();
 			if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
 				bytesToLoad = SvgFileSplitter::hideText2(bytesToLoad);
 			}
@@ -1418,6 +1471,7 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 		}
 
 		loadInfo.filename = filename;
+		loadInfo.cleanContents = cleanBytes;
 		resultBytes = newRenderer->loadSvg(bytesToLoad, loadInfo);
 	}
 
@@ -2008,7 +2062,7 @@ void ItemBase::collectPropsMap(QString & family, QMap<QString, QString> & propsM
 		QString tempValue = value;
 		QStringList values = collectValues(family, key, tempValue);
 		propsMap.insert(key, tempValue);
-		DebugDialog::debug(QString("props map %1 %2").arg(key).arg(tempValue));
+		DebugDialog::stream() << "props map " << key << " " << tempValue;
 	}
 }
 
@@ -2041,6 +2095,52 @@ const QList<ConnectorItem *> & ItemBase::cachedConnectorItemsConst() const
 void ItemBase::clearConnectorItemCache()
 {
 	m_cachedConnectorItems.clear();
+	delete m_connectorGridIndex;
+	m_connectorGridIndex = nullptr;
+}
+
+bool ItemBase::hasConnectorGrid()
+{
+	return false;
+}
+
+bool ItemBase::connectorItemsAt(QPointF scenePos, QList<ConnectorItem *> & connectorItems)
+{
+	// boards with hundreds of holes answer hit tests from a grid over their connectors
+	// instead of leaving it to the scene; layer kin share the answer of their chief
+	if (!layerKinChief()->hasConnectorGrid()) return false;
+
+	const QList<ConnectorItem *> & items = cachedConnectorItems();
+	if (m_connectorGridIndex == nullptr) {
+		m_connectorGridIndex = new GridIndex;
+	}
+	if (m_connectorGridIndex->count() != items.count()) {
+		QList<QRectF> rects;
+		rects.reserve(items.count());
+		Q_FOREACH (ConnectorItem * connectorItem, items) {
+			rects.append(connectorItem->mapRectToParent(connectorItem->boundingRect()));
+		}
+		m_connectorGridIndex->build(rects);
+	}
+
+	QPointF p = mapFromScene(scenePos);
+	Q_FOREACH (int i, m_connectorGridIndex->indexesAt(p)) {
+		ConnectorItem * connectorItem = items.at(i);
+		if (!connectorItem->isVisible()) continue;
+		if (!connectorItem->contains(connectorItem->mapFromParent(p))) continue;
+
+		connectorItems.append(connectorItem);
+	}
+
+	return true;
+}
+
+const QList<ItemBase *> & ItemBase::connectorGridItems(QGraphicsScene * scene)
+{
+	auto it = ConnectorGridItems.constFind(scene);
+	if (it == ConnectorGridItems.constEnd()) return EmptyList;
+
+	return it.value();
 }
 
 void ItemBase::killRubberBandLeg() {
@@ -2171,56 +2271,56 @@ void ItemBase::getPixmaps(QPixmap * & pixmap1, QPixmap * & pixmap2, QPixmap * &
 
 QPixmap * ItemBase::getPixmap(ViewLayer::ViewID vid, bool swappingEnabled, QSize size)
 {
+	QSvgRenderer * renderer = nullptr;
+	QString filename;
+	if (!getPixmapSource(vid, swappingEnabled, renderer, filename)) return nullptr;
+
+	if (renderer != nullptr) {
+		return FSvgRenderer::getPixmap(renderer, size);
+	}
+
+	QSvgRenderer fileRenderer(filename);
+	return FSvgRenderer::getPixmap(&fileRenderer, size);
+}
+
+bool ItemBase::getPixmapSource(ViewLayer::ViewID vid, bool swappingEnabled, QSvgRenderer * & renderer, QString & filename)
+{
+	// the pixmap for a view comes either from an item instantiated in that view (renderer)
+	// or, when there is none, straight from the part's svg file (filename)
+	renderer = nullptr;
+	filename.clear();
+
 	ItemBase * vItemBase = nullptr;
 
 	if (viewID() == vid) {
-		if (!isEverVisible()) return nullptr;
+		if (!isEverVisible()) return false;
 	}
 	else {
 		vItemBase = modelPart()->viewItem(vid);
-		if ((vItemBase != nullptr) && !vItemBase->isEverVisible()) return nullptr;
+		if ((vItemBase != nullptr) && !vItemBase->isEverVisible()) return false;
 	}
 
 	vid = useViewIDForPixmap(vid, swappingEnabled);
-	if (vid == ViewLayer::UnknownView) return nullptr;
+	if (vid == ViewLayer::UnknownView) return false;
 
 	if (viewID() == vid) {
-		return getPixmap(size);
+		renderer = this->renderer();
+		return true;
 	}
 
 	if (vItemBase != nullptr) {
-		return vItemBase->getPixmap(size);
+		renderer = vItemBase->renderer();
+		return true;
 	}
 
 
-	if (!modelPart()->hasViewFor(vid)) return nullptr;
+	if (!modelPart()->hasViewFor(vid)) return false;
 
 	QString baseName = modelPart()->hasBaseNameFor(vid);
-	if (baseName.isEmpty()) return nullptr;
-
-	QString filename = PartFactory::getSvgFilename(modelPart(), baseName, true, true);
-	if (filename.isEmpty()) {
-		return nullptr;
-	}
+	if (baseName.isEmpty()) return false;
 
-	QSvgRenderer renderer(filename);
-
-	auto * pixmap = new QPixmap(size);
-	pixmap->fill(Qt::transparent);
-	QPainter painter(pixmap);
-	// preserve aspect ratio
-	QSize def = renderer.defaultSize();
-	double newW = size.width();
-	double newH = newW * def.height() / def.width();
-	if (newH > size.height()) {
-		newH = size.height();
-		newW = newH * def.width() / def.height();
-	}
-	QRectF bounds((size.width() - newW) / 2.0, (size.height() - newH) / 2.0, newW, newH);
-	renderer.render(&painter, bounds);
-	painter.end();
-
-	return pixmap;
+	filename = PartFactory::getSvgFilename(modelPart(), baseName, true, true);
+	return !filename.isEmpty();
 }
 
 ViewLayer::ViewID ItemBase::useViewIDForPixmap(ViewLayer::ViewID vid, bool)
@@ -2411,6 +2511,13 @@ void ItemBase::createShape(LayerAttributes & layerAttributes) {
 
 	if (!isEverVisible()) return;
 
+	// copies of one part pasted or loaded together render the same outline
+	QRegion region;
+	if (SvgPreloader::lookupShape(layerAttributes.viewID, layerAttributes.loaded(), region)) {
+		m_selectionShape.addRegion(region);
+		return;
+	}
+
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
@@ -2435,7 +2542,8 @@ void ItemBase::createShape(LayerAttributes & layerAttributes) {
 	image.fill(0xffffffff);
 	renderOne(&doc, &image, sourceRes);
 	QBitmap bitmap = QBitmap::fromImage(image);
-	QRegion region(bitmap);
+	region = QRegion(bitmap);
+	SvgPreloader::insertShape(layerAttributes.viewID, layerAttributes.loaded(), region);
 	m_selectionShape.addRegion(region);
 
 #ifndef QT_NODEBUG
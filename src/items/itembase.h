@@ -52,6 +52,7 @@ class PartLabel;
 class LayerAttributes;
 class Connector;
 class ReferenceModel;
+class GridIndex;
 
 using ConnectorPairHash = QMultiHash<ConnectorItem*, ConnectorItem*>;
 using SkipCheckFunction = bool(ConnectorItem*);
@@ -219,7 +220,11 @@ public:
 	void clearConnectorItemCache();
 	const QList<ConnectorItem *> & cachedConnectorItems();
 	const QList<ConnectorItem *> & cachedConnectorItemsConst() const;
+	virtual bool hasConnectorGrid();
+	bool connectorItemsAt(QPointF scenePos, QList<ConnectorItem *> &);
+	static const QList<ItemBase *> & connectorGridItems(QGraphicsScene *);
 	bool inHover();
+	virtual bool paintsHover();
 	virtual QRectF boundingRectWithoutLegs() const;
 	QRectF boundingRect() const;
 	virtual QPainterPath hoverShape() const;
@@ -234,6 +239,7 @@ public:
 	bool resetRenderer(const QString & svg);
 	bool resetRenderer(const QString & svg, QString & newSvg);
 	void getPixmaps(QPixmap * &, QPixmap * &, QPixmap * &, bool swappingEnabled, QSize);
+	bool getPixmapSource(ViewLayer::ViewID, bool swappingEnabled, QSvgRenderer * & renderer, QString & filename);
 	FSvgRenderer * setUpImage(ModelPart * modelPart, LayerAttributes &);
 	void showConnectors(const QStringList &);
 	void setItemIsSelectable(bool selectable);
@@ -338,6 +344,7 @@ protected:
 	virtual void paintHover(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget, const QPainterPath & shape);
 	virtual void paintSelected(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 	virtual void paintBody(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+	bool paintedFromTiles(QPainter *painter, QWidget *widget);
 
 	QVariant itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant & value);
 
@@ -390,6 +397,7 @@ protected:
 	bool m_moveLock = false;
 	bool m_hasRubberBandLeg = false;
 	QList<ConnectorItem *> m_cachedConnectorItems;
+	GridIndex * m_connectorGridIndex = nullptr;
 	QGraphicsSvgItem * m_moveLockItem = nullptr;
 	QGraphicsSvgItem * m_stickyItem = nullptr;
 	FSvgRenderer * m_fsvgRenderer = nullptr;
@@ -0,0 +1,104 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "levelofdetail.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QSvgRenderer>
+#include <QWidget>
+
+#include <cmath>
+
+const double LevelOfDetail::PixmapBelow = 0.4;
+const double LevelOfDetail::MinPixels = 2;
+const double LevelOfDetail::MinTextPixels = 4;
+const int LevelOfDetail::MaxOctaves = 6;
+const int LevelOfDetail::MaxCost = 32 * 1024;
+
+QCache<QString, QPixmap> LevelOfDetail::Pixmaps(LevelOfDetail::MaxCost);
+
+double LevelOfDetail::of(const QStyleOptionGraphicsItem * option, QPainter * painter, QWidget * widget)
+{
+	if (option == nullptr || widget == nullptr || painter->device() != widget) return 1;
+
+	return option->levelOfDetailFromTransform(painter->worldTransform());
+}
+
+bool LevelOfDetail::tooSmall(const QRectF & rect, double levelOfDetail)
+{
+	return qMax(rect.width(), rect.height()) * levelOfDetail < MinPixels;
+}
+
+bool LevelOfDetail::unreadable(const QRectF & textRect, double levelOfDetail)
+{
+	return textRect.height() * levelOfDetail < MinTextPixels;
+}
+
+bool LevelOfDetail::simplified(double levelOfDetail)
+{
+	return levelOfDetail < PixmapBelow;
+}
+
+QSize LevelOfDetail::pixmapSize(const QRectF & bounds, double levelOfDetail, double devicePixelRatio)
+{
+	// halve the resolution for every halving of the zoom, so that zooming out through one
+	// octave reuses one pixmap, which is never drawn at less than its own size
+	int octave = qBound(0, (int) std::floor(std::log2(PixmapBelow / levelOfDetail)), MaxOctaves);
+	double scale = std::ldexp(PixmapBelow, -octave) * devicePixelRatio;
+	return QSize(qMax(1, (int) std::ceil(bounds.width() * scale)), qMax(1, (int) std::ceil(bounds.height() * scale)));
+}
+
+bool LevelOfDetail::paintPixmap(QPainter * painter, QSvgRenderer * renderer, quint64 contentSerial, const QRectF & bounds, double levelOfDetail)
+{
+	if (!simplified(levelOfDetail) || renderer == nullptr || bounds.isEmpty()) return false;
+
+	double devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1;
+	QSize size = pixmapSize(bounds, levelOfDetail, devicePixelRatio);
+	QString key = QString("%1|%2x%3").arg(contentSerial).arg(size.width()).arg(size.height());
+	QPixmap * pixmap = Pixmaps.object(key);
+	if (pixmap == nullptr) {
+		QImage image(size, QImage::Format_ARGB32_Premultiplied);
+		image.fill(Qt::transparent);
+		QPainter imagePainter(&image);
+		imagePainter.setRenderHint(QPainter::Antialiasing);
+		renderer->render(&imagePainter, QRectF(QPointF(0, 0), size));
+		imagePainter.end();
+
+		pixmap = new QPixmap(QPixmap::fromImage(image));
+		int cost = qMax(1, (int) (image.sizeInBytes() / 1024));
+		if (!Pixmaps.insert(key, pixmap, cost)) {
+			// bigger than the whole cache
+			return false;
+		}
+	}
+
+	painter->save();
+	painter->setRenderHint(QPainter::SmoothPixmapTransform);
+	painter->drawPixmap(bounds, *pixmap, QRectF(pixmap->rect()));
+	painter->restore();
+	return true;
+}
+
+void LevelOfDetail::clear()
+{
+	Pixmaps.clear();
+}
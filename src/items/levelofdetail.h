@@ -0,0 +1,63 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+#include <QCache>
+#include <QPixmap>
+#include <QRectF>
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QSvgRenderer;
+class QWidget;
+
+// How much detail is worth painting at the current zoom.
+//
+// The level of detail is the number of device pixels per scene unit, as reported by
+// QStyleOptionGraphicsItem::levelOfDetailFromTransform; 1 is 100% zoom. Below PixmapBelow a
+// part's svg is drawn from a pixmap rendered once at a matching power-of-two fraction of that
+// scale, and details that would come out smaller than a couple of pixels (connectors, legs,
+// labels, hover highlights) are left out. At or above PixmapBelow everything is rendered exactly.
+// Printing and export always get the full detail, since they don't paint onto the view's widget.
+
+class LevelOfDetail
+{
+public:
+	static double of(const QStyleOptionGraphicsItem *, QPainter *, QWidget *);
+	static bool tooSmall(const QRectF & rect, double levelOfDetail);
+	static bool unreadable(const QRectF & textRect, double levelOfDetail);
+	static bool simplified(double levelOfDetail);
+	static bool paintPixmap(QPainter *, QSvgRenderer *, quint64 contentSerial, const QRectF & bounds, double levelOfDetail);
+	static QSize pixmapSize(const QRectF & bounds, double levelOfDetail, double devicePixelRatio);
+	static void clear();
+
+	static const double PixmapBelow;
+	static const double MinPixels;			// smaller details are skipped
+	static const double MinTextPixels;		// text of a smaller height is skipped
+	static const int MaxOctaves;
+
+protected:
+	static QCache<QString, QPixmap> Pixmaps;	// cost in kilobytes
+	static const int MaxCost;
+};
+
+#endif
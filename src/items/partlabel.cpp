@@ -20,6 +20,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "partlabel.h"
 #include "items/itembase.h"
+#include "items/levelofdetail.h"
 #include "sketch/infographicsview.h"
 #include "model/modelpart.h"
 #include "utils/graphicsutils.h"
@@ -771,6 +772,7 @@ void PartLabel::partLabelEdit()
 void PartLabel::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
 	if (m_hidden) return;
+	if (LevelOfDetail::unreadable(boundingRect(), LevelOfDetail::of(option, painter, widget))) return;
 
 	if (m_inactive) {
 		painter->save();
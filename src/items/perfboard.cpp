@@ -403,6 +403,10 @@ bool Perfboard::canFindConnectorsUnder() {
 	return false;
 }
 
+bool Perfboard::hasConnectorGrid() {
+	return true;
+}
+
 QString Perfboard::getRowLabel() {
 	return tr("rows");
 }
@@ -48,6 +48,7 @@ public:
 	void paintHover(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 	bool stickyEnabled();
 	bool canFindConnectorsUnder();
+	bool hasConnectorGrid();
 	bool rotation45Allowed();
 	virtual bool allowSwapReconnectByDescription();
 
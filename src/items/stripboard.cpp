@@ -484,41 +484,52 @@ QString Stripboard::genModuleID(QMap<QString, QString> & currPropsMap)
 
 void Stripboard::initCutting(Stripbit *)
 {
-	m_beforeCut.clear();
-	Q_FOREACH (QGraphicsItem * item, childItems()) {
-		auto * stripbit = dynamic_cast<Stripbit *>(item);
-		if (stripbit == nullptr) continue;
+	Q_FOREACH (StripConnector * sc, m_strips) {
+		if (sc->right != nullptr) sc->right->setChanged(false);
+		if (sc->down != nullptr) sc->down->setChanged(false);
+	}
+	m_beforeCut = collectStrips(true, true, true);
+}
 
-		stripbit->setChanged(false);
-		if (stripbit->removed()) {
-			m_beforeCut += stripbit->makeRemovedString();
-		}
+static int findBusRoot(QVector<int> & parent, int i) {
+	// iterative with path halving, so long strips cannot overflow the stack
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
 	}
+	return i;
 }
 
-void appendConnectors(QList<ConnectorItem *> & connectorItems, ConnectorItem * connectorItem) {
-	if (connectorItem == nullptr) return;
+static void uniteBuses(QVector<int> & parent, int a, int b) {
+	a = findBusRoot(parent, a);
+	b = findBusRoot(parent, b);
+	if (a == b) return;
+
+	// keep the lower index as root so roots are stable from pass to pass
+	if (a < b) parent[b] = a;
+	else parent[a] = b;
+}
 
-	Q_FOREACH (ConnectorItem * ci, connectorItem->connectedToItems()) {
-		connectorItems.append(ci);
+QString Stripboard::collectStrips(bool horizontal, bool vertical, bool removedOnly) {
+	QString strips;
+	Q_FOREACH (StripConnector * sc, m_strips) {
+		if (horizontal && (sc->right != nullptr) && (!removedOnly || sc->right->removed())) {
+			strips += sc->right->makeRemovedString();
+		}
+		if (vertical && (sc->down != nullptr) && (!removedOnly || sc->down->removed())) {
+			strips += sc->down->makeRemovedString();
+		}
 	}
+	return strips;
 }
 
 void Stripboard::reinitBuses(bool triggerUndo)
 {
 	if (triggerUndo) {
-		QString afterCut;
+		QString afterCut = collectStrips(true, true, true);
 		QSet<ConnectorItem *> affectedConnectors;
 		int changeCount = 0;
 		bool connect = true;
-		Q_FOREACH (QGraphicsItem * item, childItems()) {
-			auto * stripbit = dynamic_cast<Stripbit *>(item);
-			if (stripbit == nullptr) continue;
-
-			if (stripbit->removed()) {
-				afterCut += stripbit->makeRemovedString();
-			}
-		}
 
 		collectTo(affectedConnectors);
 
@@ -534,110 +545,125 @@ void Stripboard::reinitBuses(bool triggerUndo)
 	}
 	if (viewID() != ViewLayer::BreadboardView) return;
 
-	Q_FOREACH (BusShared * busShared, m_buses) delete busShared;
-	m_buses.clear();
+	int count = m_x * m_y;
+	if (m_strips.count() != count) return;
 
-	Q_FOREACH (QGraphicsItem * item, childItems()) {
-		auto * stripbit = dynamic_cast<Stripbit *>(item);
-		if (stripbit == nullptr) {
-			auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
-			if (connectorItem == nullptr) continue;
+	// union-find over the flat cell array: cell i = (iy * m_x) + ix
+	QVector<int> parent(count);
+	for (int i = 0; i < count; i++) parent[i] = i;
+	for (int i = 0; i < count; i++) {
+		StripConnector * sc = m_strips.at(i);
+		if ((sc->right != nullptr) && !sc->right->removed()) uniteBuses(parent, i, i + 1);
+		if ((sc->down != nullptr) && !sc->down->removed()) uniteBuses(parent, i, i + m_x);
+	}
 
-			connectorItem->connector()->connectorShared()->setBus(nullptr);
-			connectorItem->connector()->setBus(nullptr);
-			continue;
+	// a component keeps its bus if it holds exactly the cells of one existing bus
+	if (m_cellBus.count() != count) {
+		m_cellBus.fill(UnknownBus, count);
+	}
+	QVector<int> root(count);
+	QVector<int> size(count, 0);
+	QVector<int> oldBus(count, UnknownBus);
+	QVector<bool> consistent(count, true);
+	for (int i = 0; i < count; i++) {
+		int r = root[i] = findBusRoot(parent, i);
+		if (size[r]++ == 0) {
+			oldBus[r] = m_cellBus.at(i);
+		}
+		else if (oldBus[r] != m_cellBus.at(i)) {
+			consistent[r] = false;
 		}
-
 	}
 
-	QString busPropertyString;
-	Q_FOREACH (QGraphicsItem * item, childItems()) {
-		auto * stripbit = dynamic_cast<Stripbit *>(item);
-		if (stripbit == nullptr) continue;
+	QVector<bool> keep(count, false);
+	QVector<bool> busKept(m_buses.count(), false);
+	for (int i = 0; i < count; i++) {
+		if (root[i] != i || !consistent[i]) continue;
 
-		if (stripbit->removed()) {
-			busPropertyString += stripbit->makeRemovedString();
+		int b = oldBus[i];
+		if (size[i] == 1) {
+			keep[i] = (b == NoBus);
 		}
-	}
-
-	QList<ConnectorItem *> visited;
-	for (int iy = 0; iy < m_y; iy++) {
-		for (int ix = 0; ix < m_x; ix++) {
-			StripConnector * sc = getStripConnector(ix, iy);
-			if (visited.contains(sc->connectorItem)) continue;
-
-			QList<ConnectorItem *> connected;
-			collectConnected(ix, iy, connected);
-			visited.append(connected);
-			nextBus(connected);
+		else if (b >= 0 && m_buses.at(b)->connectors().count() == size[i]) {
+			keep[i] = busKept[b] = true;
 		}
 	}
 
-	modelPart()->clearBuses();
-	modelPart()->initBuses();
-	modelPart()->setLocalProp("buses",  busPropertyString);
+	for (int b = 0; b < m_buses.count(); b++) {
+		if (m_buses.at(b) == nullptr || busKept.at(b)) continue;
 
-
-
-	QList<ConnectorItem *> visited2;
-	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
-		connectorItem->restoreColor(visited2);
+		delete m_buses.at(b);
+		m_buses[b] = nullptr;
 	}
 
-	update();
-}
-
-void Stripboard::collectConnected(int ix, int iy, QList<ConnectorItem *> & connected) {
-	StripConnector * sc = getStripConnector(ix, iy);
-	if (connected.contains(sc->connectorItem)) return;
+	QVector<int> newBus(count, NoBus);
+	QList<ConnectorItem *> affected;
+	int freeSlot = 0;
+	for (int i = 0; i < count; i++) {
+		ConnectorItem * connectorItem = m_strips.at(i)->connectorItem;
+		if (connectorItem == nullptr) continue;
+
+		int r = root[i];
+		ConnectorShared * connectorShared = connectorItem->connector()->connectorShared();
+		if (keep[r]) {
+			// connector shareds are shared with other stripboards of the same size, so reassert ours
+			connectorShared->setBus(m_cellBus.at(i) == NoBus ? nullptr : m_buses.at(m_cellBus.at(i)));
+			continue;
+		}
 
-	connected << sc->connectorItem;
+		affected.append(connectorItem);
+		connectorItem->connector()->setBus(nullptr);
+		if (size[r] == 1) {
+			connectorShared->setBus(nullptr);
+			m_cellBus[i] = NoBus;
+			continue;
+		}
 
-	if ((sc->right != nullptr) && !sc->right->removed()) {
-		collectConnected(ix + 1, iy, connected);
+		if (newBus[r] == NoBus) {
+			while (freeSlot < m_buses.count() && m_buses.at(freeSlot) != nullptr) freeSlot++;
+			auto * busShared = new BusShared(QString::number(m_nextBusID++));
+			if (freeSlot == m_buses.count()) {
+				m_buses.append(busShared);
+			}
+			else {
+				m_buses[freeSlot] = busShared;
+			}
+			newBus[r] = freeSlot;
+		}
 
-	}
-	if ((sc->down != nullptr) && !sc->down->removed()) {
-		collectConnected(ix, iy + 1, connected);
+		BusShared * busShared = m_buses.at(newBus[r]);
+		busShared->addConnectorShared(connectorShared);
+		connectorShared->setBus(busShared);
+		m_cellBus[i] = newBus[r];
 	}
 
-	StripConnector * left = ix > 0 ? getStripConnector(ix - 1, iy) : nullptr;
-	if ((left != nullptr) && (left->right != nullptr) && !left->right->removed()) {
-		collectConnected(ix - 1, iy, connected);
-	}
+	modelPart()->clearBuses();
+	modelPart()->initBuses();
+	modelPart()->setLocalProp("buses", collectStrips(true, true, true));
 
-	StripConnector * up = iy > 0 ? getStripConnector(ix, iy - 1) : nullptr;
-	if ((up != nullptr) && (up->down != nullptr) && !up->down->removed()) {
-		collectConnected(ix, iy - 1, connected);
-	}
-}
+	if (affected.isEmpty()) return;
 
-void Stripboard::nextBus(QList<ConnectorItem *> & soFar)
-{
-	if (soFar.count() > 1) {
-		auto * busShared = new BusShared(QString::number(m_buses.count()));
-		m_buses.append(busShared);
-		Q_FOREACH (ConnectorItem * connectorItem, soFar) {
-			busShared->addConnectorShared(connectorItem->connector()->connectorShared());
-		}
+	// only connectors whose bus changed need new colors
+	QList<ConnectorItem *> visited;
+	Q_FOREACH (ConnectorItem * connectorItem, affected) {
+		connectorItem->restoreColor(visited);
 	}
-	soFar.clear();
+
+	update();
 }
 
 void Stripboard::setProp(const QString & prop, const QString & value)
 {
 	if (prop.compare("buses") == 0) {
-		QStringList removed = value.split(" ", Qt::SkipEmptyParts);
-		Q_FOREACH (QGraphicsItem * item, childItems()) {
-			auto * stripbit = dynamic_cast<Stripbit *>(item);
-			if (stripbit == nullptr) continue;
-
-			QString removedString = stripbit->makeRemovedString();
-			removedString.chop(1);          // remove trailing space
-			bool remove = removed.contains(removedString);
-			stripbit->setRemoved(remove);
-			if (remove) {
-				removed.removeOne(removedString);
+		QStringList removedList = value.split(" ", Qt::SkipEmptyParts);
+		QSet<QString> removed(removedList.begin(), removedList.end());
+		Q_FOREACH (StripConnector * sc, m_strips) {
+			for (Stripbit * stripbit : {sc->right, sc->down}) {
+				if (stripbit == nullptr) continue;
+
+				QString removedString = stripbit->makeRemovedString();
+				removedString.chop(1);          // remove trailing space
+				stripbit->setRemoved(removed.contains(removedString));
 			}
 		}
 
@@ -751,32 +777,13 @@ void Stripboard::swapEntry(const QString & text) {
 
 		QString afterCut;
 		if (text.compare(HorizontalString, Qt::CaseInsensitive) == 0) {
-			Q_FOREACH (QGraphicsItem * item, childItems()) {
-				auto * stripbit = dynamic_cast<Stripbit *>(item);
-				if (stripbit == nullptr) continue;
-
-				if (!stripbit->horizontal()) {
-					afterCut += stripbit->makeRemovedString();
-				}
-			}
+			afterCut = collectStrips(false, true, false);
 		}
 		else if (text.compare(VerticalString, Qt::CaseInsensitive) == 0) {
-			Q_FOREACH (QGraphicsItem * item, childItems()) {
-				auto * stripbit = dynamic_cast<Stripbit *>(item);
-				if (stripbit == nullptr) continue;
-
-				if (stripbit->horizontal()) {
-					afterCut += stripbit->makeRemovedString();
-				}
-			}
+			afterCut = collectStrips(true, false, false);
 		}
 		else if (text.compare(EmptyString, Qt::CaseInsensitive) == 0) {
-			Q_FOREACH (QGraphicsItem * item, childItems()) {
-				auto * stripbit = dynamic_cast<Stripbit *>(item);
-				if (stripbit == nullptr) continue;
-
-				afterCut += stripbit->makeRemovedString();
-			}
+			afterCut = collectStrips(true, true, false);
 		}
 		else {
 			for (int i = 0; i < StripLayouts.count(); i++) {
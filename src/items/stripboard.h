@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QRectF>
 #include <QPainterPath>
 #include <QGraphicsPathItem>
+#include <QVector>
 
 #include "perfboard.h"
 
@@ -92,23 +93,28 @@ protected Q_SLOTS:
 	void changeBoardSize();
 
 protected:
-	void nextBus(QList<ConnectorItem *> & soFar);
+	QString collectStrips(bool horizontal, bool vertical, bool removedOnly);
 	QString getRowLabel();
 	QString getColumnLabel();
 	void makeInitialPath();
-	void collectConnected(int x, int y, QList<ConnectorItem *> & connected);
 	StripConnector * getStripConnector(int x, int y);
 	void collectTo(QSet<ConnectorItem *> &);
 	void initStripLayouts();
 	QString getNewBuses(bool vertical);
 
+protected:
+	static constexpr int NoBus = -1;
+	static constexpr int UnknownBus = -2;
+
 public:
 	static QString genFZP(const QString & moduleID);
 	static QString genModuleID(QMap<QString, QString> & currPropsMap);
 
 protected:
 	QList<StripConnector *> m_strips;
-	QList<class BusShared *> m_buses;
+	QList<class BusShared *> m_buses;			// indexed by m_cellBus; freed slots are nullptr
+	QVector<int> m_cellBus;						// bus index per cell, (iy * m_x) + ix
+	int m_nextBusID = 0;
 	QString m_beforeCut;
 	int m_x = 0;
 	int m_y = 0;
@@ -256,6 +256,7 @@ void Wire::initEnds(const ViewGeometry & vg, QRectF defaultRect, InfoGraphicsVie
 	}
 
 	prepareGeometryChange();
+	invalidateShapeCache();
 }
 
 void Wire::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget ) {
@@ -409,12 +410,27 @@ QString Wire::makeWireSVGLine(double width, const QString & color, QPointF offse
 
 QPainterPath Wire::hoverShape() const
 {
-	return shapeAux(m_hoverStrokeWidth);
+	if (!m_cachedHoverShapeValid) {
+		m_cachedHoverShape = shapeAux(m_hoverStrokeWidth);
+		m_cachedHoverShapeValid = true;
+	}
+	return m_cachedHoverShape;
 }
 
 QPainterPath Wire::shape() const
 {
-	return shapeAux(m_pen.widthF());
+	if (!m_cachedShapeValid) {
+		m_cachedShape = shapeAux(m_pen.widthF());
+		m_cachedShapeValid = true;
+	}
+	return m_cachedShape;
+}
+
+void Wire::invalidateShapeCache()
+{
+	m_cachedShapeValid = false;
+	m_cachedHoverShapeValid = false;
+	m_cachedBoundingRectValid = false;
 }
 
 QPainterPath Wire::shapeAux(double width) const
@@ -437,6 +453,10 @@ QPainterPath Wire::shapeAux(double width) const
 
 QRectF Wire::boundingRect() const
 {
+	if (m_cachedBoundingRectValid) {
+		return m_cachedBoundingRect;
+	}
+
 	if (m_pen.widthF() == 0.0) {
 		const double x1 = m_line.p1().x();
 		const double x2 = m_line.p2().x();
@@ -446,9 +466,13 @@ QRectF Wire::boundingRect() const
 		double rx = qMax(x1, x2);
 		double ty = qMin(y1, y2);
 		double by = qMax(y1, y2);
-		return QRectF(lx, ty, rx - lx, by - ty);
+		m_cachedBoundingRect = QRectF(lx, ty, rx - lx, by - ty);
 	}
-	return hoverShape().controlPointRect();
+	else {
+		m_cachedBoundingRect = hoverShape().controlPointRect();
+	}
+	m_cachedBoundingRectValid = true;
+	return m_cachedBoundingRect;
 }
 
 void Wire::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) {
@@ -483,12 +507,14 @@ void Wire::initDragCurve(QPointF scenePos) {
 
 	QPointF p0 = connector0()->sceneAdjustedTerminalPoint(nullptr);
 	QPointF p1 = connector1()->sceneAdjustedTerminalPoint(nullptr);
+	prepareGeometryChange();
 	if (m_bezier->isEmpty()) {
 		m_bezier->initToEnds(mapFromScene(p0), mapFromScene(p1));
 	}
 	else {
 		m_bezier->set_endpoints(mapFromScene(p0), mapFromScene(p1));
 	}
+	invalidateShapeCache();
 
 	m_bezier->initControlIndex(mapFromScene(scenePos), m_pen.widthF());
 	TheBezierDisplay = new BezierDisplay;
@@ -563,6 +589,7 @@ void Wire::mouseMoveEventAux(QPointF eventPos, Qt::KeyboardModifiers modifiers)
 	if (m_dragCurve) {
 		prepareGeometryChange();
 		dragCurve(eventPos, modifiers);
+		invalidateShapeCache();
 		update();
 		if (TheBezierDisplay != nullptr) TheBezierDisplay->updateDisplay(this, m_bezier);
 		return;
@@ -734,7 +761,7 @@ void Wire::mouseMoveEventAux(QPointF eventPos, Qt::KeyboardModifiers modifiers)
 	else {
 		// dragging a bendpoint
 		DebugDialog::debug("dragging a bendpoint");
-		DebugDialog::debug(QString("CON0 %1 CON1 %2").arg(this->connector0()->connectedToItems().count()).arg(this->connector0()->connectedToItems().count()));
+		DebugDialog::stream() << "CON0 " << this->connector0()->connectedToItems().count() << " CON1 " << this->connector0()->connectedToItems().count();
 		Q_FOREACH (ConnectorItem * toConnectorItem, allTo) {
 			Wire * chained = qobject_cast<Wire *>(toConnectorItem->attachedTo());
 			if (chained != nullptr) {
@@ -886,6 +913,7 @@ void Wire::setExtras(QDomElement & element, InfoGraphicsView * infoGraphicsView)
 		QPointF p0 = connector0()->sceneAdjustedTerminalPoint(nullptr);
 		QPointF p1 = connector1()->sceneAdjustedTerminalPoint(nullptr);
 		m_bezier->set_endpoints(mapFromScene(p0), mapFromScene(p1));
+		invalidateShapeCache();
 	}
 
 }
@@ -1253,6 +1281,7 @@ void Wire::setWireWidth(double width, InfoGraphicsView * infoGraphicsView, doubl
 
 	prepareGeometryChange();
 	setPenWidth(width, infoGraphicsView, hoverStrokeWidth);
+	invalidateShapeCache();
 	QList<ConnectorItem *> visited;
 	if (m_connector0 != nullptr) m_connector0->restoreColor(visited);
 	if (m_connector1 != nullptr) m_connector1->restoreColor(visited);
@@ -1616,6 +1645,7 @@ void Wire::setPenWidth(double w, InfoGraphicsView * infoGraphicsView, double hov
 	m_hoverStrokeWidth = hoverStrokeWidth;
 	//DebugDialog::debug(QString("setting hoverstrokewidth %1 %2").arg(m_id).arg(m_hoverStrokeWidth));
 	m_pen.setWidthF(w);
+	invalidateShapeCache();
 	infoGraphicsView->getBendpointWidths(this, w, m_bendpointWidth, m_bendpoint2Width, m_negativeOffsetRect);
 	m_bendpointPen.setWidthF(qAbs(m_bendpointWidth));
 	m_bendpoint2Pen.setWidthF(qAbs(m_bendpoint2Width));
@@ -1834,6 +1864,7 @@ void Wire::setLine(const QLineF &line)
 		return;
 	prepareGeometryChange();
 	m_line = line;
+	invalidateShapeCache();
 	update();
 }
 
@@ -1865,6 +1896,7 @@ void Wire::setPen(const QPen &pen)
 		prepareGeometryChange();
 	}
 	m_pen = pen;
+	invalidateShapeCache();
 	update();
 }
 
@@ -1882,6 +1914,7 @@ void Wire::changeCurve(const Bezier * bezier)
 	prepareGeometryChange();
 	if (m_bezier == nullptr) m_bezier = new Bezier;
 	m_bezier->copy(bezier);
+	invalidateShapeCache();
 	update();
 }
 
@@ -210,6 +210,7 @@ protected:
 	void setConnectorDimensionsAux(ConnectorItem *, double width, double height);
 	bool isBendpoint(ConnectorItem * connectorItem);
 	QPainterPath shapeAux(double width) const;
+	void invalidateShapeCache();
 	void hoverLeaveEvent( QGraphicsSceneHoverEvent * event );
 	void hoverEnterEvent( QGraphicsSceneHoverEvent * event );
 	void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
@@ -257,6 +258,14 @@ protected:
 	bool m_banded;
 	bool m_colorByLength;
 
+	// stroking the path is expensive and the scene asks for these constantly
+	mutable QPainterPath m_cachedShape;
+	mutable QPainterPath m_cachedHoverShape;
+	mutable QRectF m_cachedBoundingRect;
+	mutable bool m_cachedShapeValid = false;
+	mutable bool m_cachedHoverShapeValid = false;
+	mutable bool m_cachedBoundingRectValid = false;
+
 public:
 	static QStringList colorNames;
 	static QHash<QString, QString> colorTrans;
@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QtDebug>
 
 #include "fapplication.h"
+#include "debugdialog.h"
 #include "version/version.h"
 #include "utils/folderutils.h"
 
@@ -52,6 +53,10 @@ void writeCrashMessage(const QString & msg) {
 
 void fMessageHandler(QtMsgType type, const QMessageLogContext & context, const QString & msg)
 {
+	if (type == QtFatalMsg || type == QtCriticalMsg) {
+		// get the queued debug.txt lines on disk before a possible abort
+		DebugDialog::flush();
+	}
 	if (type == QtFatalMsg) {
 		writeCrashMessage(msg);
 	}
@@ -65,8 +70,9 @@ int main(int argc, char *argv[])
 #define WIN_CHECK_LEAKS
 #endif
 
-#ifdef Q_OS_WIN
 	originalMsgHandler = qInstallMessageHandler(fMessageHandler);
+
+#ifdef Q_OS_WIN
 #ifndef QT_NO_DEBUG
 #ifdef WIN_CHECK_LEAKS
 	HANDLE hLogFile;
@@ -141,6 +147,8 @@ int main(int argc, char *argv[])
 			     "  -db, -database FILE           rebuild the internal parts database FILE\n"
 			     "\n"
 			     "Developer options:\n"
+			     "  -benchmark FOLDER             load, zoom and pan, save, DRC check, Gerber export and autoroute all sketches in FOLDER,\n"
+			     "                                writing timings to FOLDER/benchmark-results.json\n"
 			     "  -e, -examples FOLDER          prepare all sketches in FOLDER to be included as examples\n"
 			     "  -ep FILE                      add menu item for external process using executable FILE\n"
 			     "  -eparg ARGS                   with -ep, external process arguments ARGS\n"
@@ -173,9 +181,11 @@ int main(int argc, char *argv[])
 		delete app;
 	}
 	catch (char const *str) {
+		DebugDialog::flush();
 		writeCrashMessage(str);
 	}
 	catch (...) {
+		DebugDialog::flush();
 		result = -1;
 	}
 
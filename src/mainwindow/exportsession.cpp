@@ -0,0 +1,82 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "exportsession.h"
+#include "mainwindow.h"
+#include "../debugdialog.h"
+
+const int ExportSession::DefaultRecycleAfter = 50;
+
+ExportSession::ExportSession(ReferenceModel * referenceModel, int initialTab, int recycleAfter)
+	: m_referenceModel(referenceModel)
+	, m_initialTab(initialTab)
+	, m_recycleAfter(recycleAfter)
+{
+}
+
+ExportSession::~ExportSession()
+{
+	closeWindow();
+}
+
+MainWindow * ExportSession::openWindow(ReferenceModel * referenceModel, bool lockFiles, int initialTab)
+{
+	// our MainWindows use WA_DeleteOnClose so this has to be added to the heap (via new) rather than the stack (for local vars)
+	MainWindow * mainWindow = MainWindow::newMainWindow(referenceModel, "", false, lockFiles, initialTab);   // this is also slow
+	mainWindow->setReportMissingModules(false);
+	mainWindow->noBackup();
+	mainWindow->noSchematicConversion();
+
+	return mainWindow;
+}
+
+MainWindow * ExportSession::load(const QString & filepath)
+{
+	if (m_mainWindow != nullptr && m_loadCount >= m_recycleAfter) {
+		closeWindow();
+	}
+
+	if (m_mainWindow == nullptr) {
+		m_mainWindow = openWindow(m_referenceModel, false, m_initialTab);
+		m_loadCount = 0;
+	}
+	else {
+		m_mainWindow->clearSketch();
+	}
+
+	m_loadCount++;
+	if (m_mainWindow->loadWhich(filepath, false, false, false, "")) {
+		return m_mainWindow;
+	}
+
+	// don't trust whatever a failed load left behind
+	DebugDialog::debug(QString("ExportSession: failed to load file: %1").arg(filepath));
+	closeWindow();
+	return nullptr;
+}
+
+void ExportSession::closeWindow()
+{
+	if (m_mainWindow == nullptr) return;
+
+	m_mainWindow->setCloseSilently(true);
+	m_mainWindow->close();
+	m_mainWindow = nullptr;
+}
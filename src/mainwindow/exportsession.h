@@ -0,0 +1,59 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef EXPORTSESSION_H
+#define EXPORTSESSION_H
+
+#include <QPointer>
+#include <QString>
+
+class MainWindow;
+class ReferenceModel;
+
+// Loads sketch after sketch into one service window for the command line export services,
+// clearing it in between instead of building and tearing down a MainWindow per file.
+// The window is replaced after a failed load, and every RecycleAfter sketches to bound
+// whatever per-sketch state clearing does not reach.
+
+class ExportSession
+{
+public:
+	ExportSession(ReferenceModel *, int initialTab, int recycleAfter = DefaultRecycleAfter);
+	~ExportSession();
+
+	MainWindow * load(const QString & filepath);	// returns nullptr if the sketch could not be loaded
+
+public:
+	static MainWindow * openWindow(ReferenceModel *, bool lockFiles, int initialTab);
+
+	static const int DefaultRecycleAfter;
+
+protected:
+	void closeWindow();
+
+protected:
+	ReferenceModel * m_referenceModel = nullptr;
+	int m_initialTab = -1;
+	int m_recycleAfter = DefaultRecycleAfter;
+	int m_loadCount = 0;
+	QPointer<MainWindow> m_mainWindow;
+};
+
+#endif
@@ -3481,6 +3481,46 @@ void MainWindow::noSchematicConversion() {
 	m_noSchematicConversion = true;
 }
 
+void MainWindow::clearSketch() {
+	// brings a service window back to the state of a freshly opened one, so the next sketch can be loaded
+	// without rebuilding the views, docks and bins; the temp parts bin and program tabs are not reset
+	m_undoStack->clear();
+
+	// loadedViewsSlot only sets what a sketch has attributes for, so each view also goes back to its
+	// defaults for background, grid, view from below, wire coloring and autorouter settings
+	Q_FOREACH (SketchWidget * sketchWidget, sketchWidgets()) {
+		sketchWidget->clearSketch();
+	}
+
+	ModelPart * root = m_sketchModel->root();
+	for (int i = root->children().count() - 1; i >= 0; i--) {
+		QObject * child = root->children()[i];
+		child->setParent(nullptr);
+		delete child;
+	}
+
+	Q_FOREACH (LinkedFile * linkedFile, m_linkedProgramFiles) {
+		delete linkedFile;
+	}
+	m_linkedProgramFiles.clear();
+
+	m_projectProperties = QSharedPointer<ProjectProperties>(new ProjectProperties());
+	m_addedToTemp = m_useOldSchematic = m_convertedSchematic = m_obsoleteSMDOrientation = false;
+
+	// loadBundledSketch picks the first .fz it finds, so the previous sketch's files must go
+	if (m_fzzFolder.isEmpty()) return;
+
+	QDir dir(m_fzzFolder);
+	Q_FOREACH (QFileInfo fileInfo, dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden)) {
+		if (fileInfo.isDir()) {
+			FolderUtils::rmdir(fileInfo.absoluteFilePath());
+		}
+		else if (fileInfo.fileName() != LockManager::LockedFileName) {
+			QFile::remove(fileInfo.absoluteFilePath());
+		}
+	}
+}
+
 void MainWindow::setInitialTab(int tab) {
 	m_initialTab = tab;
 }
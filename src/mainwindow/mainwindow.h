@@ -217,6 +217,7 @@ public:
 	QStringList newDesignRulesCheck(bool showOkMessage);
 	void setInitialTab(int);
 	void noSchematicConversion();
+	void clearSketch();
 	QString getExportBOM_CSV();
 	QString getSpiceNetlist(QString, QList< QList<class ConnectorItem *>* >&, QSet<class ItemBase *>& );
 	bool isSimulatorEnabled();
@@ -271,6 +272,8 @@ public Q_SLOTS:
 
 protected Q_SLOTS:
 	void mainLoad();
+	void undo();
+	void redo();
 	void revert();
 	void openRecentOrExampleFile();
 	void openRecentOrExampleFile(const QString & filename, const QString & actionText);
@@ -992,6 +995,7 @@ public:
 	static const int DockMinHeight;
 
 	QString exportIPC_D_356A();
+	bool exportIPC_D_356A(class QIODevice &);
 protected:
 	static const QString UntitledSketchName;
 	static int UntitledSketchIndex;
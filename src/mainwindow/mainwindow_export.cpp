@@ -51,6 +51,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "utils/graphicsutils.h"
 #include "utils/textutils.h"
 #include "utils/fmessagebox.h"
+#include "utils/FTimingProbe.h"
 #include "version/version.h"
 
 
@@ -125,6 +126,7 @@ void MainWindow::initNames()
 	QSettings settings;
 	AutosaveEnabled = settings.value("autosaveEnabled", QString("%1").arg(AutosaveEnabled)).toBool();
 	AutosaveTimeoutMinutes = settings.value("autosavePeriod", QString("%1").arg(AutosaveTimeoutMinutes)).toInt();
+	WaitPushUndoStack::setMemoryBudget(settings.value("undoMemoryBudget", QString("%1").arg(WaitPushUndoStack::memoryBudget())).toInt());
 }
 
 void MainWindow::print() {
@@ -770,6 +772,7 @@ void MainWindow::afterExport(bool removeBackground)
 
 
 bool MainWindow::saveAsAux(const QString & fileName) {
+	FTimingScope timingScope("save");
 	QFileInfo fileInfo(fileName);
 
 	if (fileInfo.exists()) {
@@ -1622,8 +1625,16 @@ QString MainWindow::getSpiceNetlist(QString simulationName, QList< QList<class C
 }
 
 QString MainWindow::exportIPC_D_356A() {
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	exportIPC_D_356A(buffer);
+	return QString::fromUtf8(buffer.data());
+}
+
+bool MainWindow::exportIPC_D_356A(QIODevice & device) {
 	int boardCount;
 	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
+	if (board == nullptr) return false;
 
 	QString basename = QFileInfo(m_fwFilename).fileName();
 
@@ -1634,8 +1645,7 @@ QString MainWindow::exportIPC_D_356A() {
 	QList< QList<ConnectorItem *>* > netList;
 	this->m_pcbGraphicsView->collectAllNets(indexer, netList, true, m_pcbGraphicsView->boardLayers() > 1, false, skipFlags, skipBuses);
 
-	QString ipc = getExportIPC_D_356A(board, basename, netList);
-	return ipc;
+	return ::exportIPC_D_356A(device, board, basename, netList);
 }
 
 void MainWindow::exportIPC_D_356A_interactive() {
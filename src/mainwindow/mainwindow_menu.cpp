@@ -51,6 +51,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../infoview/htmlinfoview.h"
 #include "../utils/bendpointaction.h"
 #include "../sketch/fgraphicsscene.h"
+#include "../sketch/localclipboard.h"
 #include "../utils/fmessagebox.h"
 #include "../utils/fileprogressdialog.h"
 #include "../help/tipsandtricks.h"
@@ -59,8 +60,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/folderutils.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/textutils.h"
+#include "../svg/svgpreloader.h"
 #include "../items/moduleidnames.h"
 #include "../utils/zoomslider.h"
+#include "../utils/FTimingProbe.h"
 #include "../dock/layerpalette.h"
 #include "../program/programwindow.h"
 #include "../utils/autoclosemessagebox.h"
@@ -351,6 +354,7 @@ bool MainWindow::loadWhich(const QString & fileName, bool setAsLastOpened, bool
 }
 
 bool MainWindow::mainLoad(const QString & fileName, const QString & displayName, bool checkObsolete) {
+	FTimingScope timingScope("load");
 
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setMaximum(200);
@@ -406,6 +410,17 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	disconnect(m_sketchModel, SIGNAL(obsoleteSMDOrientationSignal()),
 	           this, SLOT(obsoleteSMDOrientationSlot()));
 
+	ProcessEventBlocker::processEvents();
+	if (m_fileProgressDialog) {
+		m_fileProgressDialog->setValue(150);
+		m_fileProgressDialog->setMessage(tr("loading %1 (images)").arg(displayName2));
+	}
+
+	// read and clean up the svgs for all three views in parallel; the views below then only build the scenes
+	QList<ViewLayer::ViewID> preloadViews;
+	preloadViews << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+	SvgPreloader::preload(modelParts, preloadViews);
+
 	ProcessEventBlocker::processEvents();
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setValue(155);
@@ -437,6 +452,8 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
 	m_schematicGraphicsView->setConvertSchematic(false);
 
+	SvgPreloader::clear();
+
 	if (m_sketchModel->checkForReversedWires()) {
 		m_pcbGraphicsView->checkForReversedWires();
 		m_schematicGraphicsView->checkForReversedWires();
@@ -495,6 +512,16 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	return result;
 }
 
+void MainWindow::undo() {
+	CommandBatch batch;
+	m_undoGroup->undo();
+}
+
+void MainWindow::redo() {
+	CommandBatch batch;
+	m_undoGroup->redo();
+}
+
 void MainWindow::copy() {
 	if (m_currentGraphicsView == nullptr) return;
 	m_currentGraphicsView->copy();
@@ -528,10 +555,19 @@ void MainWindow::pasteAux(bool pasteInPlace)
 
 	if (!mimeData->hasFormat("application/x-dnditemsdata")) return;
 
-	QByteArray itemData = mimeData->data("application/x-dnditemsdata");
 	QList<ModelPart *> modelParts;
 	QHash<QString, QRectF> boundingRects;
-	if (m_sketchModel->paste(m_referenceModel, itemData, modelParts, boundingRects, false)) {
+	bool pasted = false;
+	QDomDocument snapshot;
+	if (LocalClipboard::get(mimeData, snapshot)) {
+		// copied in this process: reuse the parsed document instead of the xml
+		pasted = m_sketchModel->paste(m_referenceModel, snapshot, modelParts, boundingRects, false);
+	}
+	else {
+		QByteArray itemData = mimeData->data("application/x-dnditemsdata");
+		pasted = m_sketchModel->paste(m_referenceModel, itemData, modelParts, boundingRects, false);
+	}
+	if (pasted) {
 		auto * parentCommand = new QUndoCommand("Paste"); // if you translate "Paste", you must also do so for the check in sketchwidget.cpp.
 
 		QList<SketchWidget *> sketchWidgets;
@@ -539,6 +575,11 @@ void MainWindow::pasteAux(bool pasteInPlace)
 		sketchWidgets.removeOne(m_currentGraphicsView);
 		sketchWidgets.prepend(m_currentGraphicsView);
 
+		// many copies of one part: read and clean its svgs once, not once per copy
+		QList<ViewLayer::ViewID> preloadViews;
+		preloadViews << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+		SvgPreloader::preload(modelParts, preloadViews);
+
 		QList<long> newIDs;
 		Q_FOREACH (SketchWidget * sketchWidget, sketchWidgets) {
 			newIDs.clear();
@@ -562,6 +603,8 @@ void MainWindow::pasteAux(bool pasteInPlace)
 		m_breadboardGraphicsView->setPasting(false);
 		m_pcbGraphicsView->setPasting(false);
 		m_schematicGraphicsView->setPasting(false);
+
+		SvgPreloader::clear();
 	}
 
 	m_currentGraphicsView->updateInfoView();
@@ -873,13 +916,18 @@ void MainWindow::updateRecentFileActions() {
 }
 
 void MainWindow::createEditMenuActions() {
+	// keep the group's enabling and text updates, but undo and redo inside a CommandBatch
 	m_undoAct = m_undoGroup->createUndoAction(this, tr("Undo"));
 	m_undoAct->setShortcuts(QKeySequence::Undo);
 	m_undoAct->setText(tr("Undo"));
+	disconnect(m_undoAct, &QAction::triggered, m_undoGroup, &QUndoGroup::undo);
+	connect(m_undoAct, &QAction::triggered, this, &MainWindow::undo);
 
 	m_redoAct = m_undoGroup->createRedoAction(this, tr("Redo"));
 	m_redoAct->setShortcuts(QKeySequence::Redo);
 	m_redoAct->setText(tr("Redo"));
+	disconnect(m_redoAct, &QAction::triggered, m_undoGroup, &QUndoGroup::redo);
+	connect(m_redoAct, &QAction::triggered, this, &MainWindow::redo);
 
 	m_undoShortcut = new QShortcut(this);
 
@@ -3069,7 +3117,10 @@ void MainWindow::newAutoroute() {
 	ProcessEventBlocker::processEvents();
 	ProcessEventBlocker::block();
 
-	autorouter->start();
+	{
+		FTimingScope timingScope("autoroute");
+		autorouter->start();
+	}
 	pcbSketchWidget->setIgnoreSelectionChangeEvents(false);
 
 	delete autorouter;
@@ -4312,6 +4363,7 @@ QStringList MainWindow::newDesignRulesCheck()
 
 QStringList MainWindow::newDesignRulesCheck(bool showOkMessage)
 {
+	FTimingScope timingScope("drc");
 	QStringList results;
 
 	if (m_currentGraphicsView == nullptr) return results;
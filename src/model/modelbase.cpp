@@ -494,8 +494,6 @@ void ModelBase::save(const QString & fileName, QXmlStreamWriter & streamWriter,
 
 bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
 {
-	m_referenceModel = referenceModel;
-
 	QDomDocument domDocument;
 	QString errorStr;
 	int errorLine;
@@ -503,6 +501,13 @@ bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<Model
 	bool result = domDocument.setContent(data, &errorStr, &errorLine, &errorColumn);
 	if (!result) return false;
 
+	return paste(referenceModel, domDocument, modelParts, boundingRects, preserveIndex);
+}
+
+bool ModelBase::paste(ModelBase * referenceModel, QDomDocument & domDocument, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
+{
+	m_referenceModel = referenceModel;
+
 	QDomElement module = domDocument.documentElement();
 	if (module.isNull()) {
 		return false;
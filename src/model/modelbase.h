@@ -43,6 +43,7 @@ public:
 	virtual bool addPart(ModelPart * modelPart, bool update);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference, bool updateIdAlreadyExists);
 	bool paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
+	bool paste(ModelBase * referenceModel, QDomDocument &, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
 	void setReportMissingModules(bool);
 	ModelPart * genFZP(const QString & moduleID, ModelBase * referenceModel);
 	const QString & fritzingVersion();
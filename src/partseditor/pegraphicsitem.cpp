@@ -78,6 +78,12 @@ void PEGraphicsItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *) {
 void PEGraphicsItem::wheelEvent(QGraphicsSceneWheelEvent * event) {
 	//DebugDialog::debug(QString("wheel %1 %2").arg(event->delta()).arg(event->orientation()));
 
+	if (!m_element.isNull()) {
+		// svg elements are stepped through by the PEHoverItem underneath
+		event->ignore();
+		return;
+	}
+
 #ifndef Q_OS_MACOS
 	// qt 4.8.3: mac: event orientation is messed up at this point
 	if (event->orientation() == Qt::Horizontal) return;
@@ -408,3 +414,71 @@ void PEGraphicsItem::restoreColor() {
 ItemBase * PEGraphicsItem::itemBase() {
 	return m_itemBase;
 }
+
+////////////////////////////////////////////////
+
+PEHoverItem::PEHoverItem(const QRectF & rect, ItemBase * itemBase) : QGraphicsRectItem(rect) {
+	m_itemBase = itemBase;
+	setAcceptedMouseButtons(Qt::NoButton);
+	setAcceptHoverEvents(true);
+	setPen(Qt::NoPen);
+	setBrush(Qt::NoBrush);
+}
+
+void PEHoverItem::hoverMoveEvent(QGraphicsSceneHoverEvent * event) {
+	Q_EMIT hoverMoved(this, event->pos());
+}
+
+void PEHoverItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *) {
+	m_wheelAccum = 0;
+	Q_EMIT hoverLeft(this);
+}
+
+void PEHoverItem::wheelEvent(QGraphicsSceneWheelEvent * event) {
+#ifndef Q_OS_MACOS
+	// qt 4.8.3: mac: event orientation is messed up at this point
+	if (event->orientation() == Qt::Horizontal) {
+		event->ignore();
+		return;
+	}
+#endif
+	if (event->delta() == 0 || (event->modifiers() & Qt::ShiftModifier) == 0) {
+		event->ignore();
+		return;
+	}
+
+	// delta one click forward = 120; delta one click backward = -120
+
+	int magDelta = qAbs(event->delta());
+	int sign = event->delta() / magDelta;
+	int delta = sign * qMin(magDelta, 120);
+	m_wheelAccum += delta;
+	if (qAbs(m_wheelAccum) < 120) return;
+
+	m_wheelAccum = 0;
+	Q_EMIT wheelStepped(this, event->pos(), sign);
+}
+
+void PEHoverItem::paint(QPainter *, const QStyleOptionGraphicsItem *, QWidget *)
+{
+}
+
+void PEHoverItem::setOffset(QPointF p) {
+	m_offset = p;
+}
+
+QPointF PEHoverItem::offset() {
+	return m_offset;
+}
+
+void PEHoverItem::setHoverEntry(int index) {
+	m_hoverEntry = index;
+}
+
+int PEHoverItem::hoverEntry() {
+	return m_hoverEntry;
+}
+
+ItemBase * PEHoverItem::itemBase() {
+	return m_itemBase;
+}
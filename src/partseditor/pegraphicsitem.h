@@ -92,4 +92,37 @@ protected:
 	class ItemBase * m_itemBase = nullptr;
 };
 
+/**
+ * Transparent item covering a part's svg in the Parts Editor. It forwards hover and wheel events
+ * so the element under the mouse can be looked up in the view's PESvgElementIndex, and only
+ * the highlighted element gets a PEGraphicsItem.
+ */
+class PEHoverItem : public QObject, public QGraphicsRectItem
+{
+	Q_OBJECT
+public:
+	PEHoverItem(const QRectF & rect, class ItemBase *);
+
+	void hoverMoveEvent(QGraphicsSceneHoverEvent *);
+	void hoverLeaveEvent(QGraphicsSceneHoverEvent *);
+	void wheelEvent(QGraphicsSceneWheelEvent *);
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+	void setOffset(QPointF);
+	QPointF offset();
+	void setHoverEntry(int);
+	int hoverEntry();
+	class ItemBase * itemBase();
+
+Q_SIGNALS:
+	void hoverMoved(PEHoverItem *, QPointF);
+	void hoverLeft(PEHoverItem *);
+	void wheelStepped(PEHoverItem *, QPointF, int sign);
+
+protected:
+	QPointF m_offset;
+	int m_hoverEntry = -1;
+	int m_wheelAccum = 0;
+	class ItemBase * m_itemBase = nullptr;
+};
+
 #endif /* PEGRAPHICSITEM_H_ */
@@ -1325,8 +1325,6 @@ void PEMainWindow::initSvgTree(SketchWidget * sketchWidget, ItemBase * itemBase,
 		}
 	}
 
-	int z = PegiZ;
-
 	FSvgRenderer tempRenderer;
 	QByteArray rendered = tempRenderer.loadSvg(tempSvgDoc.toByteArray(), "", false);
 	// cleans up the svg
@@ -1339,54 +1337,19 @@ void PEMainWindow::initSvgTree(SketchWidget * sketchWidget, ItemBase * itemBase,
 	FSvgRenderer renderer;
 	renderer.loadSvg(svgDocument.toByteArray(), "", false);
 
-	QHash<QString, PEGraphicsItem *> pegiHash;
-
-	QList<QDomElement> traverse;
-	traverse << svgDocument.documentElement();
-	while (traverse.count() > 0) {
-		QDomElement element = traverse.takeFirst();
-
-		// depth first
-		QList<QDomElement> next;
-		QDomElement child = element.firstChildElement();
-		while (!child.isNull()) {
-			next << child;
-			child = child.nextSiblingElement();
-		}
-		while (next.count() > 0) {
-			traverse.push_front(next.takeLast());
-		}
-
-		QString tagName = element.tagName();
-		if      (tagName.compare("rect") == 0);
-		else if (tagName.compare("g") == 0) {
-		}
-		else if (tagName.compare("svg") == 0) {
-		}
-		else if (tagName.compare("circle") == 0);
-		else if (tagName.compare("ellipse") == 0);
-		else if (tagName.compare("path") == 0);
-		else if (tagName.compare("line") == 0);
-		else if (tagName.compare("polyline") == 0);
-		else if (tagName.compare("polygon") == 0);
-		else if (tagName.compare("text") == 0);
-		else continue;
-
-		QRectF bounds = getPixelBounds(renderer, element);
-		// known Qt bug: boundsOnElement returns zero width and height for text elements.
-		if (bounds.width() > 0 && bounds.height() > 0) {
-			PEGraphicsItem * pegi = makePegi(bounds.size(), bounds.topLeft(), itemBase, element, z++);
-			pegiHash.insert(element.attribute("id"), pegi);
-
-			/*
-			QString string;
-			QTextStream stream(&string);
-			element.save(stream, 0);
-			DebugDialog::debug("........");
-			DebugDialog::debug(string);
-			*/
-		}
-	}
+	// only the element under the mouse and the connector elements get a PEGraphicsItem
+	ViewThing * viewThing = m_viewThings.value(sketchWidget->viewID());
+	PESvgElementIndex & elementIndex = viewThing->elementIndex;
+	elementIndex.build(svgDocument, renderer, PegiZ);
+
+	auto * hoverItem = new PEHoverItem(elementIndex.boundingRect(), itemBase);
+	hoverItem->setPos(itemBase->pos());
+	hoverItem->setZValue(PegiZ - 1);
+	itemBase->scene()->addItem(hoverItem);
+	viewThing->hoverItem = hoverItem;
+	connect(hoverItem, SIGNAL(hoverMoved(PEHoverItem *, QPointF)), this, SLOT(hoverItemMoved(PEHoverItem *, QPointF)));
+	connect(hoverItem, SIGNAL(hoverLeft(PEHoverItem *)), this, SLOT(hoverItemLeft(PEHoverItem *)));
+	connect(hoverItem, SIGNAL(wheelStepped(PEHoverItem *, QPointF, int)), this, SLOT(hoverItemWheelStepped(PEHoverItem *, QPointF, int)));
 
 	QDomElement root = m_fzpDocument.documentElement();
 	QDomElement connectors = root.firstChildElement("connectors");
@@ -1395,15 +1358,16 @@ void PEMainWindow::initSvgTree(SketchWidget * sketchWidget, ItemBase * itemBase,
 		QString svgID, terminalID;
 		bool ok = ViewLayer::getConnectorSvgIDs(connector, sketchWidget->viewID(), svgID, terminalID);
 		if (ok) {
-			PEGraphicsItem * terminalItem = pegiHash.value(terminalID, nullptr);
-			PEGraphicsItem * pegi = pegiHash.value(svgID);
-			if (pegi == nullptr) {
+			int index = elementIndex.indexOf(svgID);
+			if (index < 0) {
 				DebugDialog::debug(QString("missing pegi for svg id %1").arg(svgID));
 			}
 			else {
+				PEGraphicsItem * pegi = makeElementPegi(viewThing, index);
 				QPointF terminalPoint = pegi->rect().center();
-				if (terminalItem != nullptr) {
-					terminalPoint = terminalItem->pos() - pegi->pos() + terminalItem->rect().center();
+				int terminalIndex = elementIndex.indexOf(terminalID);
+				if (terminalIndex >= 0) {
+					terminalPoint = elementIndex.entry(terminalIndex).bounds.center() - elementIndex.entry(index).bounds.topLeft();
 				}
 				pegi->setTerminalPoint(terminalPoint);
 				pegi->showTerminalPoint(true);
@@ -1426,6 +1390,132 @@ void PEMainWindow::highlightSlot(PEGraphicsItem * pegi) {
 	}
 }
 
+void PEMainWindow::hoverItemMoved(PEHoverItem * hoverItem, QPointF p) {
+	ViewThing * viewThing = findViewThing(hoverItem);
+	if (viewThing == nullptr) return;
+
+	QList<int> indexes = viewThing->elementIndex.entriesAt(p);
+	int index = indexes.isEmpty() ? -1 : indexes.first();
+	if (index == hoverItem->hoverEntry()) return;
+
+	hoverItem->setHoverEntry(index);
+	if (index >= 0) {
+		highlightElementPegi(viewThing, index);
+		return;
+	}
+
+	hoverItemLeft(hoverItem);
+}
+
+void PEMainWindow::hoverItemLeft(PEHoverItem * hoverItem) {
+	ViewThing * viewThing = findViewThing(hoverItem);
+	if (viewThing == nullptr) return;
+
+	hoverItem->setHoverEntry(-1);
+	Q_FOREACH (PEGraphicsItem * pegi, getPegiList(viewThing->sketchWidget)) {
+		if (pegi->highlighted() && !pegi->element().isNull()) {
+			pegi->setHighlighted(false);
+			recyclePegi(viewThing, pegi);
+		}
+	}
+}
+
+void PEMainWindow::hoverItemWheelStepped(PEHoverItem * hoverItem, QPointF p, int sign) {
+	ViewThing * viewThing = findViewThing(hoverItem);
+	if (viewThing == nullptr) return;
+
+	QList<int> indexes = viewThing->elementIndex.entriesAt(p);
+	if (indexes.count() < 2) return;
+
+	int ix = 0;
+	for (int i = 0; i < indexes.count(); i++) {
+		PEGraphicsItem * pegi = findElementPegi(viewThing, indexes.at(i));
+		if (pegi != nullptr && pegi->highlighted()) {
+			ix = i;
+			break;
+		}
+	}
+
+	ix += sign;
+
+	// don't wrap
+	if (ix < 0) ix = 0;
+	else if (ix >= indexes.count()) ix = indexes.count() - 1;
+
+	PEGraphicsItem * pegi = findElementPegi(viewThing, indexes.at(ix));
+	if (pegi != nullptr && pegi->highlighted()) {
+		pegi->flash();
+	}
+	else {
+		highlightElementPegi(viewThing, indexes.at(ix));
+	}
+}
+
+PEGraphicsItem * PEMainWindow::findElementPegi(ViewThing * viewThing, int index) {
+	const QDomElement & element = viewThing->elementIndex.entry(index).element;
+	Q_FOREACH (PEGraphicsItem * pegi, getPegiList(viewThing->sketchWidget)) {
+		if (pegi->element() == element) return pegi;
+	}
+
+	return nullptr;
+}
+
+PEGraphicsItem * PEMainWindow::makeElementPegi(ViewThing * viewThing, int index) {
+	PEGraphicsItem * pegi = findElementPegi(viewThing, index);
+	if (pegi != nullptr) return pegi;
+
+	const PESvgElementIndex::Entry & entry = viewThing->elementIndex.entry(index);
+	QDomElement element = entry.element;
+	pegi = makePegi(entry.bounds.size(), entry.bounds.topLeft() + viewThing->hoverItem->offset(), viewThing->itemBase, element, entry.z);
+	if (m_inPickMode && viewThing->sketchWidget == m_currentGraphicsView) {
+		pegi->setPickAppearance(true);
+	}
+	return pegi;
+}
+
+void PEMainWindow::highlightElementPegi(ViewThing * viewThing, int index) {
+	QList<PEGraphicsItem *> previous;
+	Q_FOREACH (PEGraphicsItem * pegi, getPegiList(viewThing->sketchWidget)) {
+		if (pegi->highlighted()) previous << pegi;
+	}
+
+	makeElementPegi(viewThing, index)->setHighlighted(true);
+
+	Q_FOREACH (PEGraphicsItem * pegi, previous) {
+		recyclePegi(viewThing, pegi);
+	}
+}
+
+/**
+ * Deletes the PEGraphicsItem of an svg element once it is neither highlighted nor assigned to a connector.
+ */
+void PEMainWindow::recyclePegi(ViewThing * viewThing, PEGraphicsItem * pegi) {
+	if (pegi->highlighted() || pegi->showingMarquee() || pegi->showingTerminalPoint()) return;
+
+	QString id = pegi->element().attribute("id");
+	if (id.isEmpty()) return;
+
+	QDomElement connectors = m_fzpDocument.documentElement().firstChildElement("connectors");
+	QDomElement connector = connectors.firstChildElement("connector");
+	while (!connector.isNull()) {
+		QString svgID, terminalID;
+		if (ViewLayer::getConnectorSvgIDs(connector, viewThing->sketchWidget->viewID(), svgID, terminalID)) {
+			if (svgID == id || terminalID == id) return;
+		}
+		connector = connector.nextSiblingElement("connector");
+	}
+
+	delete pegi;
+}
+
+ViewThing * PEMainWindow::findViewThing(PEHoverItem * hoverItem) {
+	Q_FOREACH (ViewThing * viewThing, m_viewThings.values()) {
+		if (viewThing->hoverItem == hoverItem) return viewThing;
+	}
+
+	return nullptr;
+}
+
 void PEMainWindow::initConnectors(bool updateConnectorsView) {
 	QDomElement root = m_fzpDocument.documentElement();
 	QDomElement connectors = root.firstChildElement("connectors");
@@ -1881,6 +1971,9 @@ void PEMainWindow::busModeChanged(bool state) {
 		Q_FOREACH (PEGraphicsItem * pegi, pegiList) {
 			pegi->setVisible(false);
 		}
+		if (viewThing->hoverItem != nullptr) {
+			viewThing->hoverItem->setVisible(false);
+		}
 
 		// show connectorItems that have connectors assigned
 		QStringList connectorIDs;
@@ -2562,6 +2655,16 @@ void PEMainWindow::moveTerminalPoint(SketchWidget * sketchWidget, const QString
 		QPointF topLeft = connectorPegi->offset() + p - QPointF(invdx, invdy);
 		PEGraphicsItem * pegi = makePegi(QSizeF(invdx * 2, invdy * 2), topLeft, viewThing->itemBase, terminalElement, oldZ);
 		DebugDialog::debug("new pegi location", pegi->pos());
+		if (viewThing->hoverItem != nullptr) {
+			QRectF bounds(topLeft - viewThing->hoverItem->offset(), QSizeF(invdx * 2, invdy * 2));
+			int index = viewThing->elementIndex.indexOf(terminalElement);
+			if (index < 0) {
+				viewThing->elementIndex.append(terminalElement, bounds, oldZ);
+			}
+			else {
+				viewThing->elementIndex.setBounds(index, bounds, oldZ);
+			}
+		}
 		updateChangeCount(sketchWidget, changeDirection);
 	}
 
@@ -2590,6 +2693,8 @@ void PEMainWindow::showInOS() {
 PEGraphicsItem * PEMainWindow::makePegi(QSizeF size, QPointF topLeft, ItemBase * itemBase, QDomElement & element, double z)
 {
 	auto * pegiItem = new PEGraphicsItem(0, 0, size.width(), size.height(), itemBase);
+	// hovering over svg elements goes through the view's PEHoverItem
+	pegiItem->setAcceptHoverEvents(element.isNull());
 	pegiItem->showTerminalPoint(false);
 	pegiItem->setPos(itemBase->pos() + topLeft);
 	pegiItem->setZValue(z);
@@ -2604,27 +2709,6 @@ PEGraphicsItem * PEMainWindow::makePegi(QSizeF size, QPointF topLeft, ItemBase *
 	return pegiItem;
 }
 
-QRectF PEMainWindow::getPixelBounds(FSvgRenderer & renderer, QDomElement & element)
-{
-	QSizeF defaultSizeF = renderer.defaultSizeF();
-	QRectF viewBox = renderer.viewBoxF();
-
-	QString id = element.attribute("id");
-	QRectF r = renderer.boundsOnElement(id);
-	QTransform matrix = renderer.transformForElement(id);
-	QString oldid = element.attribute("oldid");
-	if (!oldid.isEmpty()) {
-		element.setAttribute("id", oldid);
-		element.removeAttribute("oldid");
-	}
-	QRectF bounds = matrix.mapRect(r);
-	bounds.setRect(bounds.x() * defaultSizeF.width() / viewBox.width(),
-	               bounds.y() * defaultSizeF.height() / viewBox.height(),
-	               bounds.width() * defaultSizeF.width() / viewBox.width(),
-	               bounds.height() * defaultSizeF.height() / viewBox.height());
-	return bounds;
-}
-
 bool PEMainWindow::canSave() {
 
 	return m_canSave;
@@ -2748,6 +2832,10 @@ void PEMainWindow::killPegi() {
 			auto * pegi = dynamic_cast<PEGraphicsItem *>(item);
 			if (pegi != nullptr) delete pegi;
 		}
+
+		delete viewThing->hoverItem;
+		viewThing->hoverItem = nullptr;
+		viewThing->elementIndex.clear();
 	}
 }
 
@@ -3809,6 +3897,10 @@ void PEMainWindow::showing(SketchWidget * sketchWidget) {
 				pegi->setPos(pegi->pos() + offset);
 				pegi->setOffset(pegi->offset() + offset);
 			}
+			if (viewThing->hoverItem != nullptr) {
+				viewThing->hoverItem->setPos(viewThing->hoverItem->pos() + offset);
+				viewThing->hoverItem->setOffset(viewThing->hoverItem->offset() + offset);
+			}
 		}
 	}
 }
@@ -3829,6 +3921,11 @@ bool PEMainWindow::anyMarquee() {
 bool PEMainWindow::anyVisible() {
 	if (m_currentGraphicsView == nullptr) return false;
 
+	ViewThing * viewThing = m_viewThings.value(m_currentGraphicsView->viewID());
+	if (viewThing->hoverItem != nullptr) {
+		return viewThing->hoverItem->isVisible();
+	}
+
 	Q_FOREACH (QGraphicsItem * item, m_currentGraphicsView->scene()->items()) {
 		auto * pegi = dynamic_cast<PEGraphicsItem *>(item);
 		if (pegi == nullptr) continue;
@@ -3889,6 +3986,10 @@ void PEMainWindow::itemMovedSlot(ItemBase * itemBase) {
 		}
 	}
 
+	ViewThing * viewThing = m_viewThings.value(m_currentGraphicsView->viewID());
+	if (viewThing->hoverItem != nullptr && viewThing->hoverItem->itemBase() == itemBase) {
+		viewThing->hoverItem->setPos(itemBase->pos() + viewThing->hoverItem->offset());
+	}
 }
 
 void PEMainWindow::resizedSlot(ItemBase * itemBase) {
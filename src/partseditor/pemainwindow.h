@@ -27,6 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../model/modelpartshared.h"
 #include "../sketch/sketchwidget.h"
 #include "peconnectorsview.h"
+#include "pesvgelementindex.h"
 
 class IconSketchWidget : public SketchWidget
 {
@@ -48,6 +49,8 @@ struct ViewThing {
 	QString originalSvgPath;
 	bool firstTime = false;
 	bool busMode = false;
+	PESvgElementIndex elementIndex;
+	class PEHoverItem * hoverItem = nullptr;
 };
 
 class ReferenceModel;
@@ -57,6 +60,7 @@ class PEConnectorsView;
 class PEToolView;
 class PESvgView;
 class PEGraphicsItem;
+class PEHoverItem;
 class Wire;
 class WireAction;
 class IconSketchWidget;
@@ -98,6 +102,9 @@ public Q_SLOTS:
 	void pegiMouseReleased(PEGraphicsItem *);
 	void pegiTerminalPointMoved(PEGraphicsItem *, QPointF);
 	void pegiTerminalPointChanged(PEGraphicsItem *, QPointF before, QPointF after);
+	void hoverItemMoved(PEHoverItem *, QPointF);
+	void hoverItemLeft(PEHoverItem *);
+	void hoverItemWheelStepped(PEHoverItem *, QPointF, int sign);
 	void switchedConnector(int);
 	void removedConnector(const QDomElement &);
 	void terminalPointChanged(const QString & how);
@@ -156,7 +163,11 @@ protected:
 	void showInOS(QWidget *parent, const QString &pathIn);
 	void switchedConnector(int, SketchWidget *);
 	PEGraphicsItem * makePegi(QSizeF size, QPointF topLeft, ItemBase * itemBase, QDomElement & element, double z);
-	QRectF getPixelBounds(FSvgRenderer & renderer, QDomElement & element);
+	PEGraphicsItem * findElementPegi(ViewThing *, int index);
+	PEGraphicsItem * makeElementPegi(ViewThing *, int index);
+	void highlightElementPegi(ViewThing *, int index);
+	void recyclePegi(ViewThing *, PEGraphicsItem *);
+	ViewThing * findViewThing(PEHoverItem *);
 	bool canSave();
 	bool saveAs(bool overWrite);
 	void setBeforeClosingText(const QString & filename, QMessageBox & messageBox);
@@ -0,0 +1,274 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "pesvgelementindex.h"
+#include "../fsvgrenderer.h"
+
+#include <QSet>
+#include <QTransform>
+#include <QtMath>
+
+#include <algorithm>
+
+static constexpr int NodeCapacity = 16;
+
+static const QSet<QString> IndexedTags({ "rect", "g", "svg", "circle", "ellipse", "path", "line", "polyline", "polygon", "text" });
+
+////////////////////////////////////////////////
+
+/**
+ * Walks the gorn tree of svgDocument once, in document order, and records the pixel bounds of every
+ * drawable element. The renderer must have been loaded from svgDocument after TextUtils::gornTree,
+ * so every element can be looked up by its gorn id; the original id is restored as each element is visited.
+ * Elements get increasing z values starting at z, so nested and later elements are on top.
+ */
+void PESvgElementIndex::build(QDomDocument & svgDocument, FSvgRenderer & renderer, double z)
+{
+	clear();
+
+	QSizeF defaultSizeF = renderer.defaultSizeF();
+	QRectF viewBox = renderer.viewBoxF();
+	QTransform toPixels = QTransform::fromScale(defaultSizeF.width() / viewBox.width(), defaultSizeF.height() / viewBox.height());
+
+	// transformForElement only depends on the ancestors, so siblings share it
+	QHash<QString, QTransform> parentTransforms;
+
+	QDomElement root = svgDocument.documentElement();
+	QDomElement element = root;
+	while (!element.isNull()) {
+		if (IndexedTags.contains(element.tagName())) {
+			QString id = element.attribute("id");
+			QString parentGorn = element.parentNode().toElement().attribute("gorn");
+			auto it = parentTransforms.constFind(parentGorn);
+			if (it == parentTransforms.constEnd()) {
+				it = parentTransforms.insert(parentGorn, renderer.transformForElement(id));
+			}
+			QRectF bounds = toPixels.mapRect(it.value().mapRect(renderer.boundsOnElement(id)));
+
+			QString oldid = element.attribute("oldid");
+			if (!oldid.isEmpty()) {
+				element.setAttribute("id", oldid);
+				element.removeAttribute("oldid");
+			}
+
+			// known Qt bug: boundsOnElement returns zero width and height for text elements.
+			if (bounds.width() > 0 && bounds.height() > 0) {
+				append(element, bounds, z++);
+			}
+		}
+
+		// depth first
+		QDomElement next = element.firstChildElement();
+		QDomElement up = element;
+		while (next.isNull() && up != root) {
+			next = up.nextSiblingElement();
+			up = up.parentNode().toElement();
+		}
+		element = next;
+	}
+}
+
+void PESvgElementIndex::clear()
+{
+	m_entries.clear();
+	m_ids.clear();
+	m_items.clear();
+	m_nodes.clear();
+	m_root = -1;
+	m_dirty = true;
+}
+
+int PESvgElementIndex::count() const
+{
+	return m_entries.count();
+}
+
+const PESvgElementIndex::Entry & PESvgElementIndex::entry(int index) const
+{
+	return m_entries.at(index);
+}
+
+int PESvgElementIndex::indexOf(const QString & id) const
+{
+	return m_ids.value(id, -1);
+}
+
+int PESvgElementIndex::indexOf(const QDomElement & element) const
+{
+	for (int i = 0; i < m_entries.count(); i++) {
+		if (m_entries.at(i).element == element) return i;
+	}
+
+	return -1;
+}
+
+int PESvgElementIndex::append(const QDomElement & element, const QRectF & bounds, double z)
+{
+	Entry entry;
+	entry.element = element;
+	entry.id = element.attribute("id");
+	entry.bounds = bounds;
+	entry.z = z;
+	m_entries.append(entry);
+	if (!entry.id.isEmpty()) {
+		m_ids.insert(entry.id, m_entries.count() - 1);
+	}
+	m_dirty = true;
+	return m_entries.count() - 1;
+}
+
+void PESvgElementIndex::setBounds(int index, const QRectF & bounds, double z)
+{
+	Entry & entry = m_entries[index];
+	entry.bounds = bounds;
+	entry.z = z;
+	m_dirty = true;
+}
+
+/**
+ * Returns the entries whose bounds contain p, topmost first.
+ */
+QList<int> PESvgElementIndex::entriesAt(QPointF p) const
+{
+	QList<int> result;
+	if (m_dirty) buildTree();
+	if (m_root < 0) return result;
+
+	QVector<int> stack;
+	stack.append(m_root);
+	while (!stack.isEmpty()) {
+		const Node & node = m_nodes.at(stack.takeLast());
+		if (!node.bounds.contains(p)) continue;
+
+		for (int i = node.first; i < node.first + node.count; i++) {
+			if (!node.leaf) {
+				stack.append(i);
+				continue;
+			}
+
+			int index = m_items.at(i);
+			if (m_entries.at(index).bounds.contains(p)) {
+				result.append(index);
+			}
+		}
+	}
+
+	std::sort(result.begin(), result.end(), [this](int a, int b) {
+		double za = m_entries.at(a).z;
+		double zb = m_entries.at(b).z;
+		return za == zb ? a > b : za > zb;
+	});
+	return result;
+}
+
+QRectF PESvgElementIndex::boundingRect() const
+{
+	if (m_dirty) buildTree();
+	if (m_root < 0) return QRectF();
+
+	return m_nodes.at(m_root).bounds;
+}
+
+/**
+ * Bulk loads the R-tree with sort-tile-recursive packing: each level is ordered into vertical
+ * slices by x, each slice by y, and consecutive runs of NodeCapacity become the children of one node.
+ */
+void PESvgElementIndex::buildTree() const
+{
+	m_dirty = false;
+	m_items.clear();
+	m_nodes.clear();
+	m_root = -1;
+
+	QVector<QRectF> rects;
+	QVector<int> indexes;
+	for (int i = 0; i < m_entries.count(); i++) {
+		if (m_entries.at(i).bounds.isEmpty()) continue;
+
+		rects.append(m_entries.at(i).bounds);
+		indexes.append(i);
+	}
+	if (indexes.isEmpty()) return;
+
+	QVector<Node> level;
+	QVector<int> order = strOrder(rects);
+	for (int i = 0; i < order.count(); i += NodeCapacity) {
+		Node node;
+		node.first = i;
+		node.count = qMin(NodeCapacity, order.count() - i);
+		for (int j = i; j < i + node.count; j++) {
+			m_items.append(indexes.at(order.at(j)));
+			node.bounds |= rects.at(order.at(j));
+		}
+		level.append(node);
+	}
+
+	while (level.count() > 1) {
+		rects.clear();
+		Q_FOREACH (const Node & node, level) {
+			rects.append(node.bounds);
+		}
+		order = strOrder(rects);
+
+		int base = m_nodes.count();
+		Q_FOREACH (int i, order) {
+			m_nodes.append(level.at(i));
+		}
+
+		QVector<Node> parents;
+		for (int i = 0; i < order.count(); i += NodeCapacity) {
+			Node node;
+			node.leaf = false;
+			node.first = base + i;
+			node.count = qMin(NodeCapacity, order.count() - i);
+			for (int j = node.first; j < node.first + node.count; j++) {
+				node.bounds |= m_nodes.at(j).bounds;
+			}
+			parents.append(node);
+		}
+		level = parents;
+	}
+
+	m_root = m_nodes.count();
+	m_nodes.append(level.first());
+}
+
+QVector<int> PESvgElementIndex::strOrder(const QVector<QRectF> & rects)
+{
+	QVector<int> order(rects.count());
+	for (int i = 0; i < order.count(); i++) {
+		order[i] = i;
+	}
+
+	std::sort(order.begin(), order.end(), [&rects](int a, int b) {
+		return rects.at(a).center().x() < rects.at(b).center().x();
+	});
+
+	int nodeCount = (order.count() + NodeCapacity - 1) / NodeCapacity;
+	int sliceSize = qCeil(qSqrt(nodeCount)) * NodeCapacity;
+	for (int i = 0; i < order.count(); i += sliceSize) {
+		auto end = order.begin() + qMin(i + sliceSize, order.count());
+		std::sort(order.begin() + i, end, [&rects](int a, int b) {
+			return rects.at(a).center().y() < rects.at(b).center().y();
+		});
+	}
+
+	return order;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef PESVGELEMENTINDEX_H_
+#define PESVGELEMENTINDEX_H_
+
+#include <QDomElement>
+#include <QHash>
+#include <QList>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+/**
+ * Flat list of the pixel bounds of the drawable elements of a part's svg, plus a packed R-tree
+ * over them, so the Parts Editor can find the elements under the mouse without keeping a
+ * graphics item for every element.
+ */
+class PESvgElementIndex
+{
+public:
+	struct Entry {
+		QDomElement element;
+		QString id;
+		QRectF bounds;          // in pixels, relative to the top left of the part
+		double z = 0;
+	};
+
+public:
+	void build(QDomDocument & svgDocument, class FSvgRenderer & renderer, double z);
+	void clear();
+	int count() const;
+	const Entry & entry(int index) const;
+	int indexOf(const QString & id) const;
+	int indexOf(const QDomElement & element) const;
+	int append(const QDomElement & element, const QRectF & bounds, double z);
+	void setBounds(int index, const QRectF & bounds, double z);
+	QList<int> entriesAt(QPointF p) const;
+	QRectF boundingRect() const;
+
+protected:
+	struct Node {
+		QRectF bounds;
+		int first = 0;          // into m_items for leaves, into m_nodes otherwise
+		int count = 0;
+		bool leaf = true;
+	};
+
+	void buildTree() const;
+
+	static QVector<int> strOrder(const QVector<QRectF> & rects);
+
+protected:
+	QVector<Entry> m_entries;
+	QHash<QString, int> m_ids;
+
+	mutable bool m_dirty = true;
+	mutable QVector<int> m_items;
+	mutable QVector<Node> m_nodes;
+	mutable int m_root = -1;
+};
+
+#endif /* PESVGELEMENTINDEX_H_ */
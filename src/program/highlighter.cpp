@@ -32,6 +32,12 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define COMMENTOFFSET 100
 static const QChar CEscapeChar('\\');
 
+// compiled once and shared by all highlighters; highlightBlock runs on every keystroke
+static const QRegularExpression CharRule(R"RX('.?')RX");
+static const QRegularExpression HexRule(R"RX((\b0x[\dA-F]+\b))RX", QRegularExpression::CaseInsensitiveOption);
+static const QRegularExpression OctalRule(R"RX((\b0[0-7]+\b))RX");
+static const QRegularExpression BinaryRule(R"RX((\b0b[01]+\b))RX", QRegularExpression::CaseInsensitiveOption);
+
 QHash <QString, QTextCharFormat *> Highlighter::m_styleFormats;
 
 Highlighter::Highlighter(QTextEdit * textEdit) : QSyntaxHighlighter(textEdit)
@@ -148,7 +154,7 @@ void Highlighter::highlightBlock(const QString &text)
 	highlightNumbers(noComment);
 
 	// highlight single chars
-	applyRule(QRegularExpression(R"RX('.?')RX"), m_styleFormats.value("Constant", nullptr), text);
+	applyRule(CharRule, m_styleFormats.value("Constant", nullptr), text);
 
 }
 
@@ -196,21 +202,21 @@ void Highlighter::highlightStrings(int startStringIndex, QString & text) {
 }
 
 void Highlighter::highlightTerms(const QString & text) {
+	QStringView view(text);
 	int lastWordBreak = 0;
 	int textLength = text.length();
 	int b;
 	while (lastWordBreak < textLength) {
 		for (b = lastWordBreak; b < textLength; b++) {
-			if (!isWordChar(text.at(b))) break;
+			if (!isWordChar(view.at(b))) break;
 		}
 
 		if (b > lastWordBreak) {
 			TrieLeaf * leaf = nullptr;
-			if (m_syntaxer->matches(text.mid(lastWordBreak, b - lastWordBreak), leaf)) {
+			if (m_syntaxer->matches(view.mid(lastWordBreak, b - lastWordBreak), leaf)) {
 				auto * stl = dynamic_cast<SyntaxerTrieLeaf *>(leaf);
 				if (stl != nullptr) {
-					QString format = Syntaxer::formatFromList(stl->name());
-					QTextCharFormat * tcf = m_styleFormats.value(format, NULL);
+					QTextCharFormat * tcf = m_styleFormats.value(stl->format(), NULL);
 					if (tcf != nullptr) {
 						setFormat(lastWordBreak, b - lastWordBreak, *tcf);
 					}
@@ -230,16 +236,13 @@ void Highlighter::highlightNumbers(const QString &text) {
 
 	// Hex
 	auto * hexStyle(m_styleFormats.value("Hex", nullptr));
-	QRegularExpression hexRule(R"RX((\b0x[\dA-F]+\b))RX", QRegularExpression::CaseInsensitiveOption);
-	applyRule(hexRule, hexStyle, text);
+	applyRule(HexRule, hexStyle, text);
 
 	// Octal (use the hex style)
-	QRegularExpression octalRule(R"RX((\b0[0-7]+\b))RX");
-	applyRule(octalRule, hexStyle, text);
+	applyRule(OctalRule, hexStyle, text);
 
 	// Binary (use the hex style)
-	QRegularExpression binaryRule(R"RX((\b0b[01]+\b))RX", QRegularExpression::CaseInsensitiveOption);
-	applyRule(binaryRule, hexStyle, text);
+	applyRule(BinaryRule, hexStyle, text);
 }
 
 void Highlighter::applyRule(const QRegularExpression & rule, QTextCharFormat * format, const QString & text) {
@@ -35,6 +35,7 @@ Syntaxer::~Syntaxer() {
 	if (m_trieRoot != nullptr) {
 		delete m_trieRoot;
 	}
+	qDeleteAll(m_trieLeaves);
 }
 
 bool Syntaxer::loadSyntax(const QString &filename)
@@ -147,6 +148,7 @@ QString Syntaxer::parseForName(const QString & filename)
 void Syntaxer::loadList(QDomElement & list) {
 	QString name = list.attribute("name");
 	auto * stf = new SyntaxerTrieLeaf(name);
+	m_trieLeaves.append(stf);
 	QDomElement item = list.firstChildElement("item");
 	while (!item.isNull()) {
 		QString text;
@@ -158,11 +160,10 @@ void Syntaxer::loadList(QDomElement & list) {
 	}
 }
 
-bool Syntaxer::matches(const QString & string, TrieLeaf * & leaf) {
+bool Syntaxer::matches(QStringView string, TrieLeaf * & leaf) const {
 	if (m_trieRoot == nullptr) return false;
 
-	QString temp = string;
-	return m_trieRoot->matches(temp, leaf);
+	return m_trieRoot->matches(string, leaf);
 }
 
 const CommentInfo * Syntaxer::getCommentInfo(int ix) {
@@ -246,6 +247,8 @@ bool Syntaxer::canProgram() {
 
 SyntaxerTrieLeaf::SyntaxerTrieLeaf(QString name) {
 	m_name = name;
+	// lists are mapped to formats before the lists themselves are loaded
+	m_format = Syntaxer::formatFromList(name);
 }
 
 SyntaxerTrieLeaf::~SyntaxerTrieLeaf()
@@ -257,6 +260,11 @@ const QString & SyntaxerTrieLeaf::name()
 	return m_name;
 }
 
+const QString & SyntaxerTrieLeaf::format()
+{
+	return m_format;
+}
+
 //////////////////////////////////////////////
 
 CommentInfo::CommentInfo(const QString & start, const QString & end, Qt::CaseSensitivity caseSensitive) {
@@ -52,7 +52,7 @@ public:
 	virtual ~Syntaxer();
 
 	bool loadSyntax(const QString & filename);
-	bool matches(const QString & string, TrieLeaf * & leaf);
+	bool matches(QStringView string, TrieLeaf * & leaf) const;
 	const CommentInfo * getCommentInfo(int ix);
 	bool matchCommentStart(const QString & text, int offset, int & result, const CommentInfo * & resultCommentInfo);
 	int matchStringStart(const QString & text, int offset);
@@ -76,6 +76,7 @@ protected:
 
 protected:
 	TrieNode * m_trieRoot = nullptr;
+	QList<TrieLeaf *> m_trieLeaves;
 	QString m_name;
 	QString m_extensionString;
 	QStringList m_extensions;
@@ -92,9 +93,11 @@ public:
 	~SyntaxerTrieLeaf();
 
 	const QString & name();
+	const QString & format();
 
 protected:
 	QString m_name;
+	QString m_format;
 };
 
 #endif /* SYNTAXER_H_ */
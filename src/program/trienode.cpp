@@ -39,18 +39,15 @@ TrieNode::TrieNode(QChar c)
 	m_char = c;
 	m_leafData = nullptr;
 	m_isLeaf = false;
-	m_caseInsensitive = false;
 }
 
 TrieNode::~TrieNode()
 {
-	Q_FOREACH (TrieNode * node, m_children) {
-		delete node;
-	}
+	qDeleteAll(m_children);
 	m_children.clear();
 }
 
-void TrieNode::addString(QString & string, bool caseInsensitive, TrieLeaf * leaf) {
+void TrieNode::addString(QStringView string, bool caseInsensitive, TrieLeaf * leaf) {
 	if (string.isEmpty()) {
 		m_leafData = leaf;
 		m_isLeaf = true;
@@ -58,7 +55,7 @@ void TrieNode::addString(QString & string, bool caseInsensitive, TrieLeaf * leaf
 	}
 
 	QChar in(string.at(0));
-	QString next = string.remove(0, 1);
+	QStringView next = string.mid(1);
 	QChar c0, c1;
 	if (caseInsensitive) {
 		c0 = in.toLower();
@@ -75,43 +72,26 @@ void TrieNode::addString(QString & string, bool caseInsensitive, TrieLeaf * leaf
 	}
 }
 
-void TrieNode::addStringAux(QChar c, QString & next, bool caseInsensitive, TrieLeaf * leaf) {
-	bool gotc = false;
-	Q_FOREACH (TrieNode * node, m_children) {
-		if (node->matchesChar(c)) {
-			node->addString(next, caseInsensitive, leaf);
-			gotc = true;
-		}
-	}
-
-	if (!gotc) {
-		auto * child = new TrieNode(c);
-		m_children.append(child);
-		child->addString(next, caseInsensitive, leaf);
+void TrieNode::addStringAux(QChar c, QStringView next, bool caseInsensitive, TrieLeaf * leaf) {
+	TrieNode * child = m_children.value(c, nullptr);
+	if (child == nullptr) {
+		child = new TrieNode(c);
+		m_children.insert(c, child);
 	}
+	child->addString(next, caseInsensitive, leaf);
 }
 
-bool TrieNode::matchesChar(QChar c) {
-	return (c == m_char);
-}
-
-bool TrieNode::matches(QString & string, TrieLeaf * & leaf)
+bool TrieNode::matches(QStringView string, TrieLeaf * & leaf) const
 {
-	if (string.isEmpty()) {
-		if (m_isLeaf) {
-			leaf = m_leafData;
-			return true;
-		}
-
-		return false;
+	// walk the trie one character at a time; no copies of the input are made
+	const TrieNode * node = this;
+	for (QChar in : string) {
+		node = node->m_children.value(in, nullptr);
+		if (node == nullptr) return false;
 	}
 
-	QChar in(string.at(0));
-	Q_FOREACH (TrieNode * node, m_children) {
-		if (node->matchesChar(in)) {
-			return node->matches(string.remove(0, 1), leaf);
-		}
-	}
+	if (!node->m_isLeaf) return false;
 
-	return false;
+	leaf = node->m_leafData;
+	return true;
 }
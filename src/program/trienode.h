@@ -23,7 +23,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define TRIENODE_H_
 
 #include <QChar>
-#include <QList>
+#include <QHash>
+#include <QStringView>
 
 class TrieLeaf {
 public:
@@ -37,17 +38,15 @@ public:
 	TrieNode(QChar);
 	virtual ~TrieNode();
 
-	virtual void addString(QString & s, bool caseInsensitive, TrieLeaf * leaf);
-	virtual bool matches(QString & string, TrieLeaf * & leaf);
+	void addString(QStringView string, bool caseInsensitive, TrieLeaf * leaf);
+	bool matches(QStringView string, TrieLeaf * & leaf) const;
 
 protected:
-	virtual void addStringAux(QChar c, QString & next, bool caseInsensitive, TrieLeaf * leaf);
-	virtual bool matchesChar(QChar c);
+	void addStringAux(QChar c, QStringView next, bool caseInsensitive, TrieLeaf * leaf);
 
 protected:
 	QChar m_char;
-	bool m_caseInsensitive;
-	QList<TrieNode *> m_children;
+	QHash<QChar, TrieNode *> m_children;
 	TrieLeaf * m_leafData;
 	bool m_isLeaf;
 };
@@ -23,6 +23,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "items/itembase.h"
 
+#include <QPointer>
+
 struct RoutingStatus {
 	int m_netCount;
 	int m_netRoutedCount;
@@ -34,6 +36,22 @@ public:
 		m_netCount = m_netRoutedCount = m_connectorsLeftToRoute = m_jumperItemCount = 0;
 	}
 
+	RoutingStatus & operator+=(const RoutingStatus &other) {
+		m_netCount += other.m_netCount;
+		m_netRoutedCount += other.m_netRoutedCount;
+		m_connectorsLeftToRoute += other.m_connectorsLeftToRoute;
+		m_jumperItemCount += other.m_jumperItemCount;
+		return *this;
+	}
+
+	RoutingStatus & operator-=(const RoutingStatus &other) {
+		m_netCount -= other.m_netCount;
+		m_netRoutedCount -= other.m_netRoutedCount;
+		m_connectorsLeftToRoute -= other.m_connectorsLeftToRoute;
+		m_jumperItemCount -= other.m_jumperItemCount;
+		return *this;
+	}
+
 	bool operator!=(const RoutingStatus &other) const {
 		return
 		    (m_netCount != other.m_netCount) ||
@@ -43,5 +61,10 @@ public:
 	}
 };
 
+// one net's share of the sketch's routing status, kept so that only changed nets need rescoring
+struct NetRoutingStatus {
+	QList< QPointer<class ConnectorItem> > connectorItems;
+	RoutingStatus routingStatus;
+};
 
 #endif // ROUTINGSTATUS_H
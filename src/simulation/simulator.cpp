@@ -19,6 +19,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 ********************************************************************/
 
 #include "simulator.h"
+#include "spicenetlistdiff.h"
 #include <QtCore>
 
 #include <QSvgGenerator>
@@ -43,6 +44,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../sketch/schematicsketchwidget.h"
 #include "../utils/fmessagebox.h"
 #include "../utils/textutils.h"
+#include "../utils/FTimingProbe.h"
 #include "../simulation/ngspice_simulator.h"
 #include "../items/led.h"
 #include "../items/wire.h"
@@ -153,6 +155,7 @@ void Simulator::startSimulation()
 void Simulator::stopSimulation() {
 	m_showResultsTimer->stop();
 	m_simulating = false;
+	m_loadedNetlist.clear();
 	removeSimItems();
 	emit simulationStartedOrStopped(m_simulating);
 	m_breadboardGraphicsView->setSimulatorMessage("");
@@ -179,6 +182,7 @@ void Simulator::stopSimulation() {
  * @brief Simulate the current circuit and check for components working out of specifications
  */
 void Simulator::simulate() {
+	FTimingScope timingScope("simulation");
 	if (!m_enabled || !m_simulating) {
 		DebugDialog::stream() << "The simulator is not enabled or simulating";
 		return;
@@ -267,27 +271,33 @@ void Simulator::simulate() {
 
 
 	DebugDialog::stream() << "Netlist: " << spiceNetlist.toStdString();
-	DebugDialog::stream() << "Running command(remcirc):";
-	m_simulator->command("remcirc");
-	DebugDialog::stream() << "Running m_simulator->command('reset'):";
-	m_simulator->command("reset");
-	m_simulator->clearLog();
-	// DebugDialog::stream() << "Loading codemodel analog.cm, which should be in the CWD:";
-	// m_simulator->command("codemodel ./usr/lib/ngspice/analog.cm");
-
-	DebugDialog::stream() << "-----------------------------------";
-	DebugDialog::stream() << "Running LoadNetlist:";
-	m_simulator->loadCircuit(spiceNetlist.toStdString());
 
-	if (QString::fromStdString(m_simulator->getLog(false)).toLower().contains("error") || // "error on line"
-		QString::fromStdString(m_simulator->getLog(true)).toLower().contains("warning")) { // "warning, can't find model"
-		//Ngspice found an error, do not continue
-		QString errorHint = tr("The simulator gave an error when loading the netlist. "
-							   "Probably some SPICE field is wrong, please, check them.\n"
-							   "If the parts are from the simulation bin, report the bug in GitHub.");
-		showSimulatorError(nullptr, errorHint, spiceNetlist, m_simulator);
-		stopSimulation();
-		return;
+	//If only values or model parameters changed, update the loaded circuit instead of parsing it again
+	if (!alterLoadedCircuit(spiceNetlist)) {
+		DebugDialog::stream() << "Running command(remcirc):";
+		m_simulator->command("remcirc");
+		DebugDialog::stream() << "Running m_simulator->command('reset'):";
+		m_simulator->command("reset");
+		m_simulator->clearLog();
+		// DebugDialog::stream() << "Loading codemodel analog.cm, which should be in the CWD:";
+		// m_simulator->command("codemodel ./usr/lib/ngspice/analog.cm");
+
+		DebugDialog::stream() << "-----------------------------------";
+		DebugDialog::stream() << "Running LoadNetlist:";
+		m_loadedNetlist.clear();
+		m_simulator->loadCircuit(spiceNetlist.toStdString());
+
+		if (QString::fromStdString(m_simulator->getLog(false)).toLower().contains("error") || // "error on line"
+			QString::fromStdString(m_simulator->getLog(true)).toLower().contains("warning")) { // "warning, can't find model"
+			//Ngspice found an error, do not continue
+			QString errorHint = tr("The simulator gave an error when loading the netlist. "
+								   "Probably some SPICE field is wrong, please, check them.\n"
+								   "If the parts are from the simulation bin, report the bug in GitHub.");
+			showSimulatorError(nullptr, errorHint, spiceNetlist, m_simulator);
+			stopSimulation();
+			return;
+		}
+		m_loadedNetlist = spiceNetlist;
 	}
 	DebugDialog::stream() << "-----------------------------------";
 	DebugDialog::stream() << "Running command(listing):";
@@ -397,6 +407,52 @@ void Simulator::simulate() {
 }
 
 
+/**
+ * Compares the netlist with the one loaded in ngspice. If they only differ in the values of
+ * components or in model parameters, the loaded circuit is updated with alter and altermod
+ * commands, which is much faster than removing the circuit and parsing the whole netlist again.
+ * @brief Apply parameter-only changes to the loaded circuit
+ * @param spiceNetlist the netlist of the current circuit
+ * @return true if the loaded circuit is ready to be simulated, false if the netlist must be loaded
+ */
+bool Simulator::alterLoadedCircuit(const QString & spiceNetlist) {
+	if (m_loadedNetlist.isEmpty()) return false;
+
+	QStringList commands;
+	if (!SpiceNetlistDiff::parameterChanges(m_loadedNetlist, spiceNetlist, commands)) {
+		DebugDialog::stream() << "The topology of the circuit changed, loading the netlist again";
+		return false;
+	}
+
+	if (m_simulator->isBGThreadRunning()) {
+		m_simulator->command("bg_halt");
+		int elapsedTime = 0, haltTimeOut = 1000; // in ms
+		while (m_simulator->isBGThreadRunning() && elapsedTime < haltTimeOut) {
+			QThread::msleep(1);
+			elapsedTime++;
+		}
+		if (m_simulator->isBGThreadRunning()) return false;
+	}
+
+	//Remove the vectors of the previous run, the analysis is run again on the altered circuit
+	m_simulator->command("destroy all");
+	m_simulator->clearLog();
+	Q_FOREACH (QString command, commands) {
+		DebugDialog::stream() << "Running command(" << command.toStdString() << "):";
+		m_simulator->command(command.toStdString());
+	}
+
+	if (QString::fromStdString(m_simulator->getLog(false)).toLower().contains("error") ||
+		QString::fromStdString(m_simulator->getLog(true)).toLower().contains("error")) {
+		DebugDialog::stream() << "The circuit could not be altered, loading the netlist again";
+		m_simulator->clearLog();
+		return false;
+	}
+
+	m_loadedNetlist = spiceNetlist;
+	return true;
+}
+
 void Simulator::showSimulatorError(QWidget* parent, const QString& errorHint, const QString& spiceNetlist, const std::shared_ptr<NgSpiceSimulator>& simulator) {
 	FMessageBox* msgBox = FMessageBox::createCustom(
 		parent,
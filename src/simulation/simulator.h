@@ -43,6 +43,7 @@ public:
 
 private:
 	void resetTimer();
+	bool alterLoadedCircuit(const QString & spiceNetlist);
 
 	void showSimulatorError(QWidget *parent, const QString &errorHint, const QString &spiceNetlist, const std::shared_ptr<NgSpiceSimulator>& simulator);
 public slots:
@@ -103,6 +104,8 @@ protected:
 	bool m_transientSimulationEnabled = false;
 	bool m_debugSimResult = false;
 
+	QString m_loadedNetlist;
+
 	QSet<ItemBase *> itemBases;
 	QHash<ItemBase *, ItemBase *> m_sch2bbItemHash;
 	QHash<ConnectorItem *, int> m_connector2netHash;
@@ -0,0 +1,183 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "spicenetlistdiff.h"
+
+#include <QRegularExpression>
+
+namespace {
+
+const QRegularExpression Whitespace("\\s+");
+const QRegularExpression SpacedEquals("\\s*=\\s*");
+
+}
+
+/**
+ * Compares the netlist currently loaded in ngspice with a newly generated one. Both
+ * netlists must have the same elements, connected to the same nodes, in the same order.
+ * Returns true if the differences (if any) can be applied to the loaded circuit; in that
+ * case commands contains the alter/altermod commands to run. Returns false if the
+ * topology, the analysis or any other statement has changed and the netlist has to be
+ * loaded again.
+ */
+bool SpiceNetlistDiff::parameterChanges(const QString & loadedNetlist, const QString & netlist, QStringList & commands)
+{
+	commands.clear();
+	QList<Entry> loadedEntries = parse(loadedNetlist);
+	QList<Entry> entries = parse(netlist);
+	if (loadedEntries.count() != entries.count()) return false;
+
+	for (int i = 0; i < entries.count(); i++) {
+		const Entry & loaded = loadedEntries.at(i);
+		const Entry & entry = entries.at(i);
+		if (loaded.key != entry.key || loaded.isModel != entry.isModel) return false;
+
+		if (entry.isModel) {
+			if (loaded.params.keys() != entry.params.keys()) return false;
+
+			for (auto it = entry.params.constBegin(); it != entry.params.constEnd(); ++it) {
+				if (loaded.params.value(it.key()) != it.value()) {
+					commands << QString("altermod %1 %2 = %3").arg(entry.name, it.key(), it.value());
+				}
+			}
+		}
+		else if (loaded.value != entry.value) {
+			commands << QString("alter %1 = %2").arg(entry.name, entry.value);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Splits a netlist into statements. The title line and comments are skipped and
+ * continuation lines are joined. Resistors, capacitors, inductors and independent
+ * sources with a single value, as well as model cards, are split into a key and
+ * their parameters; any other statement (including the elements of subcircuit
+ * definitions) is kept verbatim as the key.
+ */
+QList<SpiceNetlistDiff::Entry> SpiceNetlistDiff::parse(const QString & netlist)
+{
+	QStringList lines;
+	bool titleLine = true;
+	Q_FOREACH (QString line, netlist.split('\n')) {
+		line = line.trimmed();
+		if (titleLine) {
+			titleLine = false;
+			continue;
+		}
+		if (line.isEmpty() || line.startsWith('*')) continue;
+
+		if (line.startsWith('+') && !lines.isEmpty()) {
+			lines.last() += ' ' + line.mid(1).trimmed();
+			continue;
+		}
+
+		lines << line;
+	}
+
+	QList<Entry> entries;
+	bool inSubcircuit = false;
+	Q_FOREACH (QString line, lines) {
+		QStringList tokens = line.split(Whitespace, Qt::SkipEmptyParts);
+		QString first = tokens.first().toLower();
+		if (first == ".subckt") {
+			inSubcircuit = true;
+		}
+		else if (first == ".ends") {
+			inSubcircuit = false;
+		}
+
+		if (!inSubcircuit) {
+			if (first == ".model") {
+				entries << parseModel(line);
+				continue;
+			}
+
+			int valueIndex = -1;
+			QChar type = first.at(0);
+			if (type == 'r' || type == 'c' || type == 'l' || type == 'v' || type == 'i') {
+				if (tokens.count() == 4) {
+					valueIndex = 3;
+				}
+				else if (tokens.count() == 5 && (type == 'v' || type == 'i') && tokens.at(3).compare("dc", Qt::CaseInsensitive) == 0) {
+					valueIndex = 4;
+				}
+			}
+
+			if (valueIndex > 0 && isPlainValue(tokens.at(valueIndex))) {
+				Entry entry;
+				entry.name = tokens.first();
+				entry.key = tokens.mid(0, valueIndex).join(' ').toLower();
+				entry.value = tokens.at(valueIndex);
+				entries << entry;
+				continue;
+			}
+		}
+
+		Entry entry;
+		entry.name = tokens.first();
+		entry.key = tokens.join(' ');
+		entries << entry;
+	}
+
+	return entries;
+}
+
+SpiceNetlistDiff::Entry SpiceNetlistDiff::parseModel(const QString & line)
+{
+	Entry entry;
+	entry.key = line.split(Whitespace, Qt::SkipEmptyParts).join(' ');
+
+	QString header = line;
+	QString body;
+	int open = line.indexOf('(');
+	int close = line.lastIndexOf(')');
+	if (open >= 0 && close > open) {
+		header = line.left(open);
+		body = line.mid(open + 1, close - open - 1);
+	}
+
+	QStringList headerTokens = header.split(Whitespace, Qt::SkipEmptyParts);
+	if (headerTokens.count() < 3) return entry;
+
+	body += ' ' + headerTokens.mid(3).join(' ');
+	body.replace(SpacedEquals, "=");
+	body.replace(',', ' ');
+
+	QMap<QString, QString> params;
+	Q_FOREACH (QString param, body.split(Whitespace, Qt::SkipEmptyParts)) {
+		int equals = param.indexOf('=');
+		if (equals <= 0 || !isPlainValue(param.mid(equals + 1))) return entry;
+
+		params.insert(param.left(equals).toLower(), param.mid(equals + 1));
+	}
+
+	entry.isModel = true;
+	entry.name = headerTokens.at(1);
+	entry.key = QString(".model %1 %2").arg(headerTokens.at(1), headerTokens.at(2)).toLower();
+	entry.params = params;
+	return entry;
+}
+
+bool SpiceNetlistDiff::isPlainValue(const QString & token)
+{
+	return !token.isEmpty() && !token.contains('=') && !token.contains('(') && !token.contains('{') && !token.contains('\'');
+}
@@ -0,0 +1,53 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SPICENETLISTDIFF_H
+#define SPICENETLISTDIFF_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+
+/**
+ * Compares two spice netlists generated for the simulator. If they only differ in
+ * the values of passive components, independent sources or model parameters, the
+ * loaded circuit can be updated with alter/altermod commands instead of being
+ * removed and parsed again.
+ */
+class SpiceNetlistDiff
+{
+public:
+	static bool parameterChanges(const QString & loadedNetlist, const QString & netlist, QStringList & commands);
+
+protected:
+	struct Entry {
+		QString key;
+		QString name;
+		QString value;
+		bool isModel = false;
+		QMap<QString, QString> params;
+	};
+
+	static QList<Entry> parse(const QString & netlist);
+	static Entry parseModel(const QString & line);
+	static bool isPlainValue(const QString & token);
+};
+
+#endif
@@ -36,7 +36,10 @@ BreadboardSketchWidget::BreadboardSketchWidget(ViewLayer::ViewID viewID, QWidget
 	m_shortName = QObject::tr("bb");
 	m_viewName = QObject::tr("Breadboard View");
 	initBackgroundColor();
+	initColorWiresByLength();
+}
 
+void BreadboardSketchWidget::initColorWiresByLength() {
 	m_colorWiresByLength = false;
 	QSettings settings;
 	QString colorWiresByLength = settings.value(QString("%1ColorWiresByLength").arg(getShortName())).toString();
@@ -45,6 +48,13 @@ BreadboardSketchWidget::BreadboardSketchWidget(ViewLayer::ViewID viewID, QWidget
 	}
 }
 
+void BreadboardSketchWidget::clearSketch() {
+	SketchWidget::clearSketch();
+
+	// a sketch only sets this when it has the attribute, so the next one must not inherit it
+	initColorWiresByLength();
+}
+
 void BreadboardSketchWidget::setWireVisible(Wire * wire)
 {
 	bool visible = !(wire->getTrace());
@@ -42,8 +42,10 @@ public:
 	void getBendpointWidths(class Wire *, double w, double & w1, double & w2, bool & negativeOffsetRect);
 	void colorWiresByLength(bool);
 	bool coloringWiresByLength();
+	void clearSketch();
 
 protected:
+	void initColorWiresByLength();
 	void setWireVisible(Wire * wire);
 	bool collectFemaleConnectees(ItemBase *, QSet<ItemBase *> &);
 	void findConnectorsUnder(ItemBase * item);
@@ -263,6 +263,11 @@ void InfoGraphicsView::setNoteFocus(QGraphicsItem * item, bool inFocus) {
 	Q_UNUSED(inFocus);
 }
 
+bool InfoGraphicsView::paintedFromTiles(const ItemBase * itemBase) {
+	Q_UNUSED(itemBase);
+	return false;
+}
+
 void InfoGraphicsView::setBoardLayers(int layers, bool redraw) {
 	Q_UNUSED(redraw);
 	m_boardLayers = layers;
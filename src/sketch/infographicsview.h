@@ -73,6 +73,7 @@ public:
 	virtual void loadLogoImage(ItemBase *, const QString & oldSvg, const QSizeF oldAspectRatio, const QString & oldFilename, const QString & newFilename, bool addName);
 
 	virtual void setNoteFocus(QGraphicsItem *, bool inFocus);
+	virtual bool paintedFromTiles(const ItemBase *);
 
 	int boardLayers();
 	virtual void setBoardLayers(int, bool redraw);
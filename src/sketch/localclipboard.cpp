@@ -0,0 +1,89 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "localclipboard.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+
+const QString LocalClipboard::MimeType("application/x-fritzing-local-clipboard");
+QDomDocument LocalClipboard::Snapshot;
+quint64 LocalClipboard::Serial = 0;
+
+QByteArray LocalClipboard::marker()
+{
+	QByteArray bytes;
+	QDataStream stream(&bytes, QIODevice::WriteOnly);
+	stream << (qint64) QCoreApplication::applicationPid() << Serial;
+	return bytes;
+}
+
+QMimeData * LocalClipboard::mimeData(const QDomDocument & domDocument)
+{
+	Serial++;
+	Snapshot = domDocument;
+	return new LocalMimeData(domDocument, marker());
+}
+
+bool LocalClipboard::get(const QMimeData * mimeData, QDomDocument & domDocument)
+{
+	if (Snapshot.isNull() || mimeData == nullptr) return false;
+	if (!mimeData->hasFormat(MimeType)) return false;
+	if (mimeData->data(MimeType) != marker()) return false;
+
+	// pasting keeps pointers into its document and renumbers it, so every paste gets its own
+	domDocument = Snapshot.cloneNode(true).toDocument();
+	return !domDocument.isNull();
+}
+
+void LocalClipboard::clear()
+{
+	Snapshot.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+
+LocalMimeData::LocalMimeData(const QDomDocument & domDocument, const QByteArray & marker)
+	: m_document(domDocument)
+	, m_marker(marker)
+{
+}
+
+QStringList LocalMimeData::formats() const
+{
+	return QStringList() << LocalClipboard::MimeType << "application/x-dnditemsdata" << "text/plain";
+}
+
+bool LocalMimeData::hasFormat(const QString & mimeType) const
+{
+	return formats().contains(mimeType);
+}
+
+QVariant LocalMimeData::retrieveData(const QString & mimeType, QMetaType type) const
+{
+	if (mimeType == LocalClipboard::MimeType) return m_marker;
+	if (!hasFormat(mimeType)) return QMimeData::retrieveData(mimeType, type);
+
+	// another process, or a paste that can't use the snapshot
+	if (m_xml.isEmpty()) {
+		m_xml = m_document.toByteArray();
+	}
+	return m_xml;
+}
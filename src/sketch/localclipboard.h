@@ -0,0 +1,69 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef LOCALCLIPBOARD_H
+#define LOCALCLIPBOARD_H
+
+#include <QDomDocument>
+#include <QMimeData>
+#include <QString>
+
+// Keeps the last copy made in this process as a parsed document, with the connections to parts
+// outside the copy already removed. Pasting it back clones that document instead of parsing the
+// clipboard's xml again. The xml is still offered on the clipboard for other processes and
+// versions, but only written out when one of them asks for it; a marker next to it says which
+// process and which copy it came from, so anything copied elsewhere since then still comes in
+// through the xml.
+
+class LocalClipboard
+{
+public:
+	static QMimeData * mimeData(const QDomDocument &);		// new clipboard data for a copy
+	static bool get(const QMimeData *, QDomDocument &);
+	static void clear();
+
+	static const QString MimeType;
+
+protected:
+	static QByteArray marker();
+
+protected:
+	static QDomDocument Snapshot;
+	static quint64 Serial;
+};
+
+class LocalMimeData : public QMimeData
+{
+public:
+	LocalMimeData(const QDomDocument &, const QByteArray & marker);
+
+	QStringList formats() const override;
+	bool hasFormat(const QString & mimeType) const override;
+
+protected:
+	QVariant retrieveData(const QString & mimeType, QMetaType type) const override;
+
+protected:
+	QDomDocument m_document;
+	QByteArray m_marker;
+	mutable QByteArray m_xml;		// written on the first request for it
+};
+
+#endif
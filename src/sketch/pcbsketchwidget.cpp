@@ -94,6 +94,14 @@ PCBSketchWidget::PCBSketchWidget(ViewLayer::ViewID viewID, QWidget *parent)
 	m_lastTraceWireWidth = Wire::STANDARD_TRACE_WIDTH;
 }
 
+void PCBSketchWidget::clearSketch() {
+	SketchWidget::clearSketch();
+
+	// the autorouter and trace settings come with a sketch; a fresh window starts without them
+	m_autorouterSettings.clear();
+	m_lastTraceWireWidth = Wire::STANDARD_TRACE_WIDTH;
+}
+
 void PCBSketchWidget::setWireVisible(Wire * wire)
 {
 	bool visible = wire->getRatsnest() || (wire->isTraceType(this->getTraceFlag()));
@@ -2084,7 +2092,8 @@ void PCBSketchWidget::postImageSlot(GroundPlaneGeneratorOld * gpg, QImage * copp
 			}
 		}
 
-		DebugDialog::debug(QString("x1:%1 y1:%2 x2:%3 y2:%4").arg(x1).arg(y1).arg(x2).arg(y2));
+		DebugDialog::stream() << "x1:" << QString::number(x1) << " y1:" << QString::number(y1)
+		                      << " x2:" << QString::number(x2) << " y2:" << QString::number(y2);
 	}
 }
 
@@ -46,6 +46,7 @@ public:
 	bool hasAnyNets();
 	void forwardRoutingStatusForCommand(const RoutingStatus &);
 	void addDefaultParts();
+	void clearSketch();
 	void showEvent(QShowEvent * event);
 	void initWire(Wire *, int penWidth);
 	virtual bool autorouteTypePCB();
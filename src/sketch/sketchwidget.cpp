@@ -56,6 +56,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "sketchwidget.h"
 #include "subpartswapmanager.h"
+#include "tilecache.h"
+#include "localclipboard.h"
 #include "../connectors/connectoritem.h"
 #include "../connectors/svgidlayer.h"
 #include "../items/jumperitem.h"
@@ -83,6 +85,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/graphutils.h"
 #include "../utils/ratsnestcolors.h"
 #include "../utils/fmessagebox.h"
+#include "../utils/FTimingProbe.h"
 #include "utils/duplicatetracker.h"
 
 /////////////////////////////////////////////////////////////////////
@@ -179,6 +182,9 @@ SketchWidget::SketchWidget(ViewLayer::ViewID viewID, QWidget *parent, int size,
 
 	connect(this->scene(), SIGNAL(selectionChanged()), this, SLOT(selectionChangedSlot()));
 
+	m_tileCache = new TileCache(this);
+	m_tileCache->setEnabled(QSettings().value("tileCacheEnabled", false).toBool());
+
 	connect(QApplication::clipboard(),SIGNAL(changed(QClipboard::Mode)),this,SLOT(restartPasteCount()));
 	restartPasteCount(); // the first time
 
@@ -222,6 +228,11 @@ void SketchWidget::setUndoStack(WaitPushUndoStack * undoStack) {
 void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseCommand::CrossViewType crossViewType, QUndoCommand * parentCommand, bool offsetPaste, const QRectF * boundingRect, bool seekOutsideConnections, QList<long> & newIDs, bool pasteInPlace) {
 	clearHoldingSelectItem();
 
+	if (!parentCommand) {
+		// loading a sketch: rebuild the per-net routing status from scratch on the next update
+		clearNetRoutingStatus();
+	}
+
 	if (parentCommand) {
 		SelectItemCommand * selectItemCommand = stackSelectionState(false, parentCommand);
 		selectItemCommand->setSelectItemType(SelectItemCommand::DeselectAll);
@@ -961,7 +972,7 @@ void SketchWidget::deleteItemForCommand(long id, bool deleteModelPart, bool doEm
 void SketchWidget::deleteItem(ItemBase * itemBase, bool deleteModelPart, bool doEmit, bool later)
 {
 	long id = itemBase->id();
-	DebugDialog::debug(QString("delete item (2) %1 %2 %3 %4").arg(id).arg(itemBase->title()).arg(m_viewID).arg((long) itemBase, 0, 16) );
+	DebugDialog::stream() << "delete item (2) " << id << " " << itemBase->title() << " " << m_viewID << " " << QString::number((long) itemBase, 16);
 
 	// this is a hack to try to workaround a Qt 4.7 crash in QGraphicsSceneFindItemBspTreeVisitor::visit
 	// when using a custom boundingRect, after deleting an item, it still appears on the visit list.
@@ -1626,11 +1637,17 @@ void SketchWidget::copyAux(QList<ItemBase *> & bases, bool saveBoundingRects)
 	copyHeart(bases, saveBoundingRects, itemData, modelIndexes);
 
 	// only preserve connections for copied items that connect to each other
-	QByteArray newItemData = removeOutsideConnections(itemData, modelIndexes);
-
-	auto *mimeData = new QMimeData;
-	mimeData->setData("application/x-dnditemsdata", newItemData);
-	mimeData->setData("text/plain", newItemData);
+	QDomDocument domDocument;
+	QMimeData * mimeData = nullptr;
+	if (removeOutsideConnections(itemData, modelIndexes, domDocument)) {
+		// pasting within this process uses the document; the xml is only written if another process asks for it
+		mimeData = LocalClipboard::mimeData(domDocument);
+	}
+	else {
+		mimeData = new QMimeData;
+		mimeData->setData("application/x-dnditemsdata", QByteArray());
+		mimeData->setData("text/plain", QByteArray());
+	}
 
 	QClipboard *clipboard = QApplication::clipboard();
 	if (!clipboard) {
@@ -1698,23 +1715,22 @@ void SketchWidget::copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects,
 	streamWriter.writeEndElement();
 }
 
-QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes) {
+bool SketchWidget::removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes, QDomDocument & domDocument) {
 	// now have to remove each connection that points to a part outside of the set of parts being copied
 
-	QDomDocument domDocument;
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
 	bool result = domDocument.setContent(itemData, &errorStr, &errorLine, &errorColumn);
-	if (!result) return ___emptyByteArray___;
+	if (!result) return false;
 
 	QDomElement root = domDocument.documentElement();
 	if (root.isNull()) {
-		return ___emptyByteArray___;
+		return false;
 	}
 
 	QDomElement instances = root.firstChildElement("instances");
-	if (instances.isNull()) return ___emptyByteArray___;
+	if (instances.isNull()) return false;
 
 	QDomElement instance = instances.firstChildElement("instance");
 	while (!instance.isNull()) {
@@ -1757,7 +1773,7 @@ QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, Q
 		instance = instance.nextSiblingElement("instance");
 	}
 
-	return domDocument.toByteArray();
+	return true;
 }
 
 
@@ -4453,7 +4469,7 @@ void SketchWidget::continueZChangeMax(QList<ItemBase *> & bases, int start, int
 		if (dest >= 0) {
 			moved = true;
 			bases.move(i, dest);
-			DebugDialog::debug(QString("moving %1 to %2").arg(i).arg(dest));
+			DebugDialog::stream() << "moving " << i << " to " << dest;
 			i -= inc;	// because we just modified the list and would miss the next item
 		}
 	}
@@ -5572,6 +5588,39 @@ void SketchWidget::clearTemporaries() {
 	m_temporaries.clear();
 }
 
+void SketchWidget::clearSketch() {
+	// empties the scene so another sketch can be loaded into it; the model parts are left to the caller
+	clearHoldingSelectItem();
+	killDroppingItem();
+	clearTemporaries();
+	scene()->clearSelection();
+
+	QList< QPointer<ItemBase> > chiefs;
+	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == nullptr) continue;
+		if (itemBase->layerKinChief() != itemBase) continue;
+
+		chiefs.append(itemBase);
+	}
+
+	Q_FOREACH (ItemBase * itemBase, chiefs) {
+		if (itemBase == nullptr) continue;
+
+		deleteItem(itemBase, false, false, false);
+	}
+
+	m_savedItems.clear();
+	m_savedWires.clear();
+	m_checkUnder.clear();
+	m_routingStatus.zero();
+	clearNetRoutingStatus();
+
+	setViewFromBelow(false);
+	initBackgroundColor();
+	initGrid();
+}
+
 void SketchWidget::killDroppingItem() {
 	m_alignmentItem = nullptr;
 	if (m_droppingItem) {
@@ -6904,27 +6953,62 @@ void SketchWidget::updateRoutingStatus(CleanUpWiresCommand* command, RoutingStat
 
 void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manual)
 {
+	FTimingScope timingScope("ratsnest");
 	//DebugDialog::debug(QString("update routing status %1 %2 %3")
 	//	.arg(m_viewID)
 	//	.arg(m_ratsnestUpdateConnect.count())
 	//	.arg(m_ratsnestUpdateDisconnect.count())
 	//	);
 
-	// TODO: think about ways to optimize this...
-
 	QList< QPointer<VirtualWire> > ratsToDelete;
-
 	QList< QList<ConnectorItem *> > ratnestsToUpdate;
-	QList<ConnectorItem *> visited;
+
+	if (manual || !m_netRoutingStatusValid) {
+		updateAllNets(manual, ratnestsToUpdate, ratsToDelete);
+	}
+	else {
+		updateChangedNets(ratnestsToUpdate, ratsToDelete);
+	}
+
+	routingStatus = m_netRoutingStatusTotal;
+	routingStatus.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+
+	// can't do this while collecting nets since VirtualWires and ConnectorItems are added and deleted
+	Q_FOREACH (QList<ConnectorItem *> partConnectorItems, ratnestsToUpdate) {
+		//partConnectorItems.at(0)->debugInfo("display ratsnest");
+		partConnectorItems.at(0)->displayRatsnest(partConnectorItems, this->getTraceFlag());
+	}
+
+	Q_FOREACH(QPointer<VirtualWire> vw, ratsToDelete) {
+		if (vw && (vw->connector0()->connectionsCount() == 0 || vw->connector1()->connectionsCount() == 0)) {
+			//vw->debugInfo("removing rat 2");
+			vw->scene()->removeItem(vw);
+			delete vw;
+		}
+	}
+
+
+	m_ratsnestUpdateConnect.clear();
+	m_ratsnestUpdateDisconnect.clear();
+
+	/*
+	// uncomment for live drc
+	CMRouter cmRouter(this);
+	QString message;
+	bool result = cmRouter.drc(message);
+	*/
+}
+
+void SketchWidget::updateAllNets(bool manual, QList< QList<ConnectorItem *> > & ratnestsToUpdate, QList< QPointer<VirtualWire> > & ratsToDelete)
+{
+	clearNetRoutingStatus();
+
+	QSet<ConnectorItem *> visited;
 	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
 		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
 		if (!connectorItem) continue;
 		if (visited.contains(connectorItem)) continue;
 
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//    connectorItem->debugInfo("testing urs");
-		//}
-
 		auto * vw = qobject_cast<VirtualWire *>(connectorItem->attachedTo());
 		if (vw) {
 			if (vw->connector0()->connectionsCount() == 0 || vw->connector1()->connectionsCount() == 0) {
@@ -6934,91 +7018,157 @@ void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manua
 			continue;
 		}
 
-
 		QList<ConnectorItem *> connectorItems;
 		connectorItems.append(connectorItem);
 		ConnectorItem::collectEqualPotential(connectorItems, true, ViewGeometry::RatsnestFlag);
-		visited.append(connectorItems);
-
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//	DebugDialog::debug("________________________");
-		//	foreach (ConnectorItem * ci, connectorItems) ci->debugInfo("cep");
-		//}
+		Q_FOREACH (ConnectorItem * ci, connectorItems) {
+			visited.insert(ci);
+		}
 
 		bool doRatsnest = manual || checkUpdateRatsnest(connectorItems);
-		if (!doRatsnest && connectorItems.count() <= 1) continue;
-
-		QList<ConnectorItem *> partConnectorItems;
-		ConnectorItem::collectParts(connectorItems, partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
-		if (partConnectorItems.count() < 1) continue;
-		if (!doRatsnest && partConnectorItems.count() <= 1) continue;
-
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//    DebugDialog::debug("________________________");
-		//    foreach (ConnectorItem * pci, partConnectorItems) {
-		//		pci->debugInfo("pc 1");
-		//	}
-		//}
+		scoreNet(connectorItems, doRatsnest, ratnestsToUpdate);
+	}
 
-		for (int i = partConnectorItems.count() - 1; i >= 0; i--) {
-			ConnectorItem * ci = partConnectorItems[i];
+	m_netRoutingStatusValid = true;
+}
 
-			if (!ci->attachedTo()->isEverVisible()) {
-				partConnectorItems.removeAt(i);
-			}
-		}
+void SketchWidget::updateChangedNets(QList< QList<ConnectorItem *> > & ratnestsToUpdate, QList< QPointer<VirtualWire> > & ratsToDelete)
+{
+	// a net has to be rescored if one of its connectors was connected or disconnected, or was deleted along with its part or wire
+	QSet<int> changed;
+	changed.swap(m_netsLosingConnectors);
 
-		if (partConnectorItems.count() < 1) continue;
+	QList<ConnectorItem *> seeds;
+	QList< QPointer<ConnectorItem> > flagged(m_ratsnestUpdateConnect);
+	flagged.append(m_ratsnestUpdateDisconnect);
+	Q_FOREACH (ConnectorItem * connectorItem, flagged) {
+		if (connectorItem == nullptr) continue;
 
-		if (doRatsnest) {
-			ratnestsToUpdate.append(partConnectorItems);
+		seeds.append(connectorItem);
+		int netID = m_connectorNets.value(connectorItem, -1);
+		if (netID >= 0) {
+			changed.insert(netID);
 		}
+	}
 
-		if (partConnectorItems.count() <= 1) continue;
+	if (changed.isEmpty() && seeds.isEmpty()) return;
 
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//    DebugDialog::debug("________________________");
-		//    foreach (ConnectorItem * pci, partConnectorItems) {
-		//		pci->debugInfo("pc 2");
-		//	}
-		//}
+	Q_FOREACH (int netID, changed) {
+		dropNet(netID, seeds, ratsToDelete);
+	}
+
+	// seeds grows while looping: a rescored net can take in connectors of nets that were not flagged
+	// (a voltage or bus change, say), and whatever is left of those nets has to be rescored as well
+	QSet<ConnectorItem *> visited;
+	for (int i = 0; i < seeds.count(); i++) {
+		ConnectorItem * connectorItem = seeds.at(i);
+		if (visited.contains(connectorItem)) continue;
+		if (connectorItem->scene() != scene()) continue;
+		if (qobject_cast<VirtualWire *>(connectorItem->attachedTo())) continue;
+
+		QList<ConnectorItem *> connectorItems;
+		connectorItems.append(connectorItem);
+		ConnectorItem::collectEqualPotential(connectorItems, true, ViewGeometry::RatsnestFlag);
+		Q_FOREACH (ConnectorItem * ci, connectorItems) {
+			visited.insert(ci);
+			int netID = m_connectorNets.value(ci, -1);
+			if (netID >= 0) {
+				dropNet(netID, seeds, ratsToDelete);
+			}
+		}
 
-		GraphUtils::scoreOneNet(partConnectorItems, this->getTraceFlag(), routingStatus);
+		scoreNet(connectorItems, true, ratnestsToUpdate);
 	}
+}
 
-	routingStatus.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+void SketchWidget::dropNet(int netID, QList<ConnectorItem *> & seeds, QList< QPointer<VirtualWire> > & ratsToDelete)
+{
+	// takes a net out of the totals; its surviving connectors become seeds to be rescored
+	if (!m_netRoutingStatuses.contains(netID)) return;
 
-	// can't do this in the above loop since VirtualWires and ConnectorItems are added and deleted
-	Q_FOREACH (QList<ConnectorItem *> partConnectorItems, ratnestsToUpdate) {
-		//partConnectorItems.at(0)->debugInfo("display ratsnest");
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//    DebugDialog::debug("________________________");
-		//    foreach (ConnectorItem * pci, partConnectorItems) {
-		//		pci->debugInfo("pc 3");
-		//	}
-		//}
+	NetRoutingStatus netRoutingStatus = m_netRoutingStatuses.take(netID);
+	m_netRoutingStatusTotal -= netRoutingStatus.routingStatus;
+	Q_FOREACH (ConnectorItem * connectorItem, netRoutingStatus.connectorItems) {
+		// deleted connectors have already left m_connectorNets through connectorDestroyedSlot
+		if (connectorItem == nullptr) continue;
 
-		partConnectorItems.at(0)->displayRatsnest(partConnectorItems, this->getTraceFlag());
+		if (m_connectorNets.value(connectorItem, -1) == netID) {
+			m_connectorNets.remove(connectorItem);
+		}
+		seeds.append(connectorItem);
+		Q_FOREACH (ConnectorItem * toConnectorItem, connectorItem->connectedToItems()) {
+			auto * vw = qobject_cast<VirtualWire *>(toConnectorItem->attachedTo());
+			if (vw) {
+				ratsToDelete.append(vw);
+			}
+		}
 	}
+}
 
-	Q_FOREACH(QPointer<VirtualWire> vw, ratsToDelete) {
-		if (vw) {
-			//vw->debugInfo("removing rat 2");
-			vw->scene()->removeItem(vw);
-			delete vw;
+void SketchWidget::scoreNet(QList<ConnectorItem *> & connectorItems, bool doRatsnest, QList< QList<ConnectorItem *> > & ratnestsToUpdate)
+{
+	// a connector is only ever counted in one net, so any net it was in before is gone now
+	Q_FOREACH (ConnectorItem * connectorItem, connectorItems) {
+		auto old = m_netRoutingStatuses.constFind(m_connectorNets.value(connectorItem, -1));
+		if (old != m_netRoutingStatuses.cend()) {
+			m_netRoutingStatusTotal -= old.value().routingStatus;
+			m_netRoutingStatuses.erase(old);
 		}
 	}
 
+	int netID = m_nextNetRoutingStatusID++;
+	NetRoutingStatus & netRoutingStatus = m_netRoutingStatuses[netID];
+	netRoutingStatus.routingStatus.zero();
+	Q_FOREACH (ConnectorItem * connectorItem, connectorItems) {
+		netRoutingStatus.connectorItems.append(connectorItem);
+		m_connectorNets.insert(connectorItem, netID);
+		connect(connectorItem, &QObject::destroyed, this, &SketchWidget::connectorDestroyedSlot, Qt::UniqueConnection);
+	}
 
-	m_ratsnestUpdateConnect.clear();
-	m_ratsnestUpdateDisconnect.clear();
+	if (!doRatsnest && connectorItems.count() <= 1) return;
 
-	/*
-	// uncomment for live drc
-	CMRouter cmRouter(this);
-	QString message;
-	bool result = cmRouter.drc(message);
-	*/
+	QList<ConnectorItem *> partConnectorItems;
+	ConnectorItem::collectParts(connectorItems, partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
+	if (partConnectorItems.count() < 1) return;
+	if (!doRatsnest && partConnectorItems.count() <= 1) return;
+
+	for (int i = partConnectorItems.count() - 1; i >= 0; i--) {
+		ConnectorItem * ci = partConnectorItems[i];
+
+		if (!ci->attachedTo()->isEverVisible()) {
+			partConnectorItems.removeAt(i);
+		}
+	}
+
+	if (partConnectorItems.count() < 1) return;
+
+	if (doRatsnest) {
+		ratnestsToUpdate.append(partConnectorItems);
+	}
+
+	if (partConnectorItems.count() <= 1) return;
+
+	GraphUtils::scoreOneNet(partConnectorItems, this->getTraceFlag(), netRoutingStatus.routingStatus);
+	m_netRoutingStatusTotal += netRoutingStatus.routingStatus;
+}
+
+void SketchWidget::connectorDestroyedSlot(QObject * connectorItem)
+{
+	// the address may be reused by a new connector, so the entry goes now and its net is rescored next time
+	auto it = m_connectorNets.find(connectorItem);
+	if (it == m_connectorNets.end()) return;
+
+	m_netsLosingConnectors.insert(it.value());
+	m_connectorNets.erase(it);
+}
+
+void SketchWidget::clearNetRoutingStatus()
+{
+	m_netRoutingStatuses.clear();
+	m_connectorNets.clear();
+	m_netsLosingConnectors.clear();
+	m_netRoutingStatusTotal.zero();
+	m_netRoutingStatusValid = false;
 }
 
 
@@ -7732,6 +7882,9 @@ void SketchWidget::drawBackground( QPainter * painter, const QRectF & rect )
 			painter->restore();
 		}
 	}
+
+	// static parts go on top of the grid, under everything painted live
+	m_tileCache->draw(painter, rect);
 }
 
 void SketchWidget::drawForeground ( QPainter * painter, const QRectF & rect ) {
@@ -8557,6 +8710,14 @@ void SketchWidget::paintEvent ( QPaintEvent * event ) {
 	QGraphicsView::paintEvent(event);
 }
 
+bool SketchWidget::paintedFromTiles(const ItemBase * itemBase) {
+	return m_tileCache->paintedFromTiles(itemBase);
+}
+
+void SketchWidget::setTileCacheEnabled(bool enabled) {
+	m_tileCache->setEnabled(enabled);
+}
+
 void SketchWidget::setNoteFocus(QGraphicsItem * item, bool inFocus) {
 	if (inFocus) {
 		m_inFocus.append(item);
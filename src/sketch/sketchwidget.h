@@ -185,6 +185,7 @@ public:
 	void hideConnectors(bool hide);
 	void updateRoutingStatus(CleanUpWiresCommand*, RoutingStatus &, bool manual);
 	void updateRoutingStatus(RoutingStatus &, bool manual);
+	void clearNetRoutingStatus();
 	virtual bool hasAnyNets();
 	void ensureLayerVisible(ViewLayer::ViewLayerID);
 
@@ -242,6 +243,8 @@ public:
 	void loadLogoImage(long itemID, const QString & oldSvg, const QSizeF oldAspectRatio, const QString & oldFilename);
 	void loadLogoImage(long itemID, const QString & newFilename, bool addName);
 	void setNoteFocus(QGraphicsItem *, bool inFocus);
+	bool paintedFromTiles(const ItemBase *);
+	void setTileCacheEnabled(bool);
 
 	void alignToGrid(bool);
 	bool alignedToGrid();
@@ -270,6 +273,7 @@ public:
 	void ratsnestConnect(ItemBase *, bool connect);
 	void ratsnestConnect(ConnectorItem * c1, ConnectorItem * c2, bool connect, bool wait);
 	virtual void addDefaultParts();
+	virtual void clearSketch();
 	float getTopZ();
 	QGraphicsItem * addWatermark(const QString & filename);
 	void copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects, QByteArray & itemData, QList<long> & modelIndexes);
@@ -422,7 +426,7 @@ protected:
 	virtual void setWireVisible(Wire *);
 	bool matchesLayer(ModelPart * modelPart);
 
-	QByteArray removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes);
+	bool removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes, QDomDocument & domDocument);
 	void addWireExtras(long newID, QDomElement & view, QUndoCommand * parentCommand);
 	virtual const QString & hoverEnterWireConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
 	virtual const QString & hoverEnterPartConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
@@ -493,6 +497,10 @@ protected:
 	void moveLegBendpointsAux(ConnectorItem * connectorItem, bool undoOnly, QUndoCommand * parentCommand);
 	virtual void rotatePartLabels(double degrees, QTransform &, QPointF center, QUndoCommand * parentCommand);
 	bool checkUpdateRatsnest(QList<ConnectorItem *> & connectorItems);
+	void updateAllNets(bool manual, QList< QList<ConnectorItem *> > & ratnestsToUpdate, QList< QPointer<class VirtualWire> > & ratsToDelete);
+	void updateChangedNets(QList< QList<ConnectorItem *> > & ratnestsToUpdate, QList< QPointer<class VirtualWire> > & ratsToDelete);
+	void scoreNet(QList<ConnectorItem *> & connectorItems, bool doRatsnest, QList< QList<ConnectorItem *> > & ratnestsToUpdate);
+	void dropNet(int netID, QList<ConnectorItem *> & seeds, QList< QPointer<class VirtualWire> > & ratsToDelete);
 	void makeRatsnestViewGeometry(ViewGeometry & viewGeometry, ConnectorItem * source, ConnectorItem * dest);
 	virtual double getTraceWidth();
 	virtual void setLastTraceWidth(double lastTraceWidth);
@@ -578,6 +586,7 @@ Q_SIGNALS:
 	void undoSignal();
 
 protected Q_SLOTS:
+	void connectorDestroyedSlot(QObject *);
 	void itemAddedSlot(ModelPart *, ItemBase *, ViewLayer::ViewLayerPlacement, const ViewGeometry &, long id, SketchWidget * dropOrigin);
 	void itemDeletedSlot(long id);
 	void clearSelectionSlot();
@@ -749,6 +758,12 @@ protected:
 	bool m_curvyWires = false;
 	bool m_rubberBandLegWasEnabled = false;
 	RoutingStatus m_routingStatus;
+	QHash<int, NetRoutingStatus> m_netRoutingStatuses;
+	QHash<QObject *, int> m_connectorNets;			// keyed by QObject so destroyed() can take a connector out
+	QSet<int> m_netsLosingConnectors;
+	RoutingStatus m_netRoutingStatusTotal;
+	int m_nextNetRoutingStatusID = 0;
+	bool m_netRoutingStatusValid = false;
 	bool m_anyInRotation;
 	bool m_pasting = false;
 	QPointer<class ResizableBoard> m_resizingBoard;
@@ -758,6 +773,7 @@ protected:
 	double m_ratsnestOpacity = 0.0;
 	double m_ratsnestWidth = 0.0;
     QString m_simMessage = "";
+	class TileCache * m_tileCache = nullptr;
 
 public:
 	static ViewLayer::ViewLayerID defaultConnectorLayer(ViewLayer::ViewID viewId);
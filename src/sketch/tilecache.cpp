@@ -0,0 +1,599 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "tilecache.h"
+#include "../items/paletteitembase.h"
+#include "../fsvgrenderer.h"
+
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPicture>
+#include <QStyleOptionGraphicsItem>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+
+const int TileCache::TileSize = 256;
+const int TileCache::MaxCost = 128 * 1024;
+const int TileCache::SettleDelay = 300;
+
+QCache<TileCache::TileKey, QPixmap> TileCache::Tiles(TileCache::MaxCost);
+
+namespace {
+
+// rectangles painted live, bucketed so that checking a part against them stays cheap
+class LiveRegion
+{
+public:
+	void add(const QRectF & rect) {
+		if (rect.isEmpty()) return;
+
+		qint64 left, top, right, bottom;
+		cells(rect, left, top, right, bottom);
+		if ((right - left + 1) * (bottom - top + 1) > MaxCells) {
+			m_large.append(rect);
+			return;
+		}
+		for (qint64 row = top; row <= bottom; row++) {
+			for (qint64 column = left; column <= right; column++) {
+				m_cells[key(column, row)].append(rect);
+			}
+		}
+	}
+
+	bool intersects(const QRectF & rect) const {
+		if (rect.isEmpty()) return false;
+
+		Q_FOREACH (const QRectF & large, m_large) {
+			if (large.intersects(rect)) return true;
+		}
+
+		qint64 left, top, right, bottom;
+		cells(rect, left, top, right, bottom);
+		for (qint64 row = top; row <= bottom; row++) {
+			for (qint64 column = left; column <= right; column++) {
+				auto it = m_cells.constFind(key(column, row));
+				if (it == m_cells.constEnd()) continue;
+
+				Q_FOREACH (const QRectF & live, it.value()) {
+					if (live.intersects(rect)) return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+protected:
+	static void cells(const QRectF & rect, qint64 & left, qint64 & top, qint64 & right, qint64 & bottom) {
+		left = (qint64) std::floor(rect.left() / CellSize);
+		top = (qint64) std::floor(rect.top() / CellSize);
+		right = (qint64) std::floor(rect.right() / CellSize);
+		bottom = (qint64) std::floor(rect.bottom() / CellSize);
+	}
+
+	static quint64 key(qint64 column, qint64 row) {
+		return ((quint64) (quint32) column << 32) | (quint32) row;
+	}
+
+protected:
+	static constexpr double CellSize = 256;
+	static constexpr qint64 MaxCells = 64;
+
+	QHash<quint64, QList<QRectF>> m_cells;
+	QList<QRectF> m_large;
+};
+
+struct TileLayer {
+	QByteArray picture;
+	QTransform transform;
+	double opacity = 1;
+};
+
+struct TileJob {
+	QTransform transform;			// scene to tile pixels
+	int pixels = 0;
+	double devicePixelRatio = 1;
+	QPainter::RenderHints renderHints;
+	QList<TileLayer> layers;
+};
+
+QImage renderTile(const TileJob & job)
+{
+	QImage image(job.pixels, job.pixels, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+
+	QPainter painter(&image);
+	painter.setRenderHints(job.renderHints);
+	Q_FOREACH (const TileLayer & layer, job.layers) {
+		// a QPicture plays back from a buffer it shares with its copies, so each job gets its own
+		QPicture picture;
+		picture.setData(layer.picture.constData(), layer.picture.size());
+		painter.setTransform(layer.transform * job.transform);
+		painter.setOpacity(layer.opacity);
+		picture.play(&painter);
+	}
+	painter.end();
+
+	image.setDevicePixelRatio(job.devicePixelRatio);
+	return image;
+}
+
+}
+
+bool TileCache::TileKey::operator==(const TileKey & other) const
+{
+	return owner == other.owner && scaleX == other.scaleX && scaleY == other.scaleY
+	       && devicePixelRatio == other.devicePixelRatio && column == other.column && row == other.row;
+}
+
+size_t qHash(const TileCache::TileKey & key, size_t seed)
+{
+	return qHashMulti(seed, key.owner, key.scaleX, key.scaleY, key.devicePixelRatio, key.column, key.row);
+}
+
+bool TileCache::CachedItem::sameLook(const CachedItem & other) const
+{
+	return rect == other.rect && boundingRect == other.boundingRect && transform == other.transform && z == other.z
+	       && opacity == other.opacity && contentSerial == other.contentSerial && inactive == other.inactive;
+}
+
+/////////////////////////////////////////////////////
+
+TileCache::TileCache(QGraphicsView * view) : QObject(view), m_view(view)
+{
+	// leave a core for the gui thread
+	m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
+	m_settleTimer.setSingleShot(true);
+	m_settleTimer.setInterval(SettleDelay);
+	connect(&m_settleTimer, SIGNAL(timeout()), this, SLOT(settle()));
+}
+
+TileCache::~TileCache()
+{
+	// finished tiles report back to this object, so wait for the running ones
+	m_threadPool.clear();
+	m_threadPool.waitForDone();
+	clear();
+}
+
+void TileCache::setEnabled(bool enabled)
+{
+	if (m_enabled == enabled) return;
+
+	m_enabled = enabled;
+	clear();
+	if (m_view->scene() == nullptr) return;
+
+	// while anything listens to changed(), QGraphicsScene stops sending updates straight to the views,
+	// so only listen while the cache is on
+	if (enabled) {
+		connect(m_view->scene(), SIGNAL(changed(const QList<QRectF> &)), this, SLOT(sceneChanged(const QList<QRectF> &)));
+	}
+	else {
+		disconnect(m_view->scene(), SIGNAL(changed(const QList<QRectF> &)), this, SLOT(sceneChanged(const QList<QRectF> &)));
+	}
+	m_view->viewport()->update();
+}
+
+bool TileCache::isEnabled() const
+{
+	return m_enabled;
+}
+
+void TileCache::clear()
+{
+	m_threadPool.clear();
+	m_settleTimer.stop();
+	m_pending.clear();
+	m_changed.clear();
+	m_candidates.clear();
+	m_known.clear();
+	m_cached.clear();
+	m_cachedOrder.clear();
+	m_active = false;
+	m_dirty = true;
+	m_fullScan = true;
+
+	Q_FOREACH (const TileKey & key, Tiles.keys()) {
+		if (key.owner == this) Tiles.remove(key);
+	}
+}
+
+bool TileCache::paintedFromTiles(const ItemBase * itemBase) const
+{
+	if (!m_active) return false;
+
+	auto it = m_cached.constFind(itemBase);
+	return it != m_cached.constEnd() && it.value().item == itemBase;
+}
+
+void TileCache::sceneChanged(const QList<QRectF> & region)
+{
+	m_changed.append(region);
+	m_dirty = true;
+}
+
+void TileCache::settle()
+{
+	// parts that were moving have stopped: take them back into the tiles
+	m_dirty = true;
+	refresh();
+	requestVisible();
+}
+
+bool TileCache::cacheable(ItemBase * itemBase) const
+{
+	if (qobject_cast<PaletteItemBase *>(itemBase) == nullptr) return false;
+	if (!itemBase->isVisible() || itemBase->hidden() || itemBase->layerHidden()) return false;
+	if (itemBase->fsvgRenderer() == nullptr) return false;
+	if (itemBase->effectiveOpacity() <= 0) return false;
+
+	// hover highlights are painted under the body
+	if (itemBase->inHover() && itemBase->layerKinChief()->paintsHover()) return false;
+
+	return true;
+}
+
+void TileCache::discover(const QRectF & sceneRect, bool fresh)
+{
+	QList<QGraphicsItem *> items = sceneRect.isNull() ? m_view->scene()->items() : m_view->scene()->items(sceneRect, Qt::IntersectsItemBoundingRect);
+	Q_FOREACH (QGraphicsItem * item, items) {
+		if (item->parentItem() != nullptr) continue;
+
+		auto * itemBase = qobject_cast<ItemBase *>(item->toGraphicsObject());
+		if (itemBase == nullptr || m_known.contains(itemBase)) continue;
+
+		m_known.insert(itemBase);
+		Candidate candidate;
+		candidate.item = itemBase;
+		candidate.transform = itemBase->sceneTransform();
+		candidate.fresh = fresh;
+		m_candidates.append(candidate);
+	}
+}
+
+void TileCache::refresh()
+{
+	if (!m_dirty || !m_enabled || m_view->scene() == nullptr) return;
+
+	m_dirty = false;
+
+	// forget deleted parts before looking for new ones, which may have the same address
+	m_known.clear();
+	for (int i = m_candidates.count() - 1; i >= 0; i--) {
+		ItemBase * itemBase = m_candidates.at(i).item.data();
+		if (itemBase == nullptr || itemBase->scene() != m_view->scene()) m_candidates.removeAt(i);
+		else m_known.insert(itemBase);
+	}
+
+	if (m_fullScan) {
+		m_fullScan = false;
+		m_changed.clear();
+		discover(QRectF(), false);
+	}
+	else {
+		Q_FOREACH (const QRectF & rect, m_changed) {
+			discover(rect, true);
+		}
+		m_changed.clear();
+	}
+
+	std::stable_sort(m_candidates.begin(), m_candidates.end(), [](const Candidate & c1, const Candidate & c2) {
+		return c1.item->zValue() < c2.item->zValue();
+	});
+
+	// going up the stack, a part can only come from the tiles if nothing painted live is under it
+	LiveRegion live;
+	QHash<const ItemBase *, CachedItem> cached;
+	QList<const ItemBase *> cachedOrder;
+	bool unsettled = false;
+	for (auto & candidate : m_candidates) {
+		ItemBase * itemBase = candidate.item.data();
+		QTransform transform = itemBase->sceneTransform();
+		bool moving = candidate.fresh || transform != candidate.transform;
+		candidate.fresh = false;
+		candidate.transform = transform;
+
+		QRectF rect = itemBase->sceneBoundingRect();
+		QRectF childrenRect = itemBase->mapRectToScene(itemBase->childrenBoundingRect());
+		if (moving || !cacheable(itemBase) || live.intersects(rect)) {
+			if (itemBase->isVisible()) {
+				live.add(rect.united(childrenRect));
+			}
+			unsettled = unsettled || moving;
+			continue;
+		}
+
+		CachedItem cachedItem;
+		cachedItem.item = itemBase;
+		cachedItem.rect = rect;
+		cachedItem.boundingRect = itemBase->boundingRect();
+		cachedItem.transform = transform;
+		cachedItem.z = itemBase->zValue();
+		cachedItem.opacity = itemBase->effectiveOpacity();
+		cachedItem.contentSerial = itemBase->fsvgRenderer()->contentSerial();
+		cachedItem.inactive = itemBase->inactive();
+		cached.insert(itemBase, cachedItem);
+		cachedOrder.append(itemBase);
+
+		// connectors and the selection outline are still painted live, over the body
+		live.add(childrenRect);
+		if (itemBase->isSelected()) live.add(rect);
+	}
+
+	QList<QRectF> invalid;
+	for (auto it = m_cached.constBegin(); it != m_cached.constEnd(); ++it) {
+		auto found = cached.find(it.key());
+		if (found == cached.end() || found.value().item != it.value().item || !found.value().sameLook(it.value())) {
+			invalid.append(it.value().rect);
+			continue;
+		}
+		found.value().picture = it.value().picture;
+	}
+	for (auto it = cached.constBegin(); it != cached.constEnd(); ++it) {
+		auto found = m_cached.constFind(it.key());
+		if (found == m_cached.constEnd() || found.value().item != it.value().item || !found.value().sameLook(it.value())) {
+			invalid.append(it.value().rect);
+		}
+	}
+
+	m_cached = cached;
+	m_cachedOrder = cachedOrder;
+	invalidate(invalid);
+
+	if (unsettled) m_settleTimer.start();
+}
+
+void TileCache::invalidate(const QList<QRectF> & sceneRects)
+{
+	if (sceneRects.isEmpty()) return;
+
+	Q_FOREACH (const TileKey & key, Tiles.keys()) {
+		if (key.owner != this) continue;
+
+		QRectF tileRect = tileSceneRect(key);
+		Q_FOREACH (const QRectF & rect, sceneRects) {
+			if (rect.intersects(tileRect)) {
+				Tiles.remove(key);
+				break;
+			}
+		}
+	}
+
+	// tiles still being rendered are dropped when they arrive
+	for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+		QRectF tileRect = tileSceneRect(it.key());
+		bool hit = false;
+		Q_FOREACH (const QRectF & rect, sceneRects) {
+			if (rect.intersects(tileRect)) {
+				hit = true;
+				break;
+			}
+		}
+		if (hit) it = m_pending.erase(it);
+		else ++it;
+	}
+}
+
+void TileCache::ensurePicture(CachedItem & cachedItem)
+{
+	if (!cachedItem.picture.isEmpty() || cachedItem.item.isNull()) return;
+
+	// record the body only: without a widget paint() doesn't skip it, and nothing is hovered or selected
+	QStyleOptionGraphicsItem option;
+	option.exposedRect = cachedItem.boundingRect;
+	option.rect = cachedItem.boundingRect.toAlignedRect();
+
+	QPicture picture;
+	QPainter painter(&picture);
+	cachedItem.item->paint(&painter, &option, nullptr);
+	painter.end();
+
+	cachedItem.picture = QByteArray(picture.data(), picture.size());
+}
+
+void TileCache::play(QPainter * painter, const CachedItem & cachedItem)
+{
+	if (cachedItem.picture.isEmpty()) return;
+
+	QPicture picture;
+	picture.setData(cachedItem.picture.constData(), cachedItem.picture.size());
+	QTransform transform = painter->worldTransform();
+	double opacity = painter->opacity();
+	painter->setWorldTransform(cachedItem.transform * transform);
+	painter->setOpacity(cachedItem.opacity);
+	picture.play(painter);
+	painter->setWorldTransform(transform);
+	painter->setOpacity(opacity);
+}
+
+bool TileCache::tileTransform(QTransform & scale, double & devicePixelRatio) const
+{
+	// the views only zoom and mirror
+	scale = m_view->transform();
+	if (scale.type() > QTransform::TxScale) return false;
+
+	scale = QTransform::fromScale(scale.m11(), scale.m22());
+	devicePixelRatio = m_view->viewport()->devicePixelRatioF();
+	return true;
+}
+
+QRectF TileCache::tileSceneRect(const TileKey & key) const
+{
+	QTransform scale = QTransform::fromScale(key.scaleX, key.scaleY);
+	return scale.inverted().mapRect(QRectF(key.column * TileSize, key.row * TileSize, TileSize, TileSize));
+}
+
+void TileCache::requestTile(const TileKey & key)
+{
+	if (m_pending.contains(key) || Tiles.contains(key)) return;
+
+	QRectF sceneRect = tileSceneRect(key);
+	TileJob job;
+	job.transform = QTransform::fromScale(key.scaleX, key.scaleY)
+	                * QTransform::fromTranslate(-key.column * TileSize, -key.row * TileSize)
+	                * QTransform::fromScale(key.devicePixelRatio, key.devicePixelRatio);
+	job.pixels = qRound(TileSize * key.devicePixelRatio);
+	job.devicePixelRatio = key.devicePixelRatio;
+	job.renderHints = m_view->renderHints();
+	Q_FOREACH (const ItemBase * itemBase, m_cachedOrder) {
+		CachedItem & cachedItem = m_cached[itemBase];
+		if (!cachedItem.rect.intersects(sceneRect)) continue;
+
+		ensurePicture(cachedItem);
+		TileLayer layer;
+		layer.picture = cachedItem.picture;
+		layer.transform = cachedItem.transform;
+		layer.opacity = cachedItem.opacity;
+		job.layers.append(layer);
+	}
+
+	if (job.layers.isEmpty()) {
+		// nothing cached here: remember that, so the tile isn't asked for again
+		Tiles.insert(key, new QPixmap(), 1);
+		return;
+	}
+
+	quint64 jobID = ++m_nextJobID;
+	m_pending.insert(key, jobID);
+	(void) QtConcurrent::run(&m_threadPool, [this, key, jobID, job]() {
+		QImage image = renderTile(job);
+		QMetaObject::invokeMethod(this, [this, key, jobID, image]() {
+			tileReady(key, jobID, image);
+		}, Qt::QueuedConnection);
+	});
+}
+
+void TileCache::tileReady(const TileKey & key, quint64 jobID, const QImage & image)
+{
+	auto it = m_pending.constFind(key);
+	if (it == m_pending.constEnd() || it.value() != jobID) return;
+
+	// the tile looks just like what was played back in its place, so there is nothing to repaint
+	m_pending.remove(key);
+	qint64 bytes = (qint64) image.width() * image.height() * 4;
+	Tiles.insert(key, new QPixmap(QPixmap::fromImage(image)), qMax<qint64>(1, bytes / 1024));
+}
+
+void TileCache::requestVisible()
+{
+	if (!m_enabled || m_cached.isEmpty()) return;
+
+	QTransform scale;
+	double devicePixelRatio;
+	if (!tileTransform(scale, devicePixelRatio)) return;
+
+	QRectF sceneRect = m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+	QRectF deviceRect = scale.mapRect(sceneRect);
+	TileKey key;
+	key.owner = this;
+	key.scaleX = scale.m11();
+	key.scaleY = scale.m22();
+	key.devicePixelRatio = devicePixelRatio;
+	int left = (int) std::floor(deviceRect.left() / TileSize) - 1;
+	int top = (int) std::floor(deviceRect.top() / TileSize) - 1;
+	int right = (int) std::floor(deviceRect.right() / TileSize) + 1;
+	int bottom = (int) std::floor(deviceRect.bottom() / TileSize) + 1;
+	for (key.row = top; key.row <= bottom; key.row++) {
+		for (key.column = left; key.column <= right; key.column++) {
+			requestTile(key);
+		}
+	}
+}
+
+void TileCache::draw(QPainter * painter, const QRectF & exposed)
+{
+	// printing and exporting paint everything live
+	m_active = false;
+	if (!m_enabled || painter->device() != m_view->viewport()) return;
+
+	QTransform scale;
+	double devicePixelRatio;
+	if (!tileTransform(scale, devicePixelRatio)) return;
+
+	refresh();
+	m_active = true;
+	if (m_cached.isEmpty()) return;
+
+	TileKey key;
+	key.owner = this;
+	key.scaleX = scale.m11();
+	key.scaleY = scale.m22();
+	key.devicePixelRatio = devicePixelRatio;
+	if (key.scaleX != m_lastScale.scaleX || key.scaleY != m_lastScale.scaleY || key.devicePixelRatio != m_lastScale.devicePixelRatio) {
+		// zoomed: tiles queued for the previous zoom level won't be looked at any more
+		m_threadPool.clear();
+		m_pending.clear();
+		m_lastScale = key;
+	}
+
+	// the tile grid is fixed in the scene; scrolling only moves it
+	QTransform viewportTransform = painter->worldTransform();
+	QTransform offset = QTransform::fromTranslate(viewportTransform.dx() - scale.dx(), viewportTransform.dy() - scale.dy());
+	QRectF deviceRect = scale.mapRect(exposed);
+	int left = (int) std::floor(deviceRect.left() / TileSize);
+	int top = (int) std::floor(deviceRect.top() / TileSize);
+	int right = (int) std::floor(deviceRect.right() / TileSize);
+	int bottom = (int) std::floor(deviceRect.bottom() / TileSize);
+
+	QRegion missing;
+	painter->save();
+	painter->setWorldTransform(offset);
+	for (key.row = top; key.row <= bottom; key.row++) {
+		for (key.column = left; key.column <= right; key.column++) {
+			QPixmap * pixmap = Tiles.object(key);
+			if (pixmap == nullptr) {
+				missing += QRect(key.column * TileSize, key.row * TileSize, TileSize, TileSize);
+				requestTile(key);
+			}
+			else if (!pixmap->isNull()) {
+				painter->drawPixmap(QPointF(key.column * TileSize, key.row * TileSize), *pixmap);
+			}
+		}
+	}
+	painter->restore();
+
+	if (!missing.isEmpty()) {
+		painter->save();
+		painter->setWorldTransform(offset);
+		painter->setClipRegion(missing, Qt::IntersectClip);
+		painter->setWorldTransform(viewportTransform);
+		QRectF missingRect = scale.inverted().mapRect(QRectF(missing.boundingRect())).intersected(exposed);
+		Q_FOREACH (const ItemBase * itemBase, m_cachedOrder) {
+			CachedItem & cachedItem = m_cached[itemBase];
+			if (!cachedItem.rect.intersects(missingRect)) continue;
+
+			ensurePicture(cachedItem);
+			play(painter, cachedItem);
+		}
+		painter->restore();
+	}
+
+	// get ready for panning
+	for (key.row = top - 1; key.row <= bottom + 1; key.row++) {
+		for (key.column = left - 1; key.column <= right + 1; key.column++) {
+			requestTile(key);
+		}
+	}
+}
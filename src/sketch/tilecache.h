@@ -0,0 +1,137 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QGraphicsView>
+#include <QHash>
+#include <QList>
+#include <QPixmap>
+#include <QPointer>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QTransform>
+
+class ItemBase;
+
+// Paints the static parts of a sketch from pre-rendered tiles, so that panning and zooming
+// doesn't have to run every part's svg through QSvgRenderer again for each frame.
+//
+// A part comes from the tiles when it isn't moving, doesn't paint a hover highlight, and nothing
+// painted live lies under it. Connectors and selection outlines are always painted live, so in
+// practice that is the breadboard or board at the bottom of the sketch, and parts standing on
+// their own. Their bodies are recorded once as QPictures and played back into 256 pixel tiles
+// per zoom level on a thread pool; the tiles are drawn under everything else in drawBackground().
+// QGraphicsScene::changed() says where to look for parts that were added, changed or started to
+// move, and the tiles under them are thrown away. Until a tile arrives its area is played back
+// directly from the pictures, which costs what painting the parts live would.
+
+class TileCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	TileCache(QGraphicsView *);
+	~TileCache();
+
+	void setEnabled(bool);
+	bool isEnabled() const;
+	void draw(QPainter *, const QRectF & exposed);
+	bool paintedFromTiles(const ItemBase *) const;
+	void clear();
+
+	static const int TileSize;
+
+protected Q_SLOTS:
+	void sceneChanged(const QList<QRectF> & region);
+	void settle();
+
+protected:
+	struct TileKey {
+		const TileCache * owner = nullptr;
+		double scaleX = 1;
+		double scaleY = 1;
+		double devicePixelRatio = 1;
+		int column = 0;
+		int row = 0;
+
+		bool operator==(const TileKey & other) const;
+	};
+	friend size_t qHash(const TileKey &, size_t seed);
+
+	struct Candidate {
+		QPointer<ItemBase> item;
+		QTransform transform;
+		bool fresh = true;			// not seen by refresh() yet
+	};
+
+	struct CachedItem {
+		QPointer<ItemBase> item;
+		QRectF rect;
+		QRectF boundingRect;
+		QTransform transform;
+		double z = 0;
+		double opacity = 1;
+		quint64 contentSerial = 0;
+		bool inactive = false;
+		QByteArray picture;			// QPicture data, recorded when first needed
+
+		bool sameLook(const CachedItem & other) const;
+	};
+
+	void refresh();
+	void discover(const QRectF & sceneRect, bool fresh);
+	bool cacheable(ItemBase *) const;
+	void invalidate(const QList<QRectF> & sceneRects);
+	void ensurePicture(CachedItem &);
+	void play(QPainter *, const CachedItem &);
+	QRectF tileSceneRect(const TileKey &) const;
+	void requestTile(const TileKey &);
+	void requestVisible();
+	void tileReady(const TileKey &, quint64 jobID, const QImage &);
+	bool tileTransform(QTransform & scale, double & devicePixelRatio) const;
+
+protected:
+	QGraphicsView * m_view = nullptr;
+	bool m_enabled = false;
+	bool m_active = false;			// the last viewport paint used the tiles
+	bool m_dirty = false;
+	bool m_fullScan = true;
+	QList<QRectF> m_changed;
+	QList<Candidate> m_candidates;
+	QSet<const ItemBase *> m_known;
+	QHash<const ItemBase *, CachedItem> m_cached;
+	QList<const ItemBase *> m_cachedOrder;		// ascending z
+	QHash<TileKey, quint64> m_pending;
+	quint64 m_nextJobID = 0;
+	TileKey m_lastScale;
+	QThreadPool m_threadPool;
+	QTimer m_settleTimer;
+
+	static QCache<TileKey, QPixmap> Tiles;		// shared by all views, cost in kilobytes
+	static const int MaxCost;
+	static const int SettleDelay;
+};
+
+#endif
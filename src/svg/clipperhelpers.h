@@ -29,6 +29,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPaintEngine>
 #include <fstream>
 
+#include "contourtracer.h"
+
 inline ClipperLib::JoinType qtToClipperJoinType(Qt::PenJoinStyle style) {
 	switch (style) {
 		case Qt::MiterJoin:
@@ -141,38 +143,8 @@ inline void clipperPathsToSVGFile(ClipperLib::Paths &paths, double clipperDPI, Q
 }
 
 inline QString imageToSVGPath(QImage &image, double res) {
-	// ClipperLib::Paths vectorized;
-	ClipperLib::Clipper cp;
-	ClipperLib::Paths lineSpans;
-
-	// bool isIndexed = (image.format() == QImage::Format_Indexed8);
-
-	for (int j = 0; j < image.height(); j++) {
-		bool previousPix = false;
-		int startIndex = 0;
-		for (int i = 0; i < image.width(); i++) {
-			bool pix = qGray(image.pixel(i, j)) != 0;
-			if (pix != previousPix || i == image.width() - 1) {
-				if (pix ^ (i == image.width() - 1)) {
-					startIndex = i;
-				} else {
-					ClipperLib::Path span;
-					span << ClipperLib::IntPoint(startIndex, j)
-						 << ClipperLib::IntPoint(i, j)
-						 << ClipperLib::IntPoint(i, j + 1)
-						 << ClipperLib::IntPoint(startIndex, j + 1);
-
-					lineSpans << span;
-				}
-			}
-			previousPix = pix;
-		}
-	}
-
-	cp.AddPaths(lineSpans, ClipperLib::ptSubject, true);
-	// cp.AddPaths(vectorized, ClipperLib::ptClip, true);
-	ClipperLib::Paths result;
-	cp.Execute(ClipperLib::ctUnion, result, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+	// the outlines of the non-black pixels, the same area as a union of one square per pixel
+	ClipperLib::Paths result = ContourTracer::trace(image);
 	return clipperPathsToSVG(result, res, false);
 }
 
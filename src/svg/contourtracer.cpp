@@ -0,0 +1,259 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "contourtracer.h"
+
+#include <QVector>
+
+#include <cmath>
+#include <vector>
+
+using namespace ClipperLib;
+
+namespace {
+
+// outgoing edge directions at a pixel corner, in clockwise order (y points down)
+enum Direction : uchar {
+	Right = 1,
+	Down = 2,
+	Left = 4,
+	Up = 8,
+};
+
+constexpr uchar Remaining = 0x0f;
+
+inline uchar clockwise(uchar direction)
+{
+	return direction == Up ? Right : (uchar) (direction << 1);
+}
+
+inline bool isSaddle(uchar directions)
+{
+	return directions == (Right | Left) || directions == (Down | Up);
+}
+
+// one byte per pixel of the row, 1 where qGray(image.pixel(x, y)) != 0
+void readRow(const QImage & image, int y, const QVector<uchar> & colorLookup, uchar * row)
+{
+	const int width = image.width();
+	const uchar * line = image.constScanLine(y);
+	switch (image.format()) {
+	case QImage::Format_Mono:
+		for (int x = 0; x < width; x++) {
+			row[x] = colorLookup[(line[x >> 3] >> (7 - (x & 7))) & 1];
+		}
+		break;
+	case QImage::Format_MonoLSB:
+		for (int x = 0; x < width; x++) {
+			row[x] = colorLookup[(line[x >> 3] >> (x & 7)) & 1];
+		}
+		break;
+	case QImage::Format_Indexed8:
+		for (int x = 0; x < width; x++) {
+			row[x] = colorLookup[line[x]];
+		}
+		break;
+	case QImage::Format_Grayscale8:
+		for (int x = 0; x < width; x++) {
+			row[x] = line[x] != 0;
+		}
+		break;
+	default: {
+		// RGB32 or ARGB32; trace() converts anything else
+		auto * pixels = reinterpret_cast<const QRgb *>(line);
+		for (int x = 0; x < width; x++) {
+			row[x] = qGray(pixels[x]) != 0;
+		}
+		break;
+	}
+	}
+}
+
+double distanceToLine(const IntPoint & p, const IntPoint & a, const IntPoint & b)
+{
+	double dx = (double) (b.X - a.X);
+	double dy = (double) (b.Y - a.Y);
+	double length = std::hypot(dx, dy);
+	if (length == 0) return std::hypot((double) (p.X - a.X), (double) (p.Y - a.Y));
+
+	return std::abs(dx * (double) (a.Y - p.Y) - dy * (double) (a.X - p.X)) / length;
+}
+
+// Douglas-Peucker over path[first..last], marking the points to keep
+void simplifyRange(const Path & path, size_t first, size_t last, double tolerance, std::vector<bool> & keep)
+{
+	std::vector<std::pair<size_t, size_t>> stack;
+	stack.emplace_back(first, last);
+	while (!stack.empty()) {
+		auto [from, to] = stack.back();
+		stack.pop_back();
+
+		double farthest = 0;
+		size_t index = from;
+		for (size_t i = from + 1; i < to; i++) {
+			double distance = distanceToLine(path[i % path.size()], path[from], path[to % path.size()]);
+			if (distance > farthest) {
+				farthest = distance;
+				index = i;
+			}
+		}
+		if (farthest <= tolerance) continue;
+
+		keep[index % path.size()] = true;
+		stack.emplace_back(from, index);
+		stack.emplace_back(index, to);
+	}
+}
+
+Path smoothStaircases(const Path & path, double tolerance)
+{
+	if (path.size() <= 4) return path;
+
+	// split the closed outline at its first point and the point farthest away from it
+	size_t opposite = 0;
+	double farthest = -1;
+	for (size_t i = 1; i < path.size(); i++) {
+		double distance = std::hypot((double) (path[i].X - path[0].X), (double) (path[i].Y - path[0].Y));
+		if (distance > farthest) {
+			farthest = distance;
+			opposite = i;
+		}
+	}
+
+	std::vector<bool> keep(path.size(), false);
+	keep[0] = keep[opposite] = true;
+	simplifyRange(path, 0, opposite, tolerance, keep);
+	simplifyRange(path, opposite, path.size(), tolerance, keep);
+
+	Path result;
+	for (size_t i = 0; i < path.size(); i++) {
+		if (keep[i]) result.push_back(path[i]);
+	}
+	return result;
+}
+
+}
+
+Paths ContourTracer::trace(const QImage & sourceImage, int simplification, double staircaseTolerance)
+{
+	Paths paths;
+	if (sourceImage.isNull()) return paths;
+
+	QImage image = sourceImage;
+	QVector<uchar> colorLookup;
+	switch (image.format()) {
+	case QImage::Format_Mono:
+	case QImage::Format_MonoLSB:
+	case QImage::Format_Indexed8:
+		colorLookup.fill(0, 256);
+		for (int i = 0; i < image.colorCount() && i < 256; i++) {
+			colorLookup[i] = qGray(image.color(i)) != 0;
+		}
+		break;
+	case QImage::Format_Grayscale8:
+	case QImage::Format_RGB32:
+	case QImage::Format_ARGB32:
+		break;
+	default:
+		image = image.convertToFormat(QImage::Format_ARGB32);
+		break;
+	}
+
+	const int width = image.width();
+	const int height = image.height();
+
+	// pixels with a blank border, so that every corner sees four of them
+	const size_t pixelStride = (size_t) width + 2;
+	std::vector<uchar> pixels(pixelStride * ((size_t) height + 2), 0);
+	for (int y = 0; y < height; y++) {
+		readRow(image, y, colorLookup, &pixels[(y + 1) * pixelStride + 1]);
+	}
+
+	// at each corner, the boundary edges leaving it with the set pixels on their right:
+	// the low nibble is what is left to trace, the high nibble what was there to begin with
+	const size_t cornerStride = (size_t) width + 1;
+	std::vector<uchar> corners(cornerStride * ((size_t) height + 1), 0);
+	for (int y = 0; y <= height; y++) {
+		const uchar * above = &pixels[y * pixelStride];
+		const uchar * below = above + pixelStride;
+		uchar * corner = &corners[y * cornerStride];
+		for (int x = 0; x <= width; x++) {
+			uchar topLeft = above[x], topRight = above[x + 1];
+			uchar bottomLeft = below[x], bottomRight = below[x + 1];
+			uchar directions = 0;
+			if (bottomRight && !topRight) directions |= Right;
+			if (bottomLeft && !bottomRight) directions |= Down;
+			if (topLeft && !bottomLeft) directions |= Left;
+			if (topRight && !topLeft) directions |= Up;
+			corner[x] = (uchar) (directions | (directions << 4));
+		}
+	}
+	pixels = std::vector<uchar>();
+
+	const bool removeCollinear = (simplification & RemoveCollinear) != 0;
+	for (int startY = 0; startY <= height; startY++) {
+		for (int startX = 0; startX <= width; startX++) {
+			uchar & startCorner = corners[startY * cornerStride + startX];
+			while (startCorner & Remaining) {
+				uchar remaining = startCorner & Remaining;
+				const uchar start = remaining & -remaining;
+
+				Path path;
+				int x = startX;
+				int y = startY;
+				uchar in = 0;
+				uchar out = start;
+				while (true) {
+					uchar & corner = corners[y * cornerStride + x];
+					if (in != 0) {
+						// at a saddle keep turning right, which keeps diagonal neighbors apart
+						uchar directions = corner >> 4;
+						out = isSaddle(directions) ? clockwise(in) : directions;
+						if (x == startX && y == startY && out == start) break;
+					}
+
+					corner &= (uchar) ~out;
+					if (!removeCollinear || out != in) {
+						path.push_back(IntPoint(x, y));
+					}
+
+					switch (out) {
+					case Right: x++; break;
+					case Down: y++; break;
+					case Left: x--; break;
+					default: y--; break;
+					}
+					in = out;
+				}
+
+				// the start corner may sit in the middle of a straight edge
+				if (removeCollinear && in == start && path.size() > 1) {
+					path.erase(path.begin());
+				}
+				if (simplification & SmoothStaircases) {
+					path = smoothStaircases(path, staircaseTolerance);
+				}
+				if (path.size() >= 3) paths.push_back(path);
+			}
+		}
+	}
+
+	return paths;
+}
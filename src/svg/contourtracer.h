@@ -0,0 +1,48 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef CONTOURTRACER_H
+#define CONTOURTRACER_H
+
+#include <clipper.hpp>
+#include <QImage>
+
+// Traces the outlines of the set pixels of an image (those with a non-zero gray value)
+// by marching squares over the pixel corners.
+//
+// The result covers exactly the same area as a Clipper union of one square per set pixel,
+// in pixel coordinates and with the same orientation: outer boundaries have a positive area,
+// holes a negative one, so nested islands come out right with a nonzero fill rule.
+// Diagonally touching pixels are kept as separate outlines.
+
+class ContourTracer
+{
+public:
+	enum Simplification {
+		KeepAllPoints = 0,
+		RemoveCollinear = 1,	// lossless: only the corners of each outline
+		SmoothStaircases = 2,	// lossy: Douglas-Peucker within staircaseTolerance pixels
+	};
+
+public:
+	static ClipperLib::Paths trace(const QImage & image, int simplification = RemoveCollinear, double staircaseTolerance = 0.5);
+};
+
+#endif
@@ -34,6 +34,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/folderutils.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/textutils.h"
+#include "../utils/FTimingProbe.h"
 #include "../version/version.h"
 #include "items/groundplane.h"
 #include "groundplanegeneratorold.h"
@@ -79,6 +80,7 @@ bool pixelsCollide(QImage * image1, QImage * image2, int x1, int y1, int x2, int
 
 void GerberGenerator::exportToGerber(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes)
 {
+	FTimingScope timingScope("gerber");
 	if (board == nullptr) {
 		int boardCount = 0;
 		board = sketchWidget->findSelectedBoard(boardCount);
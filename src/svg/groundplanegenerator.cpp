@@ -42,6 +42,11 @@ using boost::math::epsilon_difference;
 
 #include <limits>
 #include <QtConcurrentRun>
+#include <QtConcurrentMap>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 using namespace ClipperLib;
 
@@ -49,7 +54,30 @@ using namespace ClipperLib;
 const QString GroundPlaneGenerator::KeepoutSettingName("GPG_Keepout");
 const double GroundPlaneGenerator::KeepoutDefaultMils = 10;
 
-static QList<Paths> convertCopperPolygonsToGroundPlane(Paths nonCopper, Paths thermalReliefPads, double pixelFactor, double keepoutMils, QPointF *seedPoint);
+const double GroundPlaneGenerator::TileInches = 1.0;
+const double GroundPlaneGenerator::BorderMils = 30;
+
+struct GroundFillTile {
+	IntRect core;
+	IntRect margin;
+	double clipperDPI;
+	double keepoutMils;
+	Paths copper;
+	Paths board;
+	Paths groundConnectorsZone;
+	Paths groundThermalConnectors;
+};
+
+static Paths fillTile(const GroundFillTile &);
+static QVector<IntRect> pathBounds(const Paths & paths);
+static void collectPaths(const Paths & paths, const QVector<IntRect> & bounds, const IntRect & rect, Paths & result);
+static void sortPolygons(PolyTree &tree, QList<Paths> &polygons);
+static Paths findPolygonForPoint(PolyTree &tree, IntPoint seedPoint);
+
+// tile results keyed by a hash of the geometry in (and around) the tile, so refilling after a local edit
+// only recomputes the tiles that edit touched; the cost is counted in points
+static QMutex TileCacheMutex;
+static QCache<QByteArray, Paths> TileCache(4 * 1024 * 1024);
 
 class GroundPlanePaintDevice;
 
@@ -88,12 +116,15 @@ public:
 		return User;
 	}
 
-	Paths grabCopper() {
-		Clipper cp;
-		Paths result;
-		cp.AddPaths(clipperPaths, ptSubject, true);
-		cp.Execute(ctUnion, result, pftNonZero, pftNonZero);
-		return result;
+	// not unioned: each draw call is already normalized to nonzero winding, so the tiles
+	// can union just the paths they need with a single intersection
+	const Paths & grabCopper() const {
+		return clipperPaths;
+	}
+
+	void append(Paths & paths, PolyFillType fillType) {
+		SimplifyPolygons(paths, fillType);
+		clipperPaths.insert(clipperPaths.end(), paths.begin(), paths.end());
 	}
 
 private:
@@ -115,7 +146,7 @@ public:
 		return groundPlaneEngine;
 	}
 
-	Paths grabCopper() const {
+	const Paths & grabCopper() const {
 		return groundPlaneEngine->grabCopper();
 	}
 
@@ -160,18 +191,12 @@ void GroundPlanePaintEngine::drawPath(const QPainterPath &path) {
 	QList<QPolygonF> polygons = path.toSubpathPolygons();
 	if (hasBrush) {
 		Paths paths = polygonsToClipper(polygons, state->transform());
-		Clipper cp;
-		cp.AddPaths(clipperPaths, ptSubject, true);
-		cp.AddPaths(paths, ptClip, true);
-		cp.Execute(ctUnion, clipperPaths, pftNonZero, pftNonZero);
+		append(paths, pftNonZero);
 	}
 	if (hasPen && state->pen().widthF() != 0) {
 		QPainterPath stroke = QPainterPathStroker(state->pen()).createStroke(path);
 		Paths strokePath = polygonsToClipper(stroke.toFillPolygons(), state->transform());
-		Clipper cp;
-		cp.AddPaths(clipperPaths, ptSubject, true);
-		cp.AddPaths(strokePath, ptClip, true);
-		cp.Execute(ctUnion, clipperPaths, pftNonZero, stroke.fillRule() == Qt::OddEvenFill ? pftEvenOdd : pftNonZero);
+		append(strokePath, stroke.fillRule() == Qt::OddEvenFill ? pftEvenOdd : pftNonZero);
 	}
 }
 
@@ -187,10 +212,7 @@ void GroundPlanePaintEngine::drawPolygon(const QPointF *points, int pointCount,
 	ClipperOffset co;
 	co.AddPath(path, qtToClipperJoinType(state->pen().joinStyle()), qtToClipperEndType(state->pen().capStyle(), mode == QPaintEngine::PolylineMode, hasBrush));
 	co.Execute(result, hasPen ? state->pen().widthF() / 2 / GraphicsUtils::StandardFritzingDPI * dynamic_cast<GroundPlanePaintDevice *>(paintDevice())->dpi : 0);
-	Clipper cp;
-	cp.AddPaths(clipperPaths, ptSubject, true);
-	cp.AddPaths(result, ptClip, true);
-	cp.Execute(ctUnion, clipperPaths, pftNonZero, qtToClipperFillType(mode));
+	append(result, qtToClipperFillType(mode));
 }
 
 GroundPlaneGenerator::GroundPlaneGenerator() {
@@ -271,52 +293,68 @@ bool GroundPlaneGenerator::generateGroundPlaneFn(const GPGParams & constParams)
 	painter.begin(&copperDevice);
 	renderer.render(&painter);
 	painter.end();
-	Paths copper = copperDevice.grabCopper();
 	GroundPlanePaintDevice boardDevice(bWidth, bHeight, clipperDPI);
 	painter.begin(&boardDevice);
 	QSvgRenderer(params.boardSvg.toUtf8()).render(&painter);
 	painter.end();
-	Paths board = boardDevice.grabCopper();
 
-	Clipper cp;
-	Paths copperWithoutGroundConnectors;
-	Paths groundConnectors;
-	cp.AddPaths(copper, ptSubject, true);
-	cp.AddPaths(groundConnectorsZone, ptClip, true);
-	cp.Execute(ctIntersection, groundConnectors, pftNonZero, pftNonZero);
-	cp.Execute(ctDifference, copperWithoutGroundConnectors, pftNonZero, pftNonZero);
+	Paths groundFill = fillTiles(copperDevice.grabCopper(), boardDevice.grabCopper(), groundConnectorsZone, groundThermalConnectors,
+	                             QSizeF(bWidth * clipperDPI, bHeight * clipperDPI), clipperDPI, params.keepoutMils);
 
-	cp.Clear();
-	Paths nonCopper;
-	cp.AddPaths(board, ptSubject, true);
+	// stitch the tiles back together
+	Clipper clipper;
+	PolyTree stitched;
+	clipper.AddPaths(groundFill, ptSubject, true);
+	clipper.Execute(ctUnion, stitched, pftNonZero, pftNonZero);
 
-	double BORDERMILS = 30;
-	double extraOutlineClearance = BORDERMILS - params.keepoutMils;
-	if (extraOutlineClearance > 0) {
-		ClipperOffset co;
-		Paths copperOutlineClearance;
-		co.AddPaths(board, jtRound, ClipperLib::etClosedLine);
-		co.Execute(copperOutlineClearance, extraOutlineClearance / 1000.0 * clipperDPI);
-		cp.AddPaths(copperOutlineClearance, ptClip, true);
+	QList<Paths> groundCopper;
+	if (params.seedPoint == NULL) {
+		sortPolygons(stitched, groundCopper);
+	} else {
+		groundCopper.append(findPolygonForPoint(stitched, IntPoint((cInt) params.seedPoint->x(), (cInt) params.seedPoint->y())));
 	}
+	makeCopperFillFromPolygons(groundCopper, params.res, params.color, true, QSizeF(.05, .05), 1 / GraphicsUtils::SVGDPI);
+	return true;
+}
 
-	cp.AddPaths(copperWithoutGroundConnectors, ptClip, true);
-	cp.Execute(ctDifference, nonCopper, pftNonZero, pftNonZero);
-
-	ClipperOffset co;
-	Paths expandedGroundConnectors;
-	co.AddPaths(groundConnectors, jtRound, etClosedPolygon);
-	co.Execute(expandedGroundConnectors, params.keepoutMils / 1000.0 * clipperDPI);
+Paths GroundPlaneGenerator::fillTiles(const Paths & copper, const Paths & board, const Paths & groundConnectorsZone, const Paths & groundThermalConnectors,
+                                      QSizeF clipperSize, double clipperDPI, double keepoutMils)
+{
+	// how far anything done to a tile can reach: outline clearance, the keepout around copper and thermal pads, then the opening
+	double reachMils = std::max(BorderMils, keepoutMils) + (2 * keepoutMils) + (2 * std::max(keepoutMils / 4.0, 1.0)) + 10;
+	auto margin = (cInt) qCeil(reachMils / 1000 * clipperDPI);
+	auto tileSize = (cInt) qCeil(TileInches * clipperDPI);
+
+	QVector<IntRect> copperBounds = pathBounds(copper);
+	QVector<IntRect> boardBounds = pathBounds(board);
+	QVector<IntRect> zoneBounds = pathBounds(groundConnectorsZone);
+	QVector<IntRect> thermalBounds = pathBounds(groundThermalConnectors);
+
+	QList<GroundFillTile> tiles;
+	for (cInt top = 0; top < (cInt) qCeil(clipperSize.height()); top += tileSize) {
+		for (cInt left = 0; left < (cInt) qCeil(clipperSize.width()); left += tileSize) {
+			GroundFillTile tile;
+			tile.core = IntRect { left, top, left + tileSize, top + tileSize };
+			tile.margin = IntRect { left - margin, top - margin, left + tileSize + margin, top + tileSize + margin };
+			tile.clipperDPI = clipperDPI;
+			tile.keepoutMils = keepoutMils;
+			collectPaths(board, boardBounds, tile.margin, tile.board);
+			if (tile.board.empty()) continue;
+
+			collectPaths(copper, copperBounds, tile.margin, tile.copper);
+			collectPaths(groundConnectorsZone, zoneBounds, tile.margin, tile.groundConnectorsZone);
+			collectPaths(groundThermalConnectors, thermalBounds, tile.margin, tile.groundThermalConnectors);
+			tiles.append(tile);
+		}
+	}
 
-	cp.Clear();
-	Paths thermalReliefPads;
-	cp.AddPaths(expandedGroundConnectors, ptSubject, true);
-	cp.AddPaths(groundThermalConnectors, ptClip, true);
-	cp.Execute(ctDifference, thermalReliefPads, pftNonZero, pftNonZero);
+	QList<Paths> tileFills = QtConcurrent::blockingMapped(tiles, fillTile);
 
-	QList<Paths> groundCopper = convertCopperPolygonsToGroundPlane(nonCopper, thermalReliefPads, clipperDPI, params.keepoutMils, params.seedPoint);
-	makeCopperFillFromPolygons(groundCopper, params.res, params.color, true, QSizeF(.05, .05), 1 / GraphicsUtils::SVGDPI);
-	return true;
+	Paths result;
+	Q_FOREACH (const Paths & tileFill, tileFills) {
+		result.insert(result.end(), tileFill.begin(), tileFill.end());
+	}
+	return result;
 }
 
 void GroundPlaneGenerator::createGroundThermalPads(GPGParams &params, double clipperDPI, Paths &groundConnectorsZone, Paths &groundThermalConnectors) {
@@ -369,7 +407,7 @@ void GroundPlaneGenerator::createGroundThermalPads(GPGParams &params, double cli
 	}
 }
 
-Paths findPolygonForPoint(PolyTree &tree, IntPoint seedPoint) {
+static Paths findPolygonForPoint(PolyTree &tree, IntPoint seedPoint) {
 	PolyNode *foundNode = NULL;
 	for(int i = 0; i < tree.ChildCount(); i++) {
 		if (PointInPolygon(seedPoint, tree.Childs[i]->Contour))
@@ -389,7 +427,7 @@ Paths findPolygonForPoint(PolyTree &tree, IntPoint seedPoint) {
 }
 
 // this sorts a polygon tree to a list<(contour, hole1, hole2, ...)>
-void sortPolygons(PolyTree &tree, QList<Paths> &polygons) {
+static void sortPolygons(PolyTree &tree, QList<Paths> &polygons) {
 	QList<PolyNode *> contours;
 		foreach(PolyNode *initialNode, tree.Childs) {
 			contours.append(initialNode);
@@ -424,13 +462,106 @@ IntPoint findTopLeftMostPoint(Paths &paths) {
 	return pt;
 }
 
-QList<Paths> convertCopperPolygonsToGroundPlane(Paths nonCopper, Paths thermalReliefPads, double clipperDPI, double keepoutMils, QPointF *seedPoint) {
+static Path rectToClipper(const IntRect & rect) {
+	Path path;
+	path << IntPoint(rect.left, rect.top) << IntPoint(rect.right, rect.top) << IntPoint(rect.right, rect.bottom) << IntPoint(rect.left, rect.bottom);
+	return path;
+}
+
+QVector<IntRect> pathBounds(const Paths & paths) {
+	QVector<IntRect> bounds;
+	bounds.reserve((int) paths.size());
+	for (const Path & path : paths) {
+		IntRect rect { std::numeric_limits<cInt>::max(), std::numeric_limits<cInt>::max(), std::numeric_limits<cInt>::min(), std::numeric_limits<cInt>::min() };
+		for (const IntPoint & pt : path) {
+			rect.left = std::min(rect.left, pt.X);
+			rect.top = std::min(rect.top, pt.Y);
+			rect.right = std::max(rect.right, pt.X);
+			rect.bottom = std::max(rect.bottom, pt.Y);
+		}
+		bounds.append(rect);
+	}
+	return bounds;
+}
+
+void collectPaths(const Paths & paths, const QVector<IntRect> & bounds, const IntRect & rect, Paths & result) {
+	for (size_t i = 0; i < paths.size(); i++) {
+		const IntRect & b = bounds.at((int) i);
+		if (b.right < rect.left || b.left > rect.right || b.bottom < rect.top || b.top > rect.bottom) continue;
+
+		result.push_back(paths[i]);
+	}
+}
+
+static void hashPaths(QCryptographicHash & hash, const Paths & paths) {
+	quint64 count = paths.size();
+	hash.addData(QByteArrayView(reinterpret_cast<const char *>(&count), sizeof(count)));
+	for (const Path & path : paths) {
+		count = path.size();
+		hash.addData(QByteArrayView(reinterpret_cast<const char *>(&count), sizeof(count)));
+		hash.addData(QByteArrayView(reinterpret_cast<const char *>(path.data()), (qsizetype) (path.size() * sizeof(IntPoint))));
+	}
+}
+
+// the old whole-board pipeline, restricted to one tile plus enough margin that the core comes out exact
+static Paths fillTileAux(const GroundFillTile & tile) {
+	double clipperDPI = tile.clipperDPI;
+	double keepoutMils = tile.keepoutMils;
+	Path marginRect = rectToClipper(tile.margin);
+
+	// intersecting with the tile also unions the raw paths collected by the paint engine
+	Clipper cp;
+	Paths copper;
+	cp.AddPaths(tile.copper, ptSubject, true);
+	cp.AddPath(marginRect, ptClip, true);
+	cp.Execute(ctIntersection, copper, pftNonZero, pftNonZero);
+
+	cp.Clear();
+	Paths board;
+	cp.AddPaths(tile.board, ptSubject, true);
+	cp.AddPath(marginRect, ptClip, true);
+	cp.Execute(ctIntersection, board, pftNonZero, pftNonZero);
+
+	cp.Clear();
+	Paths copperWithoutGroundConnectors;
+	Paths groundConnectors;
+	cp.AddPaths(copper, ptSubject, true);
+	cp.AddPaths(tile.groundConnectorsZone, ptClip, true);
+	cp.Execute(ctIntersection, groundConnectors, pftNonZero, pftNonZero);
+	cp.Execute(ctDifference, copperWithoutGroundConnectors, pftNonZero, pftNonZero);
+
+	cp.Clear();
+	Paths nonCopper;
+	cp.AddPaths(board, ptSubject, true);
+
+	double extraOutlineClearance = GroundPlaneGenerator::BorderMils - keepoutMils;
+	if (extraOutlineClearance > 0) {
+		ClipperOffset co;
+		Paths copperOutlineClearance;
+		co.AddPaths(board, jtRound, ClipperLib::etClosedLine);
+		co.Execute(copperOutlineClearance, extraOutlineClearance / 1000.0 * clipperDPI);
+		cp.AddPaths(copperOutlineClearance, ptClip, true);
+	}
+
+	cp.AddPaths(copperWithoutGroundConnectors, ptClip, true);
+	cp.Execute(ctDifference, nonCopper, pftNonZero, pftNonZero);
+
+	ClipperOffset co;
+	Paths expandedGroundConnectors;
+	co.AddPaths(groundConnectors, jtRound, etClosedPolygon);
+	co.Execute(expandedGroundConnectors, keepoutMils / 1000.0 * clipperDPI);
+
+	cp.Clear();
+	Paths thermalReliefPads;
+	cp.AddPaths(expandedGroundConnectors, ptSubject, true);
+	cp.AddPaths(tile.groundThermalConnectors, ptClip, true);
+	cp.Execute(ctDifference, thermalReliefPads, pftNonZero, pftNonZero);
+
 	Paths eroded, intermediate, nonCopperMinusKeepout;
-	PolyTree groundFill;
 	CleanPolygons(nonCopper);
 	CleanPolygons(thermalReliefPads);
 
-	ClipperOffset co;
+	co.Clear();
 	co.AddPaths(nonCopper, jtRound, etClosedPolygon);
 	co.Execute(nonCopperMinusKeepout, -keepoutMils / 1000 * clipperDPI);
 
@@ -444,18 +575,46 @@ QList<Paths> convertCopperPolygonsToGroundPlane(Paths nonCopper, Paths thermalRe
 	co.Execute(eroded, cappedKeepoutMils  / 1000 * clipperDPI);
 	CleanPolygons(eroded);
 
-	Clipper clipper;
-	clipper.AddPaths(eroded, ptSubject, true);
-	clipper.AddPaths(thermalReliefPads, ptClip, true);
-	clipper.Execute(ctDifference, groundFill, pftPositive, pftPositive);
+	cp.Clear();
+	Paths groundFill;
+	cp.AddPaths(eroded, ptSubject, true);
+	cp.AddPaths(thermalReliefPads, ptClip, true);
+	cp.Execute(ctDifference, groundFill, pftPositive, pftPositive);
 
-	QList<Paths> sortedPolygons;
-	if (seedPoint == NULL) {
-		sortPolygons(groundFill, sortedPolygons);
-	} else {
-		sortedPolygons.append(findPolygonForPoint(groundFill, IntPoint((cInt) seedPoint->x(), (cInt) seedPoint->y())));
+	cp.Clear();
+	Paths result;
+	cp.AddPaths(groundFill, ptSubject, true);
+	cp.AddPath(rectToClipper(tile.core), ptClip, true);
+	cp.Execute(ctIntersection, result, pftNonZero, pftNonZero);
+	return result;
+}
+
+Paths fillTile(const GroundFillTile & tile) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(QByteArrayView(reinterpret_cast<const char *>(&tile.margin), sizeof(tile.margin)));
+	hash.addData(QByteArrayView(reinterpret_cast<const char *>(&tile.clipperDPI), sizeof(tile.clipperDPI)));
+	hash.addData(QByteArrayView(reinterpret_cast<const char *>(&tile.keepoutMils), sizeof(tile.keepoutMils)));
+	hashPaths(hash, tile.copper);
+	hashPaths(hash, tile.board);
+	hashPaths(hash, tile.groundConnectorsZone);
+	hashPaths(hash, tile.groundThermalConnectors);
+	QByteArray key = hash.result();
+
+	{
+		QMutexLocker locker(&TileCacheMutex);
+		Paths * cached = TileCache.object(key);
+		if (cached) return *cached;
+	}
+
+	Paths result = fillTileAux(tile);
+
+	qsizetype cost = 1;
+	for (const Path & path : result) {
+		cost += (qsizetype) path.size();
 	}
-	return sortedPolygons;
+	QMutexLocker locker(&TileCacheMutex);
+	TileCache.insert(key, new Paths(result), cost);
+	return result;
 }
 
 void GroundPlaneGenerator::makeCopperFillFromPolygons(QList<Paths> &sortedPolygons, double res,
@@ -77,6 +77,8 @@ public:
 protected:
 	bool generateGroundPlaneFn(const GPGParams &);
 	void makeCopperFillFromPolygons(QList<ClipperLib::Paths> &sortedPolygons, double res, const QString &colorString, bool makeConnectorFlag, QSizeF minAreaInches, double minDimensionInches);
+	ClipperLib::Paths fillTiles(const ClipperLib::Paths & copper, const ClipperLib::Paths & board, const ClipperLib::Paths & groundConnectorsZone,
+	                            const ClipperLib::Paths & groundThermalConnectors, QSizeF clipperSize, double clipperDPI, double keepoutMils);
 
 protected:
 	QStringList m_newSVGs;
@@ -90,6 +92,8 @@ protected:
 public:
 	static const QString KeepoutSettingName;
 	static const double KeepoutDefaultMils;
+	static const double TileInches;
+	static const double BorderMils;
 
 	void createGroundThermalPads(GPGParams &params, double clipperDPI, std::vector<ClipperLib::Path> &groundConnectorsZone, std::vector<ClipperLib::Path> &groundThermalConnectors);
 };
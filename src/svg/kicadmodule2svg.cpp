@@ -53,77 +53,89 @@ double checkStrokeWidth(double w) {
 KicadModule2Svg::KicadModule2Svg() : Kicad2Svg() {
 }
 
-QStringList KicadModule2Svg::listModules(const QString & filename) {
-	QStringList modules;
+bool KicadModule2Svg::Library::load(const QString & filename) {
+	this->filename = filename;
+	lines.clear();
+	moduleNames.clear();
+	moduleStarts.clear();
 
 	QFile file(filename);
-	if (!file.open(QFile::ReadOnly)) return modules;
+	if (!file.open(QFile::ReadOnly)) return false;
 
+	enum { BeforeIndex, InIndex, AfterIndex } index = BeforeIndex;
 	QTextStream textStream(&file);
-	bool gotIndex = false;
 	while (true) {
 		QString line = textStream.readLine();
 		if (line.isNull()) break;
 
-		if (line.compare("$INDEX") == 0) {
-			gotIndex = true;
+		switch (index) {
+		case BeforeIndex:
+			if (line.compare("$INDEX") == 0) index = InIndex;
+			break;
+		case InIndex:
+			if (line.compare("$EndINDEX") == 0) index = AfterIndex;
+			else moduleNames.append(line);
+			break;
+		default:
 			break;
 		}
+
+		if (line.contains("$MODULE")) {
+			moduleStarts.append(lines.count());
+		}
+		lines.append(line);
 	}
 
-	if (!gotIndex) return modules;
-	while (true) {
-		QString line = textStream.readLine();
-		if (line.isNull()) break;
+	// an index without an end doesn't count
+	if (index != AfterIndex) moduleNames.clear();
 
-		if (line.compare("$EndINDEX") == 0) {
-			return modules;
-		}
+	return true;
+}
 
-		modules.append(line);
+int KicadModule2Svg::Library::moduleStart(const QString & moduleName) const {
+	// the first $MODULE line that mentions the name, as a search from the top of the file would find
+	Q_FOREACH (int start, moduleStarts) {
+		if (lines.at(start).contains(moduleName, Qt::CaseInsensitive)) return start;
 	}
 
-	modules.clear();
-	return modules;
+	return -1;
+}
+
+QStringList KicadModule2Svg::listModules(const QString & filename) {
+	Library library;
+	library.load(filename);
+	return library.moduleNames;
 }
 
 QString KicadModule2Svg::convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins)
 {
-	m_nonConnectorNumber = 0;
-	initLimits();
-
-	QFile file(filename);
-	if (!file.open(QFile::ReadOnly)) {
+	Library library;
+	if (!library.load(filename)) {
 		throw QObject::tr("unable to open %1").arg(filename);
 	}
 
-	QString text;
-	QTextStream textStream(&file);
-
-	QString metadata = makeMetadata(filename, "module", moduleName);
-
+	return convert(library, moduleName, allowPadsAndPins);
+}
 
-	bool gotModule = false;
-	while (true) {
-		QString line = textStream.readLine();
-		if (line.isNull()) {
-			break;
-		}
+QString KicadModule2Svg::convert(const Library & library, const QString & moduleName, bool allowPadsAndPins)
+{
+	m_nonConnectorNumber = 0;
+	initLimits();
 
-		if (line.contains("$MODULE") && line.contains(moduleName, Qt::CaseInsensitive)) {
-			gotModule = true;
-			break;
-		}
-	}
+	const QString & filename = library.filename;
+	QString metadata = makeMetadata(filename, "module", moduleName);
 
-	if (!gotModule) {
+	int start = library.moduleStart(moduleName);
+	if (start < 0) {
 		throw QObject::tr("footprint %1 not found in %2").arg(moduleName).arg(filename);
 	}
 
+	LineReader reader { library.lines, start + 1 };
+
 	bool gotT0;
 	QString line;
 	while (true) {
-		line = textStream.readLine();
+		line = reader.readLine();
 		if (line.isNull()) {
 			throw QObject::tr("unexpected end of file in footprint %1 in file %2").arg(moduleName).arg(filename);
 		}
@@ -150,7 +162,7 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 	}
 
 	while (line.startsWith("T")) {
-		line = textStream.readLine();
+		line = reader.readLine();
 		if (line.isNull()) {
 			throw QObject::tr("unexpected end of file in footprint %1 in file %2").arg(moduleName).arg(filename);
 		}
@@ -191,7 +203,7 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 			break;
 		}
 
-		line = textStream.readLine();
+		line = reader.readLine();
 		if (line.isNull()) {
 			throw QObject::tr("unexpected end of file in footprint %1 in file %2").arg(moduleName).arg(filename);
 		}
@@ -207,7 +219,7 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 		while (!done) {
 			try {
 				QString pad;
-				PadLayer padLayer = convertPad(textStream, pad, numbers);
+				PadLayer padLayer = convertPad(reader, pad, numbers);
 				switch (padLayer) {
 				case ToCopper0:
 					copper0 += pad;
@@ -226,7 +238,7 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 			}
 
 			while (true) {
-				line = textStream.readLine();
+				line = reader.readLine();
 				if (line.isNull()) {
 					throw QObject::tr("unexpected end of file in footprint %1 in file %2").arg(moduleName).arg(filename);
 				}
@@ -400,12 +412,12 @@ int KicadModule2Svg::drawDArc(const QString & ds, QString & arc) {
 	return layer;
 }
 
-KicadModule2Svg::PadLayer KicadModule2Svg::convertPad(QTextStream & stream, QString & pad, QList<int> & numbers) {
+KicadModule2Svg::PadLayer KicadModule2Svg::convertPad(LineReader & reader, QString & pad, QList<int> & numbers) {
 	PadLayer padLayer = UnableToTranslate;
 
 	QStringList padStrings;
 	while (true) {
-		QString line = stream.readLine();
+		QString line = reader.readLine();
 		if (line.isNull()) {
 			throw QObject::tr("unexpected end of file");
 		}
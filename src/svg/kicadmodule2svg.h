@@ -23,16 +23,30 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QString>
 #include <QStringList>
-#include <QTextStream>
 
 #include "kicad2svg.h"
 
 class KicadModule2Svg : public Kicad2Svg
 {
 
+public:
+	// a whole .mod file, read in one pass, with the line each $MODULE block starts at
+	class Library {
+	public:
+		bool load(const QString & filename);
+		int moduleStart(const QString & moduleName) const;
+
+	public:
+		QString filename;
+		QStringList lines;
+		QStringList moduleNames;	// from the $INDEX section
+		QList<int> moduleStarts;
+	};
+
 public:
 	KicadModule2Svg();
 	QString convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins);
+	QString convert(const Library &, const QString & moduleName, bool allowPadsAndPins);
 
 public:
 	static QStringList listModules(const QString & filename);
@@ -45,7 +59,18 @@ public:
 	};
 
 protected:
-	KicadModule2Svg::PadLayer convertPad(QTextStream & stream, QString & pad, QList<int> & numbers);
+	// hands out the library's lines the way QTextStream::readLine() would, a null string at the end
+	struct LineReader {
+		const QStringList & lines;
+		int index;
+
+		QString readLine() {
+			return index < lines.count() ? lines.at(index++) : QString();
+		}
+	};
+
+protected:
+	KicadModule2Svg::PadLayer convertPad(LineReader & reader, QString & pad, QList<int> & numbers);
 	int drawDSegment(const QString & ds, QString & line);
 	int drawDArc(const QString & ds, QString & arc);
 	int drawDCircle(const QString & ds, QString & arc);
@@ -0,0 +1,176 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgpreloader.h"
+#include "svgfilesplitter.h"
+#include "../fsvgrenderer.h"
+#include "../model/modelpart.h"
+#include "../model/modelpartshared.h"
+#include "../items/partfactory.h"
+#include "../debugdialog.h"
+
+#include <QFile>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QtConcurrentMap>
+
+namespace {
+
+struct PreloadJob {
+	QString key;
+	QString filename;
+	QString layerName;
+	ViewLayer::ViewLayerID viewLayerID = ViewLayer::UnknownLayer;
+	PreloadedSvg result;
+	bool ok = false;
+};
+
+// runs on a worker thread: no access to items, models or the part factory from here
+PreloadJob prepare(PreloadJob job) {
+	if (job.viewLayerID == ViewLayer::Schematic) {
+		job.result.bytes = SvgFileSplitter::hideText(job.filename);
+	}
+	else if (job.viewLayerID == ViewLayer::SchematicText) {
+		bool hasText = false;
+		job.result.bytes = SvgFileSplitter::showText(job.filename, hasText);
+		job.result.hasText = hasText;
+		if (!hasText) {
+			job.ok = true;
+			return job;
+		}
+	}
+	else if (!job.layerName.isEmpty()) {
+		SvgFileSplitter svgFileSplitter;
+		if (svgFileSplitter.split(job.filename, job.layerName)) {
+			job.result.bytes = svgFileSplitter.byteArray();
+		}
+	}
+	else {
+		QFile file(job.filename);
+		if (file.open(QFile::ReadOnly)) {
+			job.result.bytes = file.readAll();
+		}
+	}
+
+	if (job.result.bytes.isEmpty()) return job;
+
+	job.result.cleanBytes = FSvgRenderer::cleanSvg(job.result.bytes);
+	job.ok = true;
+	return job;
+}
+
+}
+
+static QHash<QString, PreloadedSvg> Preloaded;
+static QHash<QPair<int, QByteArray>, QRegion> Shapes;
+static bool Active = false;
+
+void SvgPreloader::preload(const QList<ModelPart *> & modelParts, const QList<ViewLayer::ViewID> & viewIDs)
+{
+	QElapsedTimer timer;
+	timer.start();
+	Active = true;
+
+	// phase one (gui thread): resolve filenames, since PartFactory may generate svgs on the fly
+	QList<PreloadJob> jobs;
+	QSet<QString> keys;
+	QSet<ModelPartShared *> already;
+	Q_FOREACH (ModelPart * modelPart, modelParts) {
+		ModelPartShared * modelPartShared = modelPart->modelPartShared();
+		if (modelPartShared == nullptr) continue;
+		if (already.contains(modelPartShared)) continue;
+
+		already.insert(modelPartShared);
+		Q_FOREACH (ViewLayer::ViewID viewID, viewIDs) {
+			bool multipleLayers = modelPartShared->hasMultipleLayers(viewID);
+			Q_FOREACH (ViewLayer::ViewLayerID viewLayerID, modelPartShared->viewLayers(viewID)) {
+				QString imageFilename = modelPartShared->imageFileName(viewID, viewLayerID);
+				if (imageFilename.isEmpty()) continue;
+
+				QString filename = PartFactory::getSvgFilename(modelPart, imageFilename, true, true);
+				if (filename.isEmpty()) continue;
+
+				PreloadJob job;
+				job.filename = filename;
+				job.viewLayerID = viewLayerID;
+				if (multipleLayers) {
+					job.layerName = ViewLayer::viewLayerXmlNameFromID(viewLayerID);
+				}
+				job.key = makeKey(filename, viewLayerID, job.layerName);
+				if (keys.contains(job.key)) continue;
+
+				keys.insert(job.key);
+				jobs.append(job);
+			}
+		}
+	}
+
+	// phase two (thread pool): file reads, splitting and text cleanup
+	QList<PreloadJob> results = QtConcurrent::blockingMapped(jobs, prepare);
+	Q_FOREACH (const PreloadJob & job, results) {
+		if (job.ok) {
+			Preloaded.insert(job.key, job.result);
+		}
+	}
+
+	DebugDialog::debug(QString("preloaded %1 svgs in %2 ms").arg(Preloaded.count()).arg(timer.elapsed()));
+}
+
+bool SvgPreloader::lookup(const QString & filename, ViewLayer::ViewLayerID viewLayerID, const QString & layerName, PreloadedSvg & preloadedSvg)
+{
+	if (Preloaded.isEmpty()) return false;
+
+	auto it = Preloaded.constFind(makeKey(filename, viewLayerID, layerName));
+	if (it == Preloaded.constEnd()) return false;
+
+	preloadedSvg = it.value();
+	return true;
+}
+
+bool SvgPreloader::lookupShape(ViewLayer::ViewID viewID, const QByteArray & loaded, QRegion & region)
+{
+	if (Shapes.isEmpty()) return false;
+
+	auto it = Shapes.constFind(qMakePair((int) viewID, loaded));
+	if (it == Shapes.constEnd()) return false;
+
+	region = it.value();
+	return true;
+}
+
+void SvgPreloader::insertShape(ViewLayer::ViewID viewID, const QByteArray & loaded, const QRegion & region)
+{
+	// only while a load or paste is running, so the cache never outlives the items it was made for
+	if (!Active) return;
+
+	Shapes.insert(qMakePair((int) viewID, loaded), region);
+}
+
+void SvgPreloader::clear()
+{
+	Preloaded.clear();
+	Shapes.clear();
+	Active = false;
+}
+
+QString SvgPreloader::makeKey(const QString & filename, ViewLayer::ViewLayerID viewLayerID, const QString & layerName)
+{
+	return QString("%1|%2|%3").arg(filename).arg(viewLayerID).arg(layerName);
+}
@@ -0,0 +1,54 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPRELOADER_H
+#define SVGPRELOADER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QRegion>
+
+#include "../viewlayer.h"
+
+struct PreloadedSvg {
+	QByteArray bytes;			// what ItemBase::setUpImage would hand to the renderer
+	QByteArray cleanBytes;		// bytes after FSvgRenderer::cleanSvg
+	bool hasText = true;		// only meaningful for SchematicText layers
+};
+
+// Prepares part svgs on a thread pool before a sketch is loaded or pasted, so that the gui thread
+// only has to parse the renderer and create the graphics items.  Until clear(), items with the
+// same loaded svg also share one selection shape.
+class SvgPreloader
+{
+public:
+	static void preload(const QList<class ModelPart *> &, const QList<ViewLayer::ViewID> &);
+	static bool lookup(const QString & filename, ViewLayer::ViewLayerID, const QString & layerName, PreloadedSvg &);
+	static bool lookupShape(ViewLayer::ViewID, const QByteArray & loaded, QRegion &);
+	static void insertShape(ViewLayer::ViewID, const QByteArray & loaded, const QRegion &);
+	static void clear();
+
+protected:
+	static QString makeKey(const QString & filename, ViewLayer::ViewLayerID, const QString & layerName);
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2023 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "FTimingProbe.h"
+
+#include <QHash>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace {
+
+struct Timing {
+	qint64 count = 0;
+	qint64 total = 0;
+	qint64 min = 0;
+	qint64 max = 0;
+};
+
+QMutex TimingsMutex;
+QHash<QString, Timing> Timings;
+
+double toMsecs(qint64 nsecs) {
+	return nsecs / 1000000.0;
+}
+
+}
+
+FTimingProbe::FTimingProbe() : FProbe("timings") {}
+
+QVariant FTimingProbe::read() {
+	QJsonDocument doc(timings());
+	return QString(doc.toJson(QJsonDocument::Indented));
+}
+
+void FTimingProbe::write(QVariant data) {
+	if (data.toString().compare("clear", Qt::CaseInsensitive) == 0) {
+		clear();
+	}
+}
+
+void FTimingProbe::record(const QString & name, qint64 nsecs) {
+	QMutexLocker locker(&TimingsMutex);
+	Timing & timing = Timings[name];
+	if (timing.count == 0 || nsecs < timing.min) timing.min = nsecs;
+	if (nsecs > timing.max) timing.max = nsecs;
+	timing.total += nsecs;
+	timing.count++;
+}
+
+QJsonObject FTimingProbe::timings() {
+	QMutexLocker locker(&TimingsMutex);
+	QJsonObject result;
+	for (auto it = Timings.cbegin(); it != Timings.cend(); ++it) {
+		QJsonObject obj;
+		obj["count"] = it.value().count;
+		obj["total_ms"] = toMsecs(it.value().total);
+		obj["min_ms"] = toMsecs(it.value().min);
+		obj["max_ms"] = toMsecs(it.value().max);
+		result[it.key()] = obj;
+	}
+	return result;
+}
+
+void FTimingProbe::clear() {
+	QMutexLocker locker(&TimingsMutex);
+	Timings.clear();
+}
+
+FTimingScope::FTimingScope(const char * name) : m_name(name) {
+	m_timer.start();
+}
+
+FTimingScope::~FTimingScope() {
+	FTimingProbe::record(QString::fromLatin1(m_name), m_timer.nsecsElapsed());
+}
@@ -0,0 +1,53 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2023 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef FTIMINGPROBE_H
+#define FTIMINGPROBE_H
+
+#include "testing/FProbe.h"
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QVariant>
+
+// Accumulates wall-clock timings of the hot paths (load, save, drc, ...).
+// read() returns the collected timings as JSON, write("clear") resets them.
+class FTimingProbe : public FProbe {
+public:
+	FTimingProbe();
+	QVariant read() override;
+	void write(QVariant) override;
+
+	static void record(const QString & name, qint64 nsecs);
+	static QJsonObject timings();
+	static void clear();
+};
+
+// Records the lifetime of the scope under the given name.
+class FTimingScope {
+public:
+	explicit FTimingScope(const char * name);
+	~FTimingScope();
+
+protected:
+	const char * m_name;
+	QElapsedTimer m_timer;
+};
+
+#endif // FTIMINGPROBE_H
@@ -62,6 +62,21 @@ constexpr double base3(double t, double p1, double p2, double p3, double p4) noe
 	return t*t2 - 3*p1 + 3*p2;
 }
 
+constexpr double base3Prime(double t, double p1, double p2, double p3, double p4) noexcept
+{
+	double t1 = -3*p1 + 9*p2 - 9*p3 + 3*p4;
+	return 2*t*t1 + 6*p1 - 12*p2 + 6*p3;
+}
+
+constexpr double dot(QPointF a, QPointF b) noexcept
+{
+	return a.x() * b.x() + a.y() * b.y();
+}
+
+// in item coordinates; fine enough for picking a point on a wire or leg, Newton refinement does the rest
+constexpr double NearestFlattenTolerance = 0.25;
+constexpr int MaxFlattenDepth = 16;
+
 // Legendre-Gauss abscissae (xi values, defined at i=n as the roots of the nth order Legendre polynomial Pn(x))
 constexpr double Tvalues[25][24] = {
 	{},
@@ -134,7 +149,8 @@ Bezier::Bezier(const Bezier& other) :
 		m_cp0(other.m_cp0),
 		m_cp1(other.m_cp1),
 		m_isEmpty(other.m_isEmpty),
-		m_drag_cp0(other.m_drag_cp0)
+		m_drag_cp0(other.m_drag_cp0),
+		m_length(other.m_length)
 {
 
 }
@@ -158,18 +174,21 @@ void Bezier::set_cp0(QPointF cp0)
 {
 	m_cp0 = cp0;
 	m_isEmpty = false;
+	m_length = -1;
 }
 
 void Bezier::set_cp1(QPointF cp1)
 {
 	m_cp1 = cp1;
 	m_isEmpty = false;
+	m_length = -1;
 }
 
 void Bezier::set_endpoints(QPointF ep0, QPointF ep1)
 {
 	m_endpoint0 = ep0;
 	m_endpoint1 = ep1;
+	m_length = -1;
 }
 
 Bezier Bezier::fromElement(QDomElement & element)
@@ -257,6 +276,7 @@ void Bezier::recalc(QPointF p)
 	*/
 
 	m_isEmpty = false;
+	m_length = -1;
 }
 
 void Bezier::initToEnds(QPointF cp0, QPointF cp1)
@@ -266,6 +286,7 @@ void Bezier::initToEnds(QPointF cp0, QPointF cp1)
 	m_endpoint1 = cp1;
 	m_cp1 = cp1;
 	m_isEmpty = false;
+	m_length = -1;
 }
 
 double Bezier::xFromT(double t) const noexcept
@@ -315,6 +336,8 @@ void Bezier::split(double t, Bezier & left, Bezier & right) const noexcept
 	right.m_endpoint1 = m_endpoint1;
 	left.m_isEmpty = false;
 	right.m_isEmpty = false;
+	left.m_length = -1;
+	right.m_length = -1;
 }
 Bezier::SplitBezier Bezier::split(double t) const noexcept
 {
@@ -338,7 +361,7 @@ Bezier::SplitBezier Bezier::split(double t) const noexcept
 void Bezier::initControlIndex(QPointF p, double width)
 {
 	double t = findSplit(p, width);
-	double totalLen = computeCubicCurveLength(1, 24);
+	double totalLen = length();
 	double len = computeCubicCurveLength(t, 24);
 	//double d0 = GraphicsUtils::distanceSqd(p, m_cp0);
 	//double d1 = GraphicsUtils::distanceSqd(p, m_cp1);
@@ -369,6 +392,167 @@ double Bezier::cubicF(double t) const noexcept
 	return qSqrt(combined);
 }
 
+/**
+ * Length of the whole curve, cached until the curve changes.
+ */
+double Bezier::length() const noexcept
+{
+	if (m_length < 0) {
+		m_length = computeCubicCurveLength(1.0, 24);
+	}
+	return m_length;
+}
+
+/**
+ * Finds t such that the curve from 0 to t has the given length.
+ * Newton steps on the arc length (its derivative is cubicF), with bisection when a step leaves the bracket.
+ */
+double Bezier::tAtLength(double len) const noexcept
+{
+	double total = length();
+	if (len <= 0 || total <= 0) return 0;
+	if (len >= total) return 1;
+
+	double tmin = 0;
+	double tmax = 1;
+	double t = len / total;
+	for (int i = 0; i < 32; i++) {
+		double diff = computeCubicCurveLength(t, 24) - len;
+		if (qAbs(diff) < .0001) break;
+
+		if (diff > 0) {
+			tmax = t;
+		}
+		else {
+			tmin = t;
+		}
+
+		double speed = cubicF(t);
+		double next = (speed > 0) ? t - (diff / speed) : -1;
+		t = (next > tmin && next < tmax) ? next : (tmin + tmax) / 2;
+	}
+
+	return t;
+}
+
+QPointF Bezier::pointAt(double t) const noexcept
+{
+	return QPointF(xFromT(t), yFromT(t));
+}
+
+QPointF Bezier::derivativeAt(double t) const noexcept
+{
+	return QPointF(base3(t, m_endpoint0.x(), m_cp0.x(), m_cp1.x(), m_endpoint1.x()),
+	               base3(t, m_endpoint0.y(), m_cp0.y(), m_cp1.y(), m_endpoint1.y()));
+}
+
+QPointF Bezier::secondDerivativeAt(double t) const noexcept
+{
+	return QPointF(base3Prime(t, m_endpoint0.x(), m_cp0.x(), m_cp1.x(), m_endpoint1.x()),
+	               base3Prime(t, m_endpoint0.y(), m_cp0.y(), m_cp1.y(), m_endpoint1.y()));
+}
+
+/**
+ * Approximates the curve by a polyline no further than tolerance from the curve,
+ * subdividing until the control points are close enough to the chord.
+ * If ts is given, it receives the t value of each point.
+ */
+QPolygonF Bezier::flatten(double tolerance, QList<double> * ts) const
+{
+	QPolygonF points;
+	points.append(m_endpoint0);
+	if (ts) {
+		ts->clear();
+		ts->append(0);
+	}
+	flattenAux(0, 1, tolerance * tolerance, 0, points, ts);
+	return points;
+}
+
+void Bezier::flattenAux(double t0, double t1, double toleranceSqd, int depth, QPolygonF & points, QList<double> * ts) const
+{
+	QPointF chord = m_endpoint1 - m_endpoint0;
+	double chordSqd = dot(chord, chord);
+	double flatness = 0;
+	for (QPointF cp : { m_cp0, m_cp1 }) {
+		QPointF v = cp - m_endpoint0;
+		double d;
+		if (chordSqd <= 0) {
+			d = dot(v, v);
+		}
+		else {
+			double cross = v.x() * chord.y() - v.y() * chord.x();
+			d = cross * cross / chordSqd;
+		}
+		flatness = qMax(flatness, d);
+	}
+
+	if (flatness <= toleranceSqd || depth >= MaxFlattenDepth) {
+		points.append(m_endpoint1);
+		if (ts) ts->append(t1);
+		return;
+	}
+
+	Bezier left, right;
+	split(0.5, left, right);
+	double tm = (t0 + t1) / 2;
+	left.flattenAux(t0, tm, toleranceSqd, depth + 1, points, ts);
+	right.flattenAux(tm, t1, toleranceSqd, depth + 1, points, ts);
+}
+
+/**
+ * Finds the t of the point on the curve closest to p. The closest point on the flattened curve
+ * is the starting value, refined with Newton steps on (B(t) - p) . B'(t) = 0.
+ */
+double Bezier::nearestT(QPointF p) const
+{
+	return nearestTAux(p, -1);
+}
+
+double Bezier::nearestTAux(QPointF p, double minDistance) const
+{
+	// with minDistance >= 0, stop at the first local minimum along the curve that is within minDistance
+	QList<double> ts;
+	QPolygonF points = flatten(NearestFlattenTolerance, &ts);
+
+	double minDSqd = minDistance * minDistance;
+	double bestT = 0;
+	double bestDistance = std::numeric_limits<double>::max();
+	for (int i = 0; i < points.count() - 1; i++) {
+		QPointF segment = points.at(i + 1) - points.at(i);
+		double segmentSqd = dot(segment, segment);
+		double u = (segmentSqd > 0) ? qBound(0.0, dot(p - points.at(i), segment) / segmentSqd, 1.0) : 0;
+		QPointF d = points.at(i) + u * segment - p;
+		double distance = dot(d, d);
+		if (distance < bestDistance) {
+			bestDistance = distance;
+			bestT = ts.at(i) + u * (ts.at(i + 1) - ts.at(i));
+		}
+		else if (minDistance >= 0 && bestDistance <= minDSqd) {
+			// moving away again from a close enough minimum
+			break;
+		}
+	}
+
+	double t = bestT;
+	for (int i = 0; i < 8; i++) {
+		QPointF d = pointAt(t) - p;
+		QPointF d1 = derivativeAt(t);
+		double denominator = dot(d1, d1) + dot(d, secondDerivativeAt(t));
+		if (denominator <= 0) break;
+
+		double next = qBound(0.0, t - dot(d, d1) / denominator, 1.0);
+		if (qAbs(next - t) < 1e-9) break;
+
+		t = next;
+	}
+
+	// Newton can wander off on a self-intersecting curve; keep the polyline answer then
+	QPointF refined = pointAt(t) - p;
+	QPointF start = pointAt(bestT) - p;
+	return (dot(refined, refined) <= dot(start, start)) ? t : bestT;
+}
+
 void Bezier::copy(const Bezier * other)
 {
 	if (other == nullptr) {
@@ -382,30 +566,13 @@ void Bezier::copy(const Bezier * other)
 	m_endpoint1 = other->m_endpoint1;
 	m_isEmpty = other->m_isEmpty;
 	m_drag_cp0 = other->m_drag_cp0;
+	m_length = other->m_length;
 }
 
-double Bezier::findSplit(QPointF p, double minDistance) const noexcept
+double Bezier::findSplit(QPointF p, double minDistance) const
 {
-	double bestT = 0;
-	double lastDistance = std::numeric_limits<int>::max();
-	double blen = computeCubicCurveLength(1.0, 24);
-	double increment = 1.0 / blen;
-	double minDSqd = minDistance * minDistance;
-	for (double t = 0; t <= 1; t += increment) {
-		double x = xFromT(t);
-		double y = yFromT(t);
-		double d = GraphicsUtils::distanceSqd(p, QPointF(x, y));
-		if (d >= lastDistance) {
-			if (d > minDSqd) continue;
-
-			break;
-		}
-
-		bestT = t;
-		lastDistance = d;
-	}
-
-	return bestT;
+	// where the curve passes p more than once, the first pass within minDistance (the pen width) wins
+	return nearestTAux(p, minDistance);
 }
 
 void Bezier::translateToZero() {
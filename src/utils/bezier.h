@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define BEZIER_H
 
 #include <QPointF>
+#include <QPolygonF>
 #include <QDomElement>
 #include <QXmlStreamWriter>
 #include <tuple>
@@ -57,8 +58,13 @@ public:
 	SplitBezier split(double t) const noexcept;
 	void initControlIndex(QPointF fromPoint, double width);
 	double computeCubicCurveLength(double z, int n) const noexcept;
+	double length() const noexcept;
+	double tAtLength(double length) const noexcept;
+	QPointF pointAt(double t) const noexcept;
+	QPolygonF flatten(double tolerance, QList<double> * ts = nullptr) const;
+	double nearestT(QPointF p) const;
 	void copy(const Bezier *);
-	double findSplit(QPointF p, double minDistance) const noexcept;
+	double findSplit(QPointF p, double minDistance) const;
 	void translateToZero();
 	void translate(QPointF);
 	Bezier join(const Bezier * other) const;
@@ -67,6 +73,10 @@ public:
 
 protected:
 	double cubicF(double t) const noexcept;
+	QPointF derivativeAt(double t) const noexcept;
+	QPointF secondDerivativeAt(double t) const noexcept;
+	double nearestTAux(QPointF p, double minDistance) const;
+	void flattenAux(double t0, double t1, double toleranceSqd, int depth, QPolygonF & points, QList<double> * ts) const;
 
 private:
 	// This is not used so far, and had misguiding parameter names.
@@ -83,6 +93,7 @@ protected:
 	QPointF m_cp1;
 	bool m_isEmpty;
 	bool m_drag_cp0 = false;
+	mutable double m_length = -1;		// arc length cache, < 0 when the curve has changed
 };
 
 #endif
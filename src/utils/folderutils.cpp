@@ -36,8 +36,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "utils/misc.h"
 #include "fmessagebox.h"
-#include <quazip/quazip.h>
-#include <quazip/quazipfile.h>
+#include "ziputils.h"
 
 
 FolderUtils* FolderUtils::singleton = nullptr;
@@ -447,23 +446,11 @@ bool FolderUtils::createFZAndSaveTo(const QDir &dirToCompress, const QString &fi
 bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &filepath, const QStringList & skipSuffixes) {
 	DebugDialog::debug("zipping "+dirToCompress.path()+" into "+filepath);
 
-	QString tempZipFile = QDir::temp().path()+"/"+TextUtils::getRandText()+".zip";
-	DebugDialog::debug("temp file: "+tempZipFile);
-	QuaZip zip(tempZipFile);
-	if(!zip.open(QuaZip::mdCreate)) {
-		qWarning() << QString("zip.open(): %1").arg(zip.getZipError());
-		return false;
-	}
-
+	QStringList filepaths;
+	QString absoluteFilepath = QFileInfo(filepath).absoluteFilePath();
 	QFileInfoList files=dirToCompress.entryInfoList();
-	QFile inFile;
-	QuaZipFile outFile(&zip);
-	char c;
-
-	QString currFolderBU = QDir::currentPath();
-	QDir::setCurrent(dirToCompress.path());
 	Q_FOREACH(QFileInfo file, files) {
-		if(!file.isFile()||file.fileName()==filepath) continue;
+		if(!file.isFile()||file.absoluteFilePath()==absoluteFilepath) continue;
 		if (file.fileName().contains(LockManager::LockedFileName)) continue;
 
 		bool skip = false;
@@ -475,168 +462,27 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 		}
 		if (skip) continue;
 
-//#pragma message("remove fzz check")
-//if (file.fileName().endsWith(".fzz")) continue;
-
-		inFile.setFileName(file.fileName());
-
-		if(!inFile.open(QIODevice::ReadOnly)) {
-			qWarning("inFile.open(): %s", inFile.errorString().toLocal8Bit().constData());
-			return false;
-		}
-		if(!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(inFile.fileName(), inFile.fileName()))) {
-			qWarning("outFile.open(): %d", outFile.getZipError());
-			return false;
-		}
-
-		while(inFile.getChar(&c)&&outFile.putChar(c)) {}
-
-		if(outFile.getZipError()!=UNZ_OK) {
-			qWarning("outFile.putChar(): %d", outFile.getZipError());
-			return false;
-		}
-		outFile.close();
-		if(outFile.getZipError()!=UNZ_OK) {
-			qWarning("outFile.close(): %d", outFile.getZipError());
-			return false;
-		}
-		inFile.close();
+		filepaths.append(file.absoluteFilePath());
 	}
-	zip.close();
-	QDir::setCurrent(currFolderBU);
 
-	QFile file(tempZipFile);
-	QString randSuffix = TextUtils::getRandText();
-	QString temporaryFilepathInTargetDir = addToBasename(filepath, randSuffix);
-	bool result = FolderUtils::slamCopy(file, temporaryFilepathInTargetDir);
-	if (!result) {
-		qWarning("Saving failed. Copying file to target dir failed.");
-		return false;
-	}
-
-	if(QFileInfo(filepath).exists()) {
-		// if we're here the usr has already accepted to overwrite
-		QFile::remove(filepath);
-	}
-	QFile file2(temporaryFilepathInTargetDir);
-	result = file2.rename(filepath);
-	if (!result) {
-		qWarning("Saving failed. Renaming file to target file name failed.");
+	QString error;
+	if (!ZipUtils::zip(filepaths, filepath, error)) {
+		qWarning() << "Saving failed." << error;
 		return false;
 	}
-	file.remove();
 
-	if(zip.getZipError()!=0) {
-		qWarning("zip.close(): %d", zip.getZipError());
-		return false;
-	}
 	return true;
 }
 
 
 
 bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompress, QString & error) {
-	static QChar badCharacters[] = { '\\', '/', ':', '*', '?', '"', '<', '>', '|' };
-	static QChar underscore('_');
-
-	QuaZip zip(filepath);
-	if(!zip.open(QuaZip::mdUnzip)) {
-		error = QString("zip.open(): %1").arg(zip.getZipError());
+	DebugDialog::debug(QString("unzipping %1 into %2").arg(filepath, dirToDecompress));
+	if (!ZipUtils::unzip(filepath, dirToDecompress, error)) {
 		DebugDialog::debug(error);
 		return false;
 	}
 
-	zip.setFileNameCodec("IBM866");
-	DebugDialog::debug(QString("unzipping %1 entries from %2").arg(zip.getEntriesCount()).arg(filepath));
-	QuaZipFileInfo info;
-	QuaZipFile file(&zip);
-	QFile out;
-	QString name;
-	char c;
-	for(bool more=zip.goToFirstFile(); more; more=zip.goToNextFile()) {
-		if(!zip.getCurrentFileInfo(&info)) {
-			error = QString("getCurrentFileInfo(): %1\n").arg(zip.getZipError());
-			DebugDialog::debug(error);
-			return false;
-		}
-
-		if(!file.open(QIODevice::ReadOnly)) {
-			error = QString("file.open(): %1").arg(file.getZipError());
-			DebugDialog::debug(error);
-			return false;
-		}
-		name=file.getActualFileName();
-		if(file.getZipError()!=UNZ_OK) {
-			error = QString("file.getFileName(): %1").arg(file.getZipError());
-			DebugDialog::debug(error);
-			return false;
-		}
-
-		out.setFileName(dirToDecompress+"/"+name);
-		// this will fail if "name" contains subdirectories, but we don't mind that
-		if(!out.open(QIODevice::WriteOnly)) {
-			for (int i = 0; i < name.length(); i++) {
-				if (name[i].unicode() < 32) {
-					name.replace(i, 1, &underscore, 1);
-				}
-				else for (auto badCharacter : badCharacters) {
-						if (name[i] == badCharacter) {
-							name.replace(i, 1, &underscore, 1);
-							break;
-						}
-					}
-			}
-			out.setFileName(dirToDecompress+"/"+name);
-			if(!out.open(QIODevice::WriteOnly)) {
-				error = QString("out.open(): %1").arg(out.errorString().toLocal8Bit().constData());
-				DebugDialog::debug(error);
-				return false;
-			}
-		}
-
-		// Slow like hell (on GNU/Linux at least), but it is not my fault.
-		// Not ZIP/UNZIP package's fault either.
-		// The slowest thing here is out.putChar(c).
-		// TODO: now that out.putChar has been replaced with a buffered write, is it still slow under Linux?
-
-#define BUFFERSIZE 1024
-		char buffer[BUFFERSIZE];
-		int ix = 0;
-		while(file.getChar(&c)) {
-			buffer[ix++] = c;
-			if (ix == BUFFERSIZE) {
-				out.write(buffer, ix);
-				ix = 0;
-			}
-		}
-		if (ix > 0) {
-			out.write(buffer, ix);
-		}
-
-		out.close();
-		if(file.getZipError()!=UNZ_OK) {
-			error = QString("file.getFileName(): %1").arg(file.getZipError());
-			DebugDialog::debug(error);
-			return false;
-		}
-		if(!file.atEnd()) {
-			error = "read all but not EOF";
-			DebugDialog::debug(error);
-			return false;
-		}
-		file.close();
-		if(file.getZipError()!=UNZ_OK) {
-			error = QString("file.close(): %1").arg(file.getZipError());
-			DebugDialog::debug(error);
-			return false;
-		}
-	}
-	zip.close();
-	if(zip.getZipError()!=UNZ_OK) {
-		error = QString("zip.close(): %1").arg(zip.getZipError());
-		DebugDialog::debug(error);
-		return false;
-	}
 	return true;
 }
 
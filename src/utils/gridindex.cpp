@@ -0,0 +1,164 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "gridindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// centers closer than this are treated as the same row or column
+constexpr double SameLine = 1e-6;
+
+// if a few oversized rects would be copied into too many cells, coarsen the grid
+constexpr int MaxCellsPerRect = 8;
+
+// points far outside the grid must not overflow the cell coordinates
+qint64 cell(double offset)
+{
+	return (qint64) qBound(-2147483648.0, std::floor(offset), 2147483647.0);
+}
+
+double median(QList<double> & values)
+{
+	if (values.isEmpty()) return 0;
+
+	auto middle = values.begin() + values.count() / 2;
+	std::nth_element(values.begin(), middle, values.end());
+	return *middle;
+}
+
+}
+
+void GridIndex::build(const QList<QRectF> & rects)
+{
+	clear();
+	m_rects = rects;
+	if (m_rects.isEmpty()) return;
+
+	QList<double> xs, ys, widths, heights;
+	QRectF bounds = m_rects.first();
+	Q_FOREACH (QRectF r, m_rects) {
+		xs.append(r.center().x());
+		ys.append(r.center().y());
+		widths.append(r.width());
+		heights.append(r.height());
+		bounds |= r;
+	}
+
+	// one cell per pitch on a regular grid, but never smaller than a typical rect
+	m_cellWidth = qMax(pitch(xs), median(widths));
+	m_cellHeight = qMax(pitch(ys), median(heights));
+	if (m_cellWidth <= 0) m_cellWidth = qMax(1.0, bounds.width());
+	if (m_cellHeight <= 0) m_cellHeight = qMax(1.0, bounds.height());
+	m_origin = bounds.topLeft();
+
+	for (int attempt = 0; attempt < 32; attempt++) {
+		qint64 cells = 0;
+		Q_FOREACH (QRectF r, m_rects) {
+			cells += (column(r.right()) - column(r.left()) + 1) * (row(r.bottom()) - row(r.top()) + 1);
+		}
+		if (cells <= (qint64) m_rects.count() * MaxCellsPerRect) break;
+
+		m_cellWidth *= 2;
+		m_cellHeight *= 2;
+	}
+
+	m_cells.reserve(m_rects.count());
+	for (int i = 0; i < m_rects.count(); i++) {
+		const QRectF & r = m_rects.at(i);
+		for (qint64 c = column(r.left()); c <= column(r.right()); c++) {
+			for (qint64 w = row(r.top()); w <= row(r.bottom()); w++) {
+				m_cells[key(c, w)].append(i);
+			}
+		}
+	}
+}
+
+void GridIndex::clear()
+{
+	m_rects.clear();
+	m_cells.clear();
+	m_origin = QPointF();
+	m_cellWidth = m_cellHeight = 1;
+}
+
+bool GridIndex::isEmpty() const
+{
+	return m_rects.isEmpty();
+}
+
+int GridIndex::count() const
+{
+	return m_rects.count();
+}
+
+const QRectF & GridIndex::rect(int index) const
+{
+	return m_rects.at(index);
+}
+
+QSizeF GridIndex::cellSize() const
+{
+	return QSizeF(m_cellWidth, m_cellHeight);
+}
+
+QList<int> GridIndex::indexesAt(QPointF p) const
+{
+	QList<int> indexes;
+	auto it = m_cells.constFind(key(column(p.x()), row(p.y())));
+	if (it == m_cells.constEnd()) return indexes;
+
+	Q_FOREACH (int i, it.value()) {
+		if (m_rects.at(i).contains(p)) indexes.append(i);
+	}
+
+	return indexes;
+}
+
+double GridIndex::pitch(QList<double> & values)
+{
+	// the smallest distance between neighboring distinct values
+	std::sort(values.begin(), values.end());
+	double result = 0;
+	for (int i = 1; i < values.count(); i++) {
+		double d = values.at(i) - values.at(i - 1);
+		if (d <= SameLine) continue;
+		if (result == 0 || d < result) result = d;
+	}
+
+	return result;
+}
+
+qint64 GridIndex::column(double x) const
+{
+	return cell((x - m_origin.x()) / m_cellWidth);
+}
+
+qint64 GridIndex::row(double y) const
+{
+	return cell((y - m_origin.y()) / m_cellHeight);
+}
+
+quint64 GridIndex::key(qint64 column, qint64 row)
+{
+	return ((quint64) (quint32) column << 32) | (quint32) row;
+}
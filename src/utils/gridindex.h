@@ -0,0 +1,57 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef GRIDINDEX_H
+#define GRIDINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QRectF>
+
+// buckets rectangles into uniform cells so that a point lookup only visits its own cell.
+// The cell size follows the pitch of the rectangle centers, so a regular grid of holes
+// ends up with one rectangle per cell; irregular layouts still work, with fuller cells.
+
+class GridIndex
+{
+public:
+	void build(const QList<QRectF> & rects);
+	void clear();
+	bool isEmpty() const;
+	int count() const;
+	const QRectF & rect(int index) const;
+	QSizeF cellSize() const;
+	QList<int> indexesAt(QPointF p) const;
+
+protected:
+	static double pitch(QList<double> & values);
+	qint64 column(double x) const;
+	qint64 row(double y) const;
+	static quint64 key(qint64 column, qint64 row);
+
+protected:
+	QList<QRectF> m_rects;
+	QHash<quint64, QList<int>> m_cells;
+	QPointF m_origin;
+	double m_cellWidth = 1;
+	double m_cellHeight = 1;
+};
+
+#endif
@@ -37,8 +37,11 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QUrl>
 #include <QUuid>
 #include <QCryptographicHash>
+#include <QXmlStreamReader>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 #include <qmath.h>
 #include <qnumeric.h>
 
@@ -1089,7 +1092,921 @@ bool TextUtils::fixInternalUnits(QString & svg)
 	return result;
 }
 
+namespace {
+
+/**
+ * An attribute the way QDom keeps it: looked up and sorted by its local name, written with its prefix.
+ * Attributes added or copied by the fixes have no namespace, as with QDomElement::setAttribute.
+ */
+struct SvgAttribute {
+	QString name;
+	QString prefix;
+	QString namespaceUri;
+	QString value;
+};
+
+using SvgAttributes = QList<SvgAttribute>;
+
+const QRegularExpression QuotedUnits("[\"']([\\d,\\.]+)(px|mm|cm|in|pt|pc)[\"']");
+const QRegularExpression InternalUnitsValue("^([\\d,\\.]+)(px|mm|cm|in|pt|pc)$");
+const QRegularExpression StrokeWidthUnits("stroke-width:([\\d,\\.]+)(px|mm|cm|in|pt|pc)");
+const QRegularExpression ViewBoxSeparator(" |,");
+const QStringList StyleAttributeNames({ "stroke-width", "stroke", "fill", "fill-opacity", "stroke-opacity", "font-size", "stroke-dasharray" });
+
+QString attributeValue(const SvgAttributes & attributes, const QString & name)
+{
+	for (const auto & attribute : attributes) {
+		if (attribute.name == name) return attribute.value;
+	}
+
+	return QString();
+}
+
+void setAttributeValue(SvgAttributes & attributes, const QString & name, const QString & value)
+{
+	for (auto & attribute : attributes) {
+		if (attribute.name == name) {
+			attribute.value = value;
+			return;
+		}
+	}
+
+	SvgAttribute attribute;
+	attribute.name = name;
+	attribute.value = value;
+	attributes.append(attribute);
+}
+
+void removeAttribute(SvgAttributes & attributes, const QString & name)
+{
+	for (int i = 0; i < attributes.count(); i++) {
+		if (attributes.at(i).name == name) {
+			attributes.removeAt(i);
+			return;
+		}
+	}
+}
+
+/**
+ * The escaping QDomDocument::toString applies. The character references it writes for tabs and
+ * line breaks are the ones TextUtils::removeXMLEntities takes out again.
+ */
+QString encodeText(const QString & text, bool attribute)
+{
+	QString result;
+	result.reserve(text.length());
+	for (QChar c : text) {
+		switch (c.unicode()) {
+		case '<':
+			result += QLatin1String("&lt;");
+			break;
+		case '&':
+			result += QLatin1String("&amp;");
+			break;
+		case '"':
+			result += attribute ? QLatin1String("&quot;") : QLatin1String("\"");
+			break;
+		case '>':
+			result += result.endsWith(QLatin1String("]]")) ? QLatin1String("&gt;") : QLatin1String(">");
+			break;
+		case '\r':
+			result += QLatin1String("&#xd;");
+			break;
+		case '\n':
+			result += attribute ? QLatin1String("&#xa;") : QLatin1String("\n");
+			break;
+		case '\t':
+			result += attribute ? QLatin1String("&#x9;") : QLatin1String("\t");
+			break;
+		default:
+			result += c;
+			break;
+		}
+	}
+
+	return result;
+}
+
+QString quotedValue(const QString & value)
+{
+	QChar quote = value.contains('\'') ? '"' : '\'';
+	return quote + value + quote;
+}
+
+/**
+ * Streaming version of TextUtils::fixMuchDom: internal unit conversion, viewBox origin,
+ * pattern/marker/clipPath removal, tspan flattening, stroke-width defaults and transform elevation,
+ * all in one QXmlStreamReader pass. The output is written the way QDomDocument::toString(1) writes
+ * the tree fixMuchDom ends up with, so after removeXMLEntities the two produce the same bytes.
+ * <use> expansion needs random access to the document, so run() returns false when the svg has a
+ * <use> that fixMuchDom would expand (or anything else this does not reproduce).
+ */
+class SvgFixer
+{
+public:
+	SvgFixer(const QString & svg, bool fixStrokeWidth) : m_svg(svg), m_fixStrokeWidth(fixStrokeWidth) {}
+
+	bool run();
+	bool changed() const { return m_changed; }
+	const QString & output() const { return m_output; }
+
+protected:
+	struct Node {
+		enum Kind { Element, Text, CData, Comment, ProcessingInstruction };
+		Kind kind = Element;
+		QString name;
+		QString namespaceUri;
+		QString text;
+		SvgAttributes attributes;
+		std::vector<Node> children;
+	};
+
+	struct OpenElement {
+		int outerGroups = 0;
+		int innerGroups = 0;
+	};
+
+	struct StrokeState {
+		QString stroke;
+		QString strokeWidth;
+	};
+
+	SvgAttributes readAttributes(QXmlStreamReader & reader);
+	bool readNode(QXmlStreamReader & reader, Node & node);
+	bool keepCharacters(QXmlStreamReader & reader);
+	void writeNode(const Node & node);
+	void writeText(const Node & text);
+	bool startElement(const QString & name, const QString & namespaceUri, const SvgAttributes & attributes);
+	void endElement();
+	void characters(const QString & text, bool cdata);
+	void comment(const QString & text);
+	void processingInstruction(const QString & target, const QString & data);
+	void writeProlog();
+	void beginNode(bool text);
+	void writeStartTag(const QString & name, const QString & namespaceUri, const SvgAttributes & attributes);
+	void writeEndTag();
+	void writeCharacters(const QString & text, bool cdata);
+	void writeComment(const QString & text);
+	void writeProcessingInstruction(const QString & target, const QString & data);
+	void fixUnits(QString & text, bool attribute);
+	bool fixQuotedUnits(QString & text);
+	void fixStrokeWidthUnits(QString & text);
+	void fixViewBox(SvgAttributes & attributes);
+	void fixStroke(SvgAttributes & attributes);
+	void fixStyle(SvgAttributes & attributes, QString style);
+	bool unitsKnown();
+	QString convertUnits(const QString & value);
+
+protected:
+	const QString & m_svg;
+	bool m_fixStrokeWidth = false;
+	bool m_changed = false;
+	bool m_fallback = false;
+	bool m_rootSeen = false;
+	QList<OpenElement> m_open;
+	QList<StrokeState> m_strokes;
+	QString m_viewBoxTranslate;
+	std::vector<Node> m_prolog;    // comments and processing instructions before the root, written after the doctype
+	std::vector<Node> m_rootTail;  // text and comments of the root, which fixViewBox leaves behind the translated group
+	QString m_declaration;
+	QString m_doctype;
+	int m_unitState = 0;           // 0: not needed yet, 1: size known, -1: svg size unknown, leave units alone
+	double m_viewBoxWidth = 0;
+	double m_width = 0;
+
+	// QDomDocument::toString(1) state
+	QString m_output;
+	QStringList m_tags;
+	bool m_tagOpen = false;        // start tag written without its closing '>'
+	bool m_newlinePending = false; // the last node ended, the line break depends on whether text follows
+	bool m_afterText = false;      // the previous sibling is text, so no indent
+};
+
+bool SvgFixer::run()
+{
+	QXmlStreamReader reader(m_svg);
+	while (!reader.atEnd() && !m_fallback) {
+		switch (reader.readNext()) {
+		case QXmlStreamReader::StartDocument:
+			if (!reader.documentVersion().isEmpty()) {
+				// the way QDom keeps the declaration
+				m_declaration = QString("version='%1'").arg(reader.documentVersion().toString());
+				if (!reader.documentEncoding().isEmpty()) {
+					m_declaration += QString(" encoding='%1'").arg(reader.documentEncoding().toString());
+				}
+				if (reader.isStandaloneDocument()) {
+					m_declaration += " standalone='yes'";
+				}
+			}
+			break;
+		case QXmlStreamReader::DTD:
+			if (!reader.entityDeclarations().isEmpty() || !reader.notationDeclarations().isEmpty()) return false;
+
+			if (!reader.dtdName().isEmpty()) {
+				m_doctype = "<!DOCTYPE " + reader.dtdName().toString();
+				if (!reader.dtdPublicId().isEmpty()) {
+					m_doctype += " PUBLIC " + quotedValue(reader.dtdPublicId().toString());
+					if (!reader.dtdSystemId().isEmpty()) {
+						m_doctype += ' ' + quotedValue(reader.dtdSystemId().toString());
+					}
+				}
+				else if (!reader.dtdSystemId().isEmpty()) {
+					m_doctype += " SYSTEM " + quotedValue(reader.dtdSystemId().toString());
+				}
+				m_doctype += ">\n";
+			}
+			break;
+		case QXmlStreamReader::StartElement: {
+			// fixMuchDom finds elements by their local names, but only after checking the text for "<name"
+			if (!reader.prefix().isEmpty()) return false;
+
+			if (!m_rootSeen) {
+				writeProlog();
+			}
+
+			QString name = reader.name().toString();
+			QString namespaceUri = reader.namespaceUri().toString();
+			if (m_open.count() > 0 && (name == "text" || name == "pattern" || name == "marker" || name == "clipPath")) {
+				// text may need its tspans flattened, so read the whole element first
+				Node node;
+				node.name = name;
+				node.namespaceUri = namespaceUri;
+				node.attributes = readAttributes(reader);
+				if (!readNode(reader, node)) return false;
+
+				writeNode(node);
+				break;
+			}
+
+			SvgAttributes attributes = readAttributes(reader);
+			m_rootSeen = true;
+			if (!startElement(name, namespaceUri, attributes)) return false;
+			break;
+		}
+		case QXmlStreamReader::EndElement:
+			endElement();
+			break;
+		case QXmlStreamReader::Characters:
+			if (keepCharacters(reader)) {
+				characters(reader.text().toString(), reader.isCDATA());
+			}
+			break;
+		case QXmlStreamReader::Comment:
+			comment(reader.text().toString());
+			break;
+		case QXmlStreamReader::ProcessingInstruction:
+			processingInstruction(reader.processingInstructionTarget().toString(), reader.processingInstructionData().toString());
+			break;
+		case QXmlStreamReader::EntityReference:
+			return false;
+		default:
+			break;
+		}
+	}
+
+	if (m_fallback || reader.hasError() || !m_rootSeen) return false;
+
+	if (m_newlinePending) {
+		m_output += '\n';
+	}
+	return true;
+}
+
+SvgAttributes SvgFixer::readAttributes(QXmlStreamReader & reader)
+{
+	// namespace declarations are not attributes once QDom has processed them
+	SvgAttributes attributes;
+	Q_FOREACH (const QXmlStreamAttribute & xmlAttribute, reader.attributes()) {
+		SvgAttribute attribute;
+		attribute.name = xmlAttribute.name().toString();
+		attribute.prefix = xmlAttribute.prefix().toString();
+		attribute.namespaceUri = xmlAttribute.namespaceUri().toString();
+		attribute.value = xmlAttribute.value().toString();
+		if (!m_open.isEmpty()) {
+			fixUnits(attribute.value, true);
+		}
+		attributes.append(attribute);
+	}
+
+	return attributes;
+}
+
+/**
+ * QDom drops text nodes that are only white space.
+ */
+bool SvgFixer::keepCharacters(QXmlStreamReader & reader)
+{
+	if (reader.isCDATA()) return !reader.isWhitespace();
+
+	return !reader.text().trimmed().isEmpty();
+}
+
+bool SvgFixer::readNode(QXmlStreamReader & reader, Node & node)
+{
+	while (!reader.atEnd()) {
+		switch (reader.readNext()) {
+		case QXmlStreamReader::StartElement: {
+			if (!reader.prefix().isEmpty()) return false;
+
+			Node child;
+			child.name = reader.name().toString();
+			child.namespaceUri = reader.namespaceUri().toString();
+			child.attributes = readAttributes(reader);
+			if (!readNode(reader, child)) return false;
+
+			node.children.push_back(child);
+			break;
+		}
+		case QXmlStreamReader::EndElement:
+			return true;
+		case QXmlStreamReader::Characters:
+			if (keepCharacters(reader)) {
+				Node child;
+				child.kind = reader.isCDATA() ? Node::CData : Node::Text;
+				child.text = reader.text().toString();
+				node.children.push_back(child);
+			}
+			break;
+		case QXmlStreamReader::Comment: {
+			Node child;
+			child.kind = Node::Comment;
+			child.text = reader.text().toString();
+			node.children.push_back(child);
+			break;
+		}
+		case QXmlStreamReader::ProcessingInstruction: {
+			Node child;
+			child.kind = Node::ProcessingInstruction;
+			child.name = reader.processingInstructionTarget().toString();
+			child.text = reader.processingInstructionData().toString();
+			node.children.push_back(child);
+			break;
+		}
+		case QXmlStreamReader::EntityReference:
+			return false;
+		default:
+			break;
+		}
+	}
+
+	return false;
+}
+
+void SvgFixer::writeNode(const Node & node)
+{
+	switch (node.kind) {
+	case Node::Text:
+	case Node::CData:
+		characters(node.text, node.kind == Node::CData);
+		return;
+	case Node::Comment:
+		comment(node.text);
+		return;
+	case Node::ProcessingInstruction:
+		processingInstruction(node.name, node.text);
+		return;
+	default:
+		break;
+	}
+
+	if (node.name == "pattern" || node.name == "marker" || node.name == "clipPath") {
+		m_changed = true;
+		return;
+	}
+
+	if (node.name == "text") {
+		for (const Node & child : node.children) {
+			if (child.kind == Node::Element && child.name == "tspan") {
+				writeText(node);
+				return;
+			}
+		}
+	}
+
+	if (!startElement(node.name, node.namespaceUri, node.attributes)) return;
+
+	for (const Node & child : node.children) {
+		writeNode(child);
+	}
+	endElement();
+}
+
+/**
+ * Same as TextUtils::tspanRemoveAux: the text becomes a group holding one text element for its own
+ * first text node and one for the first text node of each tspan. Like the elements QDom creates,
+ * these have no namespace, and the attributes copied onto them keep their prefixed names.
+ */
+void SvgFixer::writeText(const Node & text)
+{
+	m_changed = true;
+
+	auto copyAttributes = [](const SvgAttributes & from, SvgAttributes & to) {
+		for (const auto & attribute : from) {
+			setAttributeValue(to, attribute.prefix.isEmpty() ? attribute.name : attribute.prefix + ":" + attribute.name, attribute.value);
+		}
+	};
+
+	SvgAttributes attributes;
+	copyAttributes(text.attributes, attributes);
+	QString defaultX = attributeValue(attributes, "x");
+	QString defaultY = attributeValue(attributes, "y");
+	removeAttribute(attributes, "x");
+	removeAttribute(attributes, "y");
+	if (!startElement("g", QString(), attributes)) return;
+
+	auto copyText = [this, &defaultX, &defaultY, &copyAttributes](const Node & from, bool copy) {
+		for (const Node & child : from.children) {
+			if (child.kind != Node::Text && child.kind != Node::CData) continue;
+
+			SvgAttributes newAttributes;
+			setAttributeValue(newAttributes, "x", defaultX);
+			setAttributeValue(newAttributes, "y", defaultY);
+			if (copy) {
+				copyAttributes(from.attributes, newAttributes);
+			}
+			if (!startElement("text", QString(), newAttributes)) return;
+
+			characters(child.text, false);
+			endElement();
+			return;
+		}
+	};
+
+	copyText(text, false);
+	for (const Node & child : text.children) {
+		if (child.kind == Node::Element && child.name == "tspan") {
+			copyText(child, true);
+		}
+	}
+
+	endElement();
+}
+
+bool SvgFixer::startElement(const QString & name, const QString & namespaceUri, const SvgAttributes & attributesIn)
+{
+	if (name == "use" && !attributeValue(attributesIn, "href").isEmpty() && !attributeValue(attributesIn, "id").isEmpty()) {
+		m_fallback = true;
+		return false;
+	}
+
+	OpenElement open;
+	bool root = m_open.isEmpty();
+	SvgAttributes attributes = attributesIn;
+	if (root) {
+		fixViewBox(attributes);
+	}
+
+	if (m_fixStrokeWidth) {
+		fixStroke(attributes);
+		StrokeState strokeState;
+		strokeState.stroke = attributeValue(attributes, "stroke");
+		strokeState.strokeWidth = attributeValue(attributes, "stroke-width");
+		m_strokes.append(strokeState);
+	}
+
+	// same as TextUtils::elevateTransform
+	SvgAttributes transform;
+	setAttributeValue(transform, "transform", attributeValue(attributes, "transform"));
+	if (!transform.first().value.isEmpty()) {
+		m_changed = true;
+		removeAttribute(attributes, "transform");
+		writeStartTag("g", QString(), transform);
+		open.outerGroups = 1;
+	}
+
+	writeStartTag(name, namespaceUri, attributes);
+
+	if (root && !m_viewBoxTranslate.isEmpty()) {
+		// the translated group has a transform too, so it is elevated as well
+		transform.first().value = m_viewBoxTranslate;
+		writeStartTag("g", QString(), transform);
+		writeStartTag("g", QString(), SvgAttributes());
+		open.innerGroups = 2;
+	}
+
+	m_open.append(open);
+	return true;
+}
+
+void SvgFixer::endElement()
+{
+	if (m_open.isEmpty()) return;
+
+	OpenElement open = m_open.takeLast();
+	if (m_fixStrokeWidth) {
+		m_strokes.removeLast();
+	}
+
+	for (int i = 0; i < open.innerGroups; i++) {
+		writeEndTag();
+	}
+	if (open.innerGroups > 0) {
+		// fixViewBox only moves elements into the translated group
+		for (const Node & node : m_rootTail) {
+			if (node.kind == Node::Comment) {
+				writeComment(node.text);
+			}
+			else if (node.kind == Node::ProcessingInstruction) {
+				writeProcessingInstruction(node.name, node.text);
+			}
+			else {
+				writeCharacters(node.text, node.kind == Node::CData);
+			}
+		}
+		m_rootTail.clear();
+	}
+	for (int i = 0; i < 1 + open.outerGroups; i++) {
+		writeEndTag();
+	}
+}
+
+void SvgFixer::characters(const QString & textIn, bool cdata)
+{
+	QString text = textIn;
+	fixUnits(text, false);
+
+	if (m_open.count() == 1 && !m_viewBoxTranslate.isEmpty()) {
+		Node node;
+		node.kind = cdata ? Node::CData : Node::Text;
+		node.text = text;
+		m_rootTail.push_back(node);
+		return;
+	}
+
+	writeCharacters(text, cdata);
+}
+
+void SvgFixer::comment(const QString & textIn)
+{
+	Node node;
+	node.kind = Node::Comment;
+	node.text = textIn;
+	if (!m_rootSeen) {
+		m_prolog.push_back(node);
+		return;
+	}
+
+	fixUnits(node.text, false);
+	if (m_open.count() == 1 && !m_viewBoxTranslate.isEmpty()) {
+		m_rootTail.push_back(node);
+		return;
+	}
+
+	writeComment(node.text);
+}
+
+void SvgFixer::processingInstruction(const QString & target, const QString & data)
+{
+	Node node;
+	node.kind = Node::ProcessingInstruction;
+	node.name = target;
+	node.text = data;
+	if (!m_rootSeen) {
+		m_prolog.push_back(node);
+		return;
+	}
+
+	fixUnits(node.text, false);
+	if (m_open.count() == 1 && !m_viewBoxTranslate.isEmpty()) {
+		m_rootTail.push_back(node);
+		return;
+	}
+
+	writeProcessingInstruction(target, node.text);
+}
+
+/**
+ * QDom writes the xml declaration first and the doctype before the first node that follows it.
+ */
+void SvgFixer::writeProlog()
+{
+	if (!m_declaration.isEmpty()) {
+		writeProcessingInstruction("xml", m_declaration);
+	}
+	m_output += m_doctype;
+	for (const Node & node : m_prolog) {
+		if (node.kind == Node::Comment) {
+			writeComment(node.text);
+		}
+		else {
+			writeProcessingInstruction(node.name, node.text);
+		}
+	}
+	m_prolog.clear();
+}
+
+/**
+ * QDom indents a node unless it follows text, and ends its line unless text follows it.
+ * The second half is only known once the next node arrives, hence m_newlinePending.
+ */
+void SvgFixer::beginNode(bool text)
+{
+	if (m_tagOpen) {
+		m_output += '>';
+		if (!text) {
+			m_output += '\n';
+		}
+		m_tagOpen = false;
+	}
+	else if (m_newlinePending && !text) {
+		m_output += '\n';
+	}
+	m_newlinePending = false;
+}
+
+void SvgFixer::writeStartTag(const QString & name, const QString & namespaceUri, const SvgAttributes & attributesIn)
+{
+	beginNode(false);
+	if (!m_afterText) {
+		m_output += QString(m_tags.count(), ' ');
+	}
+
+	m_output += '<' + name;
+	if (!namespaceUri.isEmpty()) {
+		m_output += " xmlns=\"" + encodeText(namespaceUri, true) + '"';
+	}
+
+	// QDom sorts attributes by name
+	SvgAttributes attributes = attributesIn;
+	std::stable_sort(attributes.begin(), attributes.end(), [](const SvgAttribute & a, const SvgAttribute & b) {
+		return a.name < b.name;
+	});
+	QStringList declared;
+	for (const auto & attribute : attributes) {
+		if (attribute.namespaceUri.isEmpty()) {
+			m_output += ' ' + attribute.name + "=\"" + encodeText(attribute.value, true) + '"';
+			continue;
+		}
+
+		m_output += ' ' + attribute.prefix + ':' + attribute.name + "=\"" + encodeText(attribute.value, true) + '"';
+		if (!attribute.prefix.isEmpty() && !declared.contains(attribute.prefix)) {
+			declared << attribute.prefix;
+			m_output += " xmlns:" + attribute.prefix + "=\"" + encodeText(attribute.namespaceUri, true) + '"';
+		}
+	}
+
+	m_tags << name;
+	m_tagOpen = true;
+	m_afterText = false;
+}
+
+void SvgFixer::writeEndTag()
+{
+	QString name = m_tags.takeLast();
+	if (m_tagOpen) {
+		m_output += "/>";
+		m_tagOpen = false;
+	}
+	else {
+		if (m_newlinePending) {
+			m_output += '\n';
+		}
+		if (!m_afterText) {
+			m_output += QString(m_tags.count(), ' ');
+		}
+		m_output += "</" + name + '>';
+	}
+
+	m_newlinePending = true;
+	m_afterText = false;
+}
+
+void SvgFixer::writeCharacters(const QString & text, bool cdata)
+{
+	beginNode(true);
+	if (cdata) {
+		m_output += "<![CDATA[" + text + "]]>";
+	}
+	else {
+		m_output += encodeText(text, false);
+	}
+	m_afterText = true;
+}
+
+void SvgFixer::writeComment(const QString & text)
+{
+	beginNode(false);
+	if (!m_afterText) {
+		m_output += QString(m_tags.count(), ' ');
+	}
+	m_output += "<!--" + text;
+	if (text.endsWith('-')) {
+		m_output += ' ';
+	}
+	m_output += "-->";
+	m_newlinePending = true;
+	m_afterText = false;
+}
+
+void SvgFixer::writeProcessingInstruction(const QString & target, const QString & data)
+{
+	beginNode(false);
+	m_output += "<?" + target + ' ' + data + "?>\n";
+	m_afterText = false;
+}
+
+/**
+ * Same conversions as TextUtils::fixInternalUnits, which runs its expressions over the text of
+ * everything after the root's start tag: quoted values with units, then stroke-width in styles.
+ */
+void SvgFixer::fixUnits(QString & text, bool attribute)
+{
+	if (m_unitState < 0) return;
+
+	if (attribute && !text.contains('"') && !text.contains('\'')) {
+		// an attribute value in its quotes only matches as a whole
+		if (InternalUnitsValue.match(text).hasMatch()) {
+			if (!unitsKnown()) return;
+
+			text = convertUnits(text);
+			m_changed = true;
+		}
+	}
+	else if (attribute) {
+		QString quoted = '"' + text + '"';
+		if (fixQuotedUnits(quoted)) {
+			text = quoted.mid(1, quoted.length() - 2);
+		}
+	}
+	else if (text.contains('"') || text.contains('\'')) {
+		fixQuotedUnits(text);
+	}
+
+	if (m_unitState < 0) return;
+
+	if (text.contains("stroke-width:")) {
+		fixStrokeWidthUnits(text);
+	}
+}
+
+bool SvgFixer::fixQuotedUnits(QString & text)
+{
+	bool result = false;
+	int from = 0;
+	while (true) {
+		QRegularExpressionMatch match;
+		from = text.indexOf(QuotedUnits, from, &match);
+		if (from < 0) break;
+
+		if (!unitsKnown()) return false;
+
+		QString old = match.captured(1) + match.captured(2);
+		text.replace(from + 1, old.length(), convertUnits(old));
+		m_changed = result = true;
+	}
+
+	return result;
+}
+
+void SvgFixer::fixStrokeWidthUnits(QString & text)
+{
+	int from = 0;
+	while (true) {
+		QRegularExpressionMatch match;
+		from = text.indexOf(StrokeWidthUnits, from, &match);
+		if (from < 0) break;
+
+		if (!unitsKnown()) return;
+
+		QString old = match.captured(1) + match.captured(2);
+		text.replace(from + 13, old.length(), convertUnits(old));
+		m_changed = true;
+	}
+}
+
+bool SvgFixer::unitsKnown()
+{
+	if (m_unitState == 0) {
+		// assumes width dpi = height dpi
+		QRectF viewBox;
+		QSizeF size = TextUtils::parseForWidthAndHeight(m_svg, viewBox, true);
+		if (size.width() == 0) {
+			// svg is messed up
+			m_unitState = -1;
+		}
+		else {
+			m_unitState = 1;
+			m_viewBoxWidth = viewBox.width();
+			m_width = size.width();
+		}
+	}
+
+	return m_unitState > 0;
+}
+
+QString SvgFixer::convertUnits(const QString & value)
+{
+	double in = TextUtils::convertToInches(value);
+	double replacement = in * m_viewBoxWidth / m_width;
+	return QString::number(replacement);
+}
+
+/**
+ * Same as TextUtils::fixViewBox: a viewBox that doesn't start at 0,0 is moved there and the content is translated instead.
+ */
+void SvgFixer::fixViewBox(SvgAttributes & attributes)
+{
+	QString viewBox = attributeValue(attributes, "viewBox");
+	if (viewBox.isEmpty()) return;
+
+	QStringList coords = viewBox.split(ViewBoxSeparator);
+	if (coords.length() != 4) return;
+
+	if (coords[0] == "0" && coords[1] == "0") return;
+
+	if (auto x = TextUtils::optToDouble(coords.at(0))) {
+		if (auto y = TextUtils::optToDouble(coords.at(1))) {
+			setAttributeValue(attributes, "viewBox", QString("0 0 %1 %2").arg(coords[2], coords[3]));
+			m_viewBoxTranslate = QString("translate(%1,%2)").arg(-*x).arg(-*y);
+			m_changed = true;
+		}
+	}
+}
+
+/**
+ * Same as TextUtils::fixStrokeWidth for one element, with m_strokes standing in for the ancestors.
+ */
+void SvgFixer::fixStroke(SvgAttributes & attributes)
+{
+	QString stroke = attributeValue(attributes, "stroke");
+	if (stroke.isEmpty()) {
+		QString style = attributeValue(attributes, "style");
+		if (style.contains("stroke")) {
+			fixStyle(attributes, style);
+			stroke = attributeValue(attributes, "stroke");
+		}
+	}
+
+	if (stroke.isEmpty()) return;
+	if (stroke == "none") return;
+	if (!attributeValue(attributes, "stroke-width").isEmpty()) return;
+
+	m_changed = true;
+	for (int i = m_strokes.count() - 1; i >= 0; i--) {
+		if (TextUtils::optToDouble(m_strokes.at(i).strokeWidth)) return;
+		if (m_strokes.at(i).stroke == "none") return;
+	}
+
+	// default if there is no value to inherit
+	setAttributeValue(attributes, "stroke-width", "1");
+}
+
+void SvgFixer::fixStyle(SvgAttributes & attributes, QString style)
+{
+	static const QList<QRegularExpression> StyleExpressions = [] {
+		QList<QRegularExpression> expressions;
+		Q_FOREACH (QString name, StyleAttributeNames) {
+			expressions.append(QRegularExpression(QString("%1[\\s]*:[\\s]*([^;]*)[;]?").arg(name)));
+		}
+		return expressions;
+	}();
+
+	for (int i = 0; i < StyleAttributeNames.count(); i++) {
+		QRegularExpressionMatch match = StyleExpressions.at(i).match(style);
+		if (match.hasMatch()) {
+			QString value = match.captured(1);
+			style.remove(StyleExpressions.at(i));
+			setAttributeValue(attributes, StyleAttributeNames.at(i), value);
+		}
+	}
+
+	if (style.trimmed().isEmpty()) {
+		removeAttribute(attributes, "style");
+	}
+	else {
+		setAttributeValue(attributes, "style", style);
+	}
+}
+
+}
+
+/**
+ * Applies the svg clean ups Fritzing relies on in a single streaming pass; see SvgFixer.
+ * Falls back to fixMuchDom for documents that need <use> expansion or that the stream reader
+ * can not handle. Returns true (and replaces svg) if anything was changed; the result is the
+ * same text fixMuchDom produces.
+ */
 bool TextUtils::fixMuch(QString &svg, bool fixStrokeWidthFlag)
+{
+	// sodipodi markup is removed from the text first, as fixMuchDom does: that only takes out double quoted attributes
+	QString cleaned = svg;
+	bool result = (svg.contains("sodipodi:") || svg.contains("inkscape:")) && cleanSodipodi(cleaned);
+
+	SvgFixer fixer(cleaned, fixStrokeWidthFlag);
+	if (!fixer.run()) {
+		return fixMuchDom(svg, fixStrokeWidthFlag);
+	}
+
+	if (!result && !fixer.changed()) return false;
+
+	svg = removeXMLEntities(fixer.output());
+	return true;
+}
+
+/**
+ * DOM based version of fixMuch, kept for <use> expansion and as the reference for the streaming version.
+ */
+bool TextUtils::fixMuchDom(QString &svg, bool fixStrokeWidthFlag)
 {
 	bool result = cleanSodipodi(svg);
 	result |= fixInternalUnits(svg);
@@ -1241,9 +2158,13 @@ bool TextUtils::fixStrokeWidth(QDomDocument & svgDoc) {
 bool TextUtils::noPatternAux(QDomDocument & svgDom, const QString & tag)
 {
 	bool result = false;
+	// elementsByTagName is live, so collect first; removing while iterating skipped every other element
+	QList<QDomNode> patterns;
 	QDomNodeList nodeList = svgDom.elementsByTagName(tag);
 	for (int i = 0; i < nodeList.count(); i++) {
-		QDomNode pattern = nodeList.at(i);
+		patterns.append(nodeList.at(i));
+	}
+	for (QDomNode & pattern : patterns) {
 		pattern.parentNode().removeChild(pattern);
 		result = true;
 	}
@@ -112,6 +112,7 @@ public:
 	static void gornTree(QDomDocument &);
 	static bool elevateTransform(QDomElement &);
 	static bool fixMuch(QString &svg, bool fixStrokeWidth);
+	static bool fixMuchDom(QString &svg, bool fixStrokeWidth);
 	static bool fixInternalUnits(QString & svg);
 	static bool fixFonts(QString & svg, const QString & destFont, bool & reallyFixed);
 	static void fixStyleAttribute(QDomElement & element);
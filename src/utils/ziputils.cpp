@@ -0,0 +1,348 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "ziputils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QUuid>
+#include <QtConcurrentMap>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <zlib.h>
+
+#include <filesystem>
+#include <system_error>
+
+const int ZipUtils::BufferSize = 64 * 1024;
+
+namespace {
+
+// entries up to this size are compressed in memory on the thread pool;
+// anything bigger is streamed through QuaZip on the calling thread
+constexpr qint64 InMemoryEntrySize = 16 * 1024 * 1024;
+
+// upper bound on the input bytes compressed in memory at once
+constexpr qint64 BatchSize = 64 * 1024 * 1024;
+
+struct ZipEntry {
+	QString filepath;
+	QString name;
+	qint64 size = 0;
+	bool stored = false;
+
+	// filled in by compress()
+	QByteArray data;
+	quint32 crc = 0;
+	QString error;
+};
+
+void compress(ZipEntry & entry)
+{
+	QFile file(entry.filepath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		entry.error = QString("open %1: %2").arg(entry.filepath, file.errorString());
+		return;
+	}
+
+	z_stream stream {};
+	if (!entry.stored && deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		entry.error = QString("deflateInit2 %1").arg(entry.name);
+		return;
+	}
+
+	QByteArray in(ZipUtils::BufferSize, Qt::Uninitialized);
+	QByteArray out(ZipUtils::BufferSize, Qt::Uninitialized);
+	uLong crc = crc32(0L, Z_NULL, 0);
+	qint64 size = 0;
+	int flush = Z_NO_FLUSH;
+	do {
+		qint64 count = file.read(in.data(), in.size());
+		if (count < 0) {
+			entry.error = QString("read %1: %2").arg(entry.filepath, file.errorString());
+			break;
+		}
+
+		crc = crc32(crc, reinterpret_cast<const Bytef *>(in.constData()), (uInt) count);
+		size += count;
+		flush = file.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+		if (entry.stored) {
+			entry.data.append(in.constData(), count);
+			continue;
+		}
+
+		stream.next_in = reinterpret_cast<Bytef *>(in.data());
+		stream.avail_in = (uInt) count;
+		do {
+			stream.next_out = reinterpret_cast<Bytef *>(out.data());
+			stream.avail_out = (uInt) out.size();
+			deflate(&stream, flush);
+			entry.data.append(out.constData(), out.size() - stream.avail_out);
+		} while (stream.avail_out == 0);
+	} while (flush != Z_FINISH);
+
+	if (!entry.stored) deflateEnd(&stream);
+	entry.crc = crc;
+	entry.size = size;
+}
+
+bool writeRaw(QuaZip & zip, const ZipEntry & entry, QString & error)
+{
+	QuaZipFile outFile(&zip);
+	QuaZipNewInfo info(entry.name, entry.filepath);
+	info.uncompressedSize = entry.size;
+	int method = entry.stored ? 0 : Z_DEFLATED;
+	if (!outFile.open(QIODevice::WriteOnly, info, nullptr, entry.crc, method, Z_DEFAULT_COMPRESSION, true)) {
+		error = QString("outFile.open(): %1").arg(outFile.getZipError());
+		return false;
+	}
+
+	outFile.write(entry.data);
+	outFile.close();
+	if (outFile.getZipError() != UNZ_OK) {
+		error = QString("outFile.close(): %1").arg(outFile.getZipError());
+		return false;
+	}
+
+	return true;
+}
+
+bool writeStreamed(QuaZip & zip, const ZipEntry & entry, QString & error)
+{
+	QFile inFile(entry.filepath);
+	if (!inFile.open(QIODevice::ReadOnly)) {
+		error = QString("inFile.open(): %1").arg(inFile.errorString());
+		return false;
+	}
+
+	QuaZipFile outFile(&zip);
+	int method = entry.stored ? 0 : Z_DEFLATED;
+	if (!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(entry.name, entry.filepath), nullptr, 0, method)) {
+		error = QString("outFile.open(): %1").arg(outFile.getZipError());
+		return false;
+	}
+
+	QByteArray buffer(ZipUtils::BufferSize, Qt::Uninitialized);
+	qint64 count;
+	while ((count = inFile.read(buffer.data(), buffer.size())) > 0) {
+		if (outFile.write(buffer.constData(), count) != count) break;
+	}
+	if (count < 0 || outFile.getZipError() != UNZ_OK) {
+		error = QString("outFile.write(): %1 %2").arg(outFile.getZipError()).arg(inFile.errorString());
+		return false;
+	}
+
+	outFile.close();
+	if (outFile.getZipError() != UNZ_OK) {
+		error = QString("outFile.close(): %1").arg(outFile.getZipError());
+		return false;
+	}
+
+	return true;
+}
+
+bool writeBatch(QuaZip & zip, QList<ZipEntry> & batch, QString & error)
+{
+	QtConcurrent::blockingMap(batch, compress);
+	Q_FOREACH (const ZipEntry & entry, batch) {
+		if (!entry.error.isEmpty()) {
+			error = entry.error;
+			return false;
+		}
+		if (!writeRaw(zip, entry, error)) return false;
+	}
+
+	batch.clear();
+	return true;
+}
+
+std::filesystem::path toPath(const QString & filepath)
+{
+#ifdef Q_OS_WIN
+	return std::filesystem::path(filepath.toStdWString());
+#else
+	return std::filesystem::path(QFile::encodeName(filepath).toStdString());
+#endif
+}
+
+// rename over an existing file in one step where the file system allows it
+bool replaceFile(const QString & source, const QString & dest)
+{
+	std::error_code ec;
+	std::filesystem::rename(toPath(source), toPath(dest), ec);
+	if (!ec) return true;
+
+	QFile::remove(dest);
+	return QFile::rename(source, dest);
+}
+
+QString safeFileName(QString name)
+{
+	static QChar badCharacters[] = { '\\', '/', ':', '*', '?', '"', '<', '>', '|' };
+	static QChar underscore('_');
+
+	for (int i = 0; i < name.length(); i++) {
+		if (name[i].unicode() < 32) {
+			name.replace(i, 1, &underscore, 1);
+		}
+		else for (auto badCharacter : badCharacters) {
+				if (name[i] == badCharacter) {
+					name.replace(i, 1, &underscore, 1);
+					break;
+				}
+			}
+	}
+
+	return name;
+}
+
+}
+
+bool ZipUtils::storeOnly(const QString & filename)
+{
+	static const QStringList Compressed = {
+		"png", "jpg", "jpeg", "gif", "webp",
+		"zip", "gz", "7z", "fzz", "fzpz", "fzbz",
+	};
+
+	return Compressed.contains(QFileInfo(filename).suffix(), Qt::CaseInsensitive);
+}
+
+bool ZipUtils::zip(const QStringList & filepaths, const QString & zipFilepath, QString & error)
+{
+	QFileInfo zipInfo(zipFilepath);
+	QString tempFilepath = zipInfo.dir().filePath(QString(".%1.%2.tmp").arg(zipInfo.fileName(), QUuid::createUuid().toString(QUuid::Id128)));
+
+	bool result = true;
+	{
+		QuaZip zip(tempFilepath);
+		if (!zip.open(QuaZip::mdCreate)) {
+			error = QString("zip.open(): %1").arg(zip.getZipError());
+			return false;
+		}
+
+		QList<ZipEntry> batch;
+		qint64 batchSize = 0;
+		Q_FOREACH (QString filepath, filepaths) {
+			ZipEntry entry;
+			entry.filepath = filepath;
+			entry.name = QFileInfo(filepath).fileName();
+			entry.size = QFileInfo(filepath).size();
+			entry.stored = storeOnly(filepath);
+			if (entry.size > InMemoryEntrySize) {
+				// keep the entry order: flush what is pending before streaming the big one
+				result = writeBatch(zip, batch, error) && writeStreamed(zip, entry, error);
+				batchSize = 0;
+			}
+			else {
+				batch.append(entry);
+				batchSize += entry.size;
+				if (batchSize >= BatchSize) {
+					result = writeBatch(zip, batch, error);
+					batchSize = 0;
+				}
+			}
+			if (!result) break;
+		}
+		if (result) result = writeBatch(zip, batch, error);
+
+		zip.close();
+		if (result && zip.getZipError() != 0) {
+			error = QString("zip.close(): %1").arg(zip.getZipError());
+			result = false;
+		}
+	}
+
+	if (result && !replaceFile(tempFilepath, zipFilepath)) {
+		error = QString("renaming %1 to %2 failed").arg(tempFilepath, zipFilepath);
+		result = false;
+	}
+	if (!result) QFile::remove(tempFilepath);
+
+	return result;
+}
+
+bool ZipUtils::unzip(const QString & zipFilepath, const QString & dirToDecompress, QString & error)
+{
+	QuaZip zip(zipFilepath);
+	if (!zip.open(QuaZip::mdUnzip)) {
+		error = QString("zip.open(): %1").arg(zip.getZipError());
+		return false;
+	}
+
+	zip.setFileNameCodec("IBM866");
+	QuaZipFile file(&zip);
+	QFile out;
+	QByteArray buffer(BufferSize, Qt::Uninitialized);
+	for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+		if (!file.open(QIODevice::ReadOnly)) {
+			error = QString("file.open(): %1").arg(file.getZipError());
+			return false;
+		}
+		QString name = file.getActualFileName();
+		if (file.getZipError() != UNZ_OK) {
+			error = QString("file.getFileName(): %1").arg(file.getZipError());
+			return false;
+		}
+
+		out.setFileName(dirToDecompress + "/" + name);
+		// this will fail if "name" contains subdirectories, but we don't mind that
+		if (!out.open(QIODevice::WriteOnly)) {
+			out.setFileName(dirToDecompress + "/" + safeFileName(name));
+			if (!out.open(QIODevice::WriteOnly)) {
+				error = QString("out.open(): %1").arg(out.errorString());
+				return false;
+			}
+		}
+
+		qint64 count;
+		while ((count = file.read(buffer.data(), buffer.size())) > 0) {
+			if (out.write(buffer.constData(), count) != count) {
+				error = QString("out.write(): %1").arg(out.errorString());
+				return false;
+			}
+		}
+		out.close();
+
+		if (count < 0 || file.getZipError() != UNZ_OK) {
+			error = QString("file.read(): %1").arg(file.getZipError());
+			return false;
+		}
+		if (!file.atEnd()) {
+			error = "read all but not EOF";
+			return false;
+		}
+		file.close();
+		if (file.getZipError() != UNZ_OK) {
+			error = QString("file.close(): %1").arg(file.getZipError());
+			return false;
+		}
+	}
+
+	zip.close();
+	if (zip.getZipError() != UNZ_OK) {
+		error = QString("zip.close(): %1").arg(zip.getZipError());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,43 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef ZIPUTILS_H
+#define ZIPUTILS_H
+
+#include <QString>
+#include <QStringList>
+
+// reading and writing the flat zip archives behind .fzz, .fzpz and .fzbz files
+
+class ZipUtils
+{
+public:
+	// writes the files into a temp file next to zipFilepath, which then replaces zipFilepath
+	static bool zip(const QStringList & filepaths, const QString & zipFilepath, QString & error);
+	static bool unzip(const QString & zipFilepath, const QString & dirToDecompress, QString & error);
+
+	// already compressed formats, which are stored rather than deflated
+	static bool storeOnly(const QString & filename);
+
+public:
+	static const int BufferSize;
+};
+
+#endif
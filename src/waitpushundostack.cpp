@@ -45,6 +45,69 @@ void CommandTimer::timedout() {
 
 /////////////////////////////////
 
+UndoEntry::UndoEntry(QUndoCommand * command)
+	: QUndoCommand(command->text()),
+	m_command(command)
+{
+}
+
+UndoEntry::~UndoEntry() {
+	delete m_command;
+}
+
+void UndoEntry::undo() {
+	if (m_command == nullptr) return;
+
+	m_command->undo();
+	setObsolete(m_command->isObsolete());
+}
+
+void UndoEntry::redo() {
+	if (m_command == nullptr) return;
+
+	m_command->redo();
+	setObsolete(m_command->isObsolete());
+}
+
+int UndoEntry::id() const {
+	return m_command == nullptr ? -1 : m_command->id();
+}
+
+bool UndoEntry::mergeWith(const QUndoCommand * other) {
+	const auto * entry = dynamic_cast<const UndoEntry *>(other);
+	if (m_command == nullptr || entry == nullptr || entry->m_command == nullptr) return false;
+	if (!m_command->mergeWith(entry->m_command)) return false;
+
+	setText(m_command->text());
+	setObsolete(m_command->isObsolete());
+	m_cost = -1;
+	return true;
+}
+
+qint64 UndoEntry::cost() const {
+	// worked out on first use, after the push has run the command and its clean ups
+	if (m_cost < 0) {
+		m_cost = (m_command == nullptr) ? 0 : WaitPushUndoStack::estimatedCost(m_command);
+	}
+	return m_cost;
+}
+
+void UndoEntry::trim() {
+	if (m_command == nullptr) return;
+
+	delete m_command;
+	m_command = nullptr;
+	m_cost = 0;
+	setObsolete(true);
+	// the undo action and the history list show this, so it is clear the history was cut here
+	setText(QCoreApplication::translate("UndoEntry", "%1 (no longer undoable)").arg(text()));
+}
+
+/////////////////////////////////
+
+int WaitPushUndoStack::MemoryBudget = 512;
+const qint64 WaitPushUndoStack::CommandOverhead = 128;		// QUndoCommand's private data and the allocations behind it
+
 WaitPushUndoStack::WaitPushUndoStack(QObject * parent) :
 	QUndoStack(parent)
 {
@@ -68,12 +131,80 @@ void WaitPushUndoStack::push(QUndoCommand * cmd)
 #ifndef QT_NO_DEBUG
 	writeUndo(cmd, 0, nullptr);
 #endif
-	if (m_temporary == cmd) {
-		m_temporary->redo();
-		return;
+	{
+		CommandBatch batch;
+		if (m_temporary == cmd) {
+			m_temporary->redo();
+			return;
+		}
+
+		QUndoStack::push(new UndoEntry(cmd));
+	}
+
+	// the batch has flushed by now, so the routing status its clean ups added to cmd is counted
+	trimToBudget();
+}
+
+void WaitPushUndoStack::setMemoryBudget(int megabytes) {
+	MemoryBudget = qMax(0, megabytes);
+}
+
+int WaitPushUndoStack::memoryBudget() {
+	return MemoryBudget;
+}
+
+qint64 WaitPushUndoStack::estimatedCost(const QUndoCommand * cmd) {
+	qint64 cost = CommandOverhead;
+	const auto * bcmd = dynamic_cast<const BaseCommand *>(cmd);
+	if (bcmd != nullptr) {
+		cost += bcmd->memoryCost();
+		for (int i = 0; i < bcmd->subCommandCount(); i++) {
+			cost += estimatedCost(bcmd->subCommand(i));
+		}
+	}
+	else {
+		// a plain macro parent
+		cost += sizeof(QUndoCommand) + cmd->text().capacity() * (qint64) sizeof(QChar);
 	}
 
-	QUndoStack::push(cmd);
+	for (int i = 0; i < cmd->childCount(); i++) {
+		cost += estimatedCost(cmd->child(i));
+	}
+	return cost;
+}
+
+qint64 WaitPushUndoStack::estimatedCost() const {
+	qint64 total = 0;
+	for (int i = 0; i < count(); i++) {
+		const auto * entry = dynamic_cast<const UndoEntry *>(command(i));
+		if (entry != nullptr) total += entry->cost();
+	}
+	return total;
+}
+
+void WaitPushUndoStack::trimToBudget() {
+	if (MemoryBudget <= 0) return;
+
+	// keep the newest entries that fit, and everything that can still be redone;
+	// what is older goes, so that undo stops where the history was cut
+	qint64 budget = (qint64) MemoryBudget * 1024 * 1024;
+	qint64 total = 0;
+	bool trimming = false;
+	for (int i = count() - 1; i >= 0; i--) {
+		auto * entry = dynamic_cast<UndoEntry *>(const_cast<QUndoCommand *>(command(i)));
+		if (entry == nullptr) continue;
+
+		if (trimming) {
+			entry->trim();
+			continue;
+		}
+
+		total += entry->cost();
+		if (total > budget && i < index() - 1) {
+			entry->trim();
+			trimming = true;
+		}
+	}
 }
 
 
@@ -27,6 +27,29 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QFile>
 #include <QPointer>
 
+// Wraps each command pushed onto a WaitPushUndoStack, so that the command can be deleted when
+// the stack is over its memory budget. QUndoStack only drops its oldest entries through an undo
+// limit that can't change once it holds anything, so a trimmed entry stays behind as an obsolete
+// stub instead, labelled as no longer undoable: undoing it does nothing and QUndoStack deletes it.
+class UndoEntry : public QUndoCommand
+{
+public:
+	UndoEntry(QUndoCommand *);
+	~UndoEntry();
+
+	void undo() override;
+	void redo() override;
+	int id() const override;
+	bool mergeWith(const QUndoCommand *) override;
+
+	qint64 cost() const;
+	void trim();
+
+protected:
+	QUndoCommand * m_command = nullptr;
+	mutable qint64 m_cost = -1;
+};
+
 class WaitPushUndoStack : public QUndoStack
 {
 	Q_OBJECT
@@ -34,6 +57,11 @@ public:
 	WaitPushUndoStack(QObject * parent = 0);
 	~WaitPushUndoStack();
 
+	static void setMemoryBudget(int megabytes);
+	static int memoryBudget();
+	static qint64 estimatedCost(const QUndoCommand *);
+	qint64 estimatedCost() const;
+
 	void waitPush(QUndoCommand *, int delayMS);
 	void waitPushTemporary(QUndoCommand *, int delayMS);
 	void resolveTemporary();
@@ -53,6 +81,7 @@ protected:
 #endif
 
 protected:
+	void trimToBudget();
 	void clearDeadTimers();
 	void clearLiveTimers();
 	void clearTimers(QList<QTimer *> &);
@@ -62,6 +91,9 @@ protected:
 	QList<QTimer *> m_liveTimers;
 	QMutex m_mutex;
 	QUndoCommand * m_temporary;
+
+	static int MemoryBudget;			// in megabytes, 0 for no limit
+	static const qint64 CommandOverhead;
 };
 
 
@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = test_gerber test_svg test_textutils test_svg2gerber test_ngspice_simulator test_project_properties
+SUBDIRS = test_gerber test_svg test_textutils test_svg2gerber test_ngspice_simulator test_project_properties test_debugdialog test_bezier test_ipc test_gridindex test_ziputils test_contourtracer test_levelofdetail test_localclipboard test_sketch
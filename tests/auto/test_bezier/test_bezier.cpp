@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE BEZIER Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "utils/bezier.h"
+
+#include <QLineF>
+#include <QRandomGenerator>
+#include <QtMath>
+
+#include <limits>
+
+/*
+Testing bezier.cpp: cached length, length to t, flattening and nearest point search.
+The searches are timed in tests/benchmarks/bench_bezier.
+*/
+
+namespace {
+
+Bezier makeCurve(QRandomGenerator & random)
+{
+	auto point = [&random]() {
+		return QPointF(random.bounded(200.0), random.bounded(200.0));
+	};
+	return Bezier(point(), point(), point(), point());
+}
+
+double distanceSqd(QPointF a, QPointF b)
+{
+	QPointF d = a - b;
+	return d.x() * d.x() + d.y() * d.y();
+}
+
+// the search findSplit used before: one step per unit of length
+double bruteForceT(const Bezier & bezier, QPointF p)
+{
+	double bestT = 0;
+	double best = std::numeric_limits<double>::max();
+	double increment = 1.0 / qMax(1.0, bezier.computeCubicCurveLength(1.0, 24));
+	for (double t = 0; t <= 1; t += increment) {
+		double d = distanceSqd(p, bezier.pointAt(t));
+		if (d < best) {
+			best = d;
+			bestT = t;
+		}
+	}
+	return bestT;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( bezier_length_cache )
+{
+	Bezier bezier(QPointF(0, 0), QPointF(100, 0), QPointF(0, 0), QPointF(100, 0));
+	BOOST_CHECK_CLOSE(bezier.length(), 100.0, 0.001);
+
+	bezier.set_cp0(QPointF(0, 50));
+	BOOST_CHECK_CLOSE(bezier.length(), bezier.computeCubicCurveLength(1.0, 24), 0.0001);
+	BOOST_CHECK(bezier.length() > 100);
+
+	bezier.set_endpoints(QPointF(0, 0), QPointF(0, 0));
+	BOOST_CHECK_CLOSE(bezier.length(), bezier.computeCubicCurveLength(1.0, 24), 0.0001);
+
+	Bezier left, right;
+	bezier.set_endpoints(QPointF(0, 0), QPointF(100, 0));
+	bezier.split(0.5, left, right);
+	BOOST_CHECK_CLOSE(left.length() + right.length(), bezier.length(), 0.01);
+}
+
+BOOST_AUTO_TEST_CASE( bezier_t_at_length )
+{
+	QRandomGenerator random(1234);
+	for (int i = 0; i < 100; i++) {
+		Bezier bezier = makeCurve(random);
+		double length = bezier.length();
+		for (double fraction : { 0.1, 0.5, 0.9 }) {
+			double t = bezier.tAtLength(length * fraction);
+			BOOST_CHECK_SMALL(bezier.computeCubicCurveLength(t, 24) - length * fraction, 0.001);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( bezier_flatten )
+{
+	QRandomGenerator random(5678);
+	for (int i = 0; i < 100; i++) {
+		Bezier bezier = makeCurve(random);
+		QList<double> ts;
+		QPolygonF points = bezier.flatten(0.25, &ts);
+		BOOST_REQUIRE_EQUAL(points.count(), ts.count());
+		BOOST_CHECK(points.first() == bezier.endpoint0());
+		BOOST_CHECK(points.last() == bezier.endpoint1());
+		for (int j = 0; j < points.count(); j++) {
+			BOOST_CHECK_SMALL(distanceSqd(points.at(j), bezier.pointAt(ts.at(j))), 1e-9);
+		}
+		for (int j = 0; j < points.count() - 1; j++) {
+			// the curve halfway between two points stays close to the segment
+			QPointF mid = bezier.pointAt((ts.at(j) + ts.at(j + 1)) / 2);
+			QLineF segment(points.at(j), points.at(j + 1));
+			QLineF normal = segment.normalVector();
+			normal.setLength(1);
+			double cross = qAbs((mid.x() - segment.x1()) * normal.dx() + (mid.y() - segment.y1()) * normal.dy());
+			BOOST_CHECK(cross <= 0.25 + 1e-6);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( bezier_nearest )
+{
+	QRandomGenerator random(91011);
+	for (int i = 0; i < 200; i++) {
+		Bezier bezier = makeCurve(random);
+		QPointF p(random.bounded(200.0), random.bounded(200.0));
+		double t = bezier.nearestT(p);
+		double expected = bruteForceT(bezier, p);
+		// as close as the old per-unit stepping, give or take the flattening tolerance
+		BOOST_CHECK(qSqrt(distanceSqd(p, bezier.pointAt(t))) <= qSqrt(distanceSqd(p, bezier.pointAt(expected))) + 0.5);
+
+		// a point on the curve finds itself
+		double onT = random.bounded(1.0);
+		QPointF on = bezier.pointAt(onT);
+		BOOST_CHECK_SMALL(distanceSqd(on, bezier.pointAt(bezier.nearestT(on))), 1e-6);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( bezier_find_split_min_distance )
+{
+	// up and back down: p is about 6.7 from the start and 4 from the other leg
+	Bezier bezier(QPointF(0, 0), QPointF(10, 0), QPointF(0, 100), QPointF(10, 100));
+	QPointF p(6, 3);
+	BOOST_CHECK(bezier.nearestT(p) > 0.9);
+
+	// the first local minimum is close enough
+	BOOST_CHECK(bezier.findSplit(p, 7) < 0.1);
+
+	// it is not, so the search goes on to the nearer leg
+	BOOST_CHECK_CLOSE(bezier.findSplit(p, 1), bezier.nearestT(p), 0.001);
+}
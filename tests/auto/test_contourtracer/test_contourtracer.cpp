@@ -0,0 +1,223 @@
+#define BOOST_TEST_MODULE CONTOURTRACER Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "svg/contourtracer.h"
+
+#include <QImage>
+#include <QRandomGenerator>
+
+#include <cmath>
+
+/*
+Testing contourtracer.cpp: the traced outlines must cover the same pixels as the union of
+per-row rectangles that LogoItem used to build. Tracing is timed in
+tests/benchmarks/bench_contourtracer.
+*/
+
+using namespace ClipperLib;
+
+namespace {
+
+QImage randomImage(QRandomGenerator & random, int width, int height, int density)
+{
+	QImage image(width, height, QImage::Format_ARGB32);
+	for (int y = 0; y < height; y++) {
+		auto * line = reinterpret_cast<QRgb *>(image.scanLine(y));
+		for (int x = 0; x < width; x++) {
+			line[x] = random.bounded(100) < density ? qRgb(255, 255, 255) : qRgb(0, 0, 0);
+		}
+	}
+	return image;
+}
+
+// a logo-like picture: rings with holes, islands inside the holes, and some noise
+QImage logoImage(int size)
+{
+	QImage image(size, size, QImage::Format_ARGB32);
+	QRandomGenerator random(99);
+	double center = size / 2.0;
+	for (int y = 0; y < size; y++) {
+		auto * line = reinterpret_cast<QRgb *>(image.scanLine(y));
+		for (int x = 0; x < size; x++) {
+			double r = std::hypot(x - center, y - center) / size;
+			bool on = (int) (r * 40) % 3 == 0 || ((x / 7 + y / 5) % 11 == 0 && random.bounded(4) == 0);
+			line[x] = on ? qRgb(0, 0, 0) : qRgb(200, 180, 160);
+		}
+	}
+	return image;
+}
+
+int setPixels(const QImage & image)
+{
+	int count = 0;
+	for (int y = 0; y < image.height(); y++) {
+		for (int x = 0; x < image.width(); x++) {
+			if (qGray(image.pixel(x, y)) != 0) count++;
+		}
+	}
+	return count;
+}
+
+// one rectangle per horizontal run, unioned by Clipper
+Paths reference(const QImage & image)
+{
+	Paths spans;
+	for (int y = 0; y < image.height(); y++) {
+		int x = 0;
+		while (x < image.width()) {
+			if (qGray(image.pixel(x, y)) == 0) {
+				x++;
+				continue;
+			}
+			int start = x;
+			while (x < image.width() && qGray(image.pixel(x, y)) != 0) x++;
+
+			Path span;
+			span << IntPoint(start, y) << IntPoint(x, y) << IntPoint(x, y + 1) << IntPoint(start, y + 1);
+			spans << span;
+		}
+	}
+
+	Clipper clipper;
+	clipper.AddPaths(spans, ptSubject, true);
+	Paths result;
+	clipper.Execute(ctUnion, result, pftNonZero, pftNonZero);
+	return result;
+}
+
+double totalArea(const Paths & paths)
+{
+	double area = 0;
+	for (const Path & path : paths) {
+		area += Area(path);
+	}
+	return area;
+}
+
+double differenceArea(const Paths & a, const Paths & b)
+{
+	Clipper clipper;
+	clipper.AddPaths(a, ptSubject, true);
+	clipper.AddPaths(b, ptClip, true);
+	Paths result;
+	clipper.Execute(ctXor, result, pftNonZero, pftNonZero);
+	double area = 0;
+	for (const Path & path : result) {
+		area += std::abs(Area(path));
+	}
+	return area;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_single_pixel )
+{
+	QImage image(3, 3, QImage::Format_ARGB32);
+	image.fill(qRgb(0, 0, 0));
+	image.setPixel(1, 1, qRgb(255, 255, 255));
+
+	Paths paths = ContourTracer::trace(image);
+	BOOST_REQUIRE_EQUAL(paths.size(), 1u);
+	BOOST_CHECK_EQUAL(paths[0].size(), 4u);
+	BOOST_CHECK_EQUAL(Area(paths[0]), 1.0);
+	BOOST_CHECK(Orientation(paths[0]));
+
+	image.fill(qRgb(0, 0, 0));
+	BOOST_CHECK(ContourTracer::trace(image).empty());
+	BOOST_CHECK(ContourTracer::trace(QImage()).empty());
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_holes )
+{
+	// a frame with a single pixel island in the middle
+	QImage image(5, 5, QImage::Format_ARGB32);
+	image.fill(qRgb(255, 255, 255));
+	for (int y = 1; y < 4; y++) {
+		for (int x = 1; x < 4; x++) {
+			image.setPixel(x, y, qRgb(0, 0, 0));
+		}
+	}
+	image.setPixel(2, 2, qRgb(255, 255, 255));
+
+	Paths paths = ContourTracer::trace(image);
+	BOOST_REQUIRE_EQUAL(paths.size(), 3u);
+	int outer = 0;
+	for (const Path & path : paths) {
+		BOOST_CHECK_EQUAL(path.size(), 4u);
+		if (Orientation(path)) outer++;
+	}
+	BOOST_CHECK_EQUAL(outer, 2);
+	BOOST_CHECK_EQUAL(totalArea(paths), 17.0);
+	BOOST_CHECK_EQUAL(differenceArea(paths, reference(image)), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_matches_union )
+{
+	QRandomGenerator random(12345);
+	for (int i = 0; i < 200; i++) {
+		QImage image = randomImage(random, 1 + random.bounded(40), 1 + random.bounded(40), random.bounded(101));
+		Paths paths = ContourTracer::trace(image);
+		BOOST_CHECK_EQUAL(totalArea(paths), (double) setPixels(image));
+		BOOST_CHECK_EQUAL(differenceArea(paths, reference(image)), 0.0);
+
+		// no points in the middle of a straight edge
+		for (const Path & path : paths) {
+			for (size_t j = 0; j < path.size(); j++) {
+				const IntPoint & a = path[(j + path.size() - 1) % path.size()];
+				const IntPoint & b = path[j];
+				const IntPoint & c = path[(j + 1) % path.size()];
+				BOOST_CHECK(!((a.X == b.X && b.X == c.X) || (a.Y == b.Y && b.Y == c.Y)));
+			}
+		}
+
+		Paths all = ContourTracer::trace(image, ContourTracer::KeepAllPoints);
+		BOOST_CHECK_EQUAL(differenceArea(all, paths), 0.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_formats )
+{
+	QRandomGenerator random(777);
+	QImage image = randomImage(random, 67, 31, 50);
+	Paths expected = ContourTracer::trace(image);
+
+	QList<QImage::Format> formats;
+	formats << QImage::Format_Mono << QImage::Format_MonoLSB << QImage::Format_Indexed8
+	        << QImage::Format_Grayscale8 << QImage::Format_RGB32 << QImage::Format_RGB888
+	        << QImage::Format_ARGB32_Premultiplied;
+	for (QImage::Format format : formats) {
+		QImage converted = image.convertToFormat(format);
+		BOOST_CHECK_EQUAL(setPixels(converted), setPixels(image));
+		BOOST_CHECK(ContourTracer::trace(converted) == expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_staircases )
+{
+	// a disk of radius 100
+	QImage image(240, 240, QImage::Format_ARGB32);
+	for (int y = 0; y < image.height(); y++) {
+		for (int x = 0; x < image.width(); x++) {
+			bool inside = std::hypot(x + 0.5 - 120, y + 0.5 - 120) < 100;
+			image.setPixel(x, y, inside ? qRgb(255, 255, 255) : qRgb(0, 0, 0));
+		}
+	}
+	Paths exact = ContourTracer::trace(image);
+	Paths smooth = ContourTracer::trace(image, ContourTracer::RemoveCollinear | ContourTracer::SmoothStaircases, 1.0);
+
+	size_t exactPoints = 0, smoothPoints = 0;
+	for (const Path & path : exact) exactPoints += path.size();
+	for (const Path & path : smooth) smoothPoints += path.size();
+	BOOST_REQUIRE_EQUAL(smooth.size(), 1u);
+	BOOST_CHECK(smoothPoints < exactPoints / 4);
+
+	// every point moves by at most the tolerance, so the area barely changes
+	BOOST_CHECK_CLOSE(totalArea(smooth), totalArea(exact), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( contourtracer_large_logo )
+{
+	QImage image = logoImage(4096);
+	Paths paths = ContourTracer::trace(image);
+	BOOST_CHECK_EQUAL(totalArea(paths), (double) setPixels(image));
+}
@@ -0,0 +1,100 @@
+#define BOOST_TEST_MODULE DEBUGDIALOG Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "debugdialog.h"
+
+#include <QApplication>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+/*
+Testing the DebugDialog logging pipeline: ordering of the background writer and
+the level filter. Throughput is measured in tests/benchmarks/bench_debugdialog.
+*/
+
+static void discardMessages(QtMsgType, const QMessageLogContext &, const QString &) {
+}
+
+struct ApplicationFixture {
+	ApplicationFixture() {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+		static int argc = 1;
+		static char arg0[] = "test_debugdialog";
+		static char * argv[] = { arg0, nullptr };
+		app = new QApplication(argc, argv);
+		qInstallMessageHandler(discardMessages);
+		DebugDialog::setEnabled(true);
+	}
+	~ApplicationFixture() {
+		DebugDialog::cleanup();
+		delete app;
+	}
+	QApplication * app = nullptr;
+};
+
+BOOST_GLOBAL_FIXTURE( ApplicationFixture );
+
+static QStringList readLines(const QString & fileName) {
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return QStringList();
+	QTextStream in(&file);
+	QStringList lines;
+	while (!in.atEnd()) {
+		lines.append(in.readLine());
+	}
+	return lines;
+}
+
+static void logMessages(const QString & fileName, bool synchronous, int count) {
+	DebugDialog::setSynchronous(synchronous);
+	DebugDialog::setLogFileName(fileName);
+
+	for (int i = 0; i < count; i++) {
+		DebugDialog::debug(QString("message %1").arg(i));
+	}
+	DebugDialog::flush();
+}
+
+BOOST_AUTO_TEST_CASE( debugdialog_writer_keeps_order )
+{
+	QTemporaryDir dir;
+	QString fileName = dir.filePath("debug.txt");
+	logMessages(fileName, false, 1000);
+
+	QStringList lines = readLines(fileName);
+	BOOST_REQUIRE_EQUAL(lines.count(), 1000);
+	for (int i = 0; i < lines.count(); i++) {
+		BOOST_CHECK_EQUAL(lines.at(i).toStdString(), QString("message %1").arg(i).toStdString());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( debugdialog_level_filter )
+{
+	QTemporaryDir dir;
+	QString fileName = dir.filePath("debug.txt");
+	DebugDialog::setDebugLevel(DebugDialog::Warning);
+	BOOST_CHECK(!DebugDialog::enabled(DebugDialog::Info));
+	BOOST_CHECK(DebugDialog::enabled(DebugDialog::Error));
+
+	logMessages(fileName, false, 10);
+	DebugDialog::debug("kept", DebugDialog::Error);
+	DebugDialog::flush();
+	DebugDialog::setDebugLevel(DebugDialog::Debug);
+
+	QStringList lines = readLines(fileName);
+	BOOST_REQUIRE_EQUAL(lines.count(), 1);
+	BOOST_CHECK_EQUAL(lines.first().toStdString(), "kept");
+}
+
+BOOST_AUTO_TEST_CASE( debugdialog_both_paths_write_every_message )
+{
+	static const int Count = 20000;
+	QTemporaryDir dir;
+
+	logMessages(dir.filePath("sync.txt"), true, Count);
+	logMessages(dir.filePath("async.txt"), false, Count);
+
+	BOOST_CHECK_EQUAL(readLines(dir.filePath("sync.txt")).count(), Count);
+	BOOST_CHECK_EQUAL(readLines(dir.filePath("async.txt")).count(), Count);
+}
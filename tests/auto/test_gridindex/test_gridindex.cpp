@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE GRIDINDEX Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "utils/gridindex.h"
+
+#include <QRandomGenerator>
+
+#include <algorithm>
+
+/*
+Testing gridindex.cpp: point lookups must match a linear scan over the rects.
+*/
+
+namespace {
+
+QList<int> linearScan(const QList<QRectF> & rects, QPointF p)
+{
+	QList<int> indexes;
+	for (int i = 0; i < rects.count(); i++) {
+		if (rects.at(i).contains(p)) indexes.append(i);
+	}
+	return indexes;
+}
+
+QList<int> sorted(QList<int> indexes)
+{
+	std::sort(indexes.begin(), indexes.end());
+	return indexes;
+}
+
+// holes on a 0.1 inch pitch at 90 dpi, with a gap between the two halves like a breadboard
+QList<QRectF> breadboardHoles(int columns, int rows)
+{
+	QList<QRectF> rects;
+	for (int x = 0; x < columns; x++) {
+		for (int y = 0; y < rows; y++) {
+			double top = y * 9 + (y >= rows / 2 ? 27 : 0);
+			rects.append(QRectF(x * 9 + 1.5, top + 1.5, 6, 6));
+		}
+	}
+	return rects;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( gridindex_empty )
+{
+	GridIndex index;
+	BOOST_CHECK(index.isEmpty());
+	BOOST_CHECK(index.indexesAt(QPointF(0, 0)).isEmpty());
+
+	index.build(QList<QRectF>());
+	BOOST_CHECK(index.indexesAt(QPointF(10, 10)).isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( gridindex_regular )
+{
+	QList<QRectF> rects = breadboardHoles(63, 10);
+	GridIndex index;
+	index.build(rects);
+	BOOST_CHECK_EQUAL(index.count(), rects.count());
+
+	// one cell per pitch
+	BOOST_CHECK_CLOSE(index.cellSize().width(), 9.0, 0.001);
+	BOOST_CHECK_CLOSE(index.cellSize().height(), 9.0, 0.001);
+
+	for (int i = 0; i < rects.count(); i++) {
+		BOOST_CHECK(index.indexesAt(rects.at(i).center()) == QList<int>() << i);
+		BOOST_CHECK(index.indexesAt(rects.at(i).topLeft()) == QList<int>() << i);
+		BOOST_CHECK(index.indexesAt(rects.at(i).bottomRight()) == QList<int>() << i);
+	}
+
+	// between holes, in the gap and far away
+	BOOST_CHECK(index.indexesAt(QPointF(0.5, 0.5)).isEmpty());
+	BOOST_CHECK(index.indexesAt(QPointF(20, 60)).isEmpty());
+	BOOST_CHECK(index.indexesAt(QPointF(-1e12, 1e12)).isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( gridindex_irregular )
+{
+	QRandomGenerator random(4321);
+	QList<QRectF> rects;
+	for (int i = 0; i < 500; i++) {
+		double size = 1 + random.bounded(11.0);
+		rects.append(QRectF(random.bounded(300.0), random.bounded(300.0), size, size));
+	}
+	// an oversized connector and two which overlap exactly
+	rects.append(QRectF(-50, -50, 400, 20));
+	rects.append(QRectF(100, 100, 5, 5));
+	rects.append(QRectF(100, 100, 5, 5));
+
+	GridIndex index;
+	index.build(rects);
+	for (int i = 0; i < 5000; i++) {
+		QPointF p(random.bounded(420.0) - 60, random.bounded(420.0) - 60);
+		BOOST_CHECK(sorted(index.indexesAt(p)) == linearScan(rects, p));
+	}
+	BOOST_CHECK(sorted(index.indexesAt(QPointF(102, 102))) == linearScan(rects, QPointF(102, 102)));
+	BOOST_CHECK(index.indexesAt(QPointF(102, 102)).count() >= 2);
+}
+
+BOOST_AUTO_TEST_CASE( gridindex_rebuild )
+{
+	GridIndex index;
+	index.build(breadboardHoles(10, 10));
+	index.clear();
+	BOOST_CHECK(index.isEmpty());
+
+	QList<QRectF> rects;
+	rects.append(QRectF(0, 0, 10, 10));
+	index.build(rects);
+	BOOST_CHECK_EQUAL(index.count(), 1);
+	BOOST_CHECK(index.indexesAt(QPointF(5, 5)) == QList<int>() << 0);
+	BOOST_CHECK(index.indexesAt(QPointF(50, 5)).isEmpty());
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE IPC Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "ipc/ipc_d_356_writer.h"
+
+#include <QBuffer>
+
+/*
+Testing ipc_d_356_writer.cpp against a fixture of the IPC-D-356A output for known records.
+The export of large panels is timed in tests/benchmarks/bench_ipc.
+*/
+
+namespace {
+
+IPCD356ARecord record(int cmd, const QString & netLabel, const QString & partLabel, const QString & connectorName, const QString & connectorId,
+					  bool isMiddle, bool isPlated, bool isDrilled, int r, int x, int y, int w, int h, int access, int ccw_angle)
+{
+	IPCD356ARecord result;
+	result.cmd = cmd;
+	result.netLabel = netLabel;
+	result.partLabel = partLabel;
+	result.connectorName = connectorName;
+	result.connectorId = connectorId;
+	result.isMiddle = isMiddle;
+	result.isPlated = isPlated;
+	result.isDrilled = isDrilled;
+	result.r = r;
+	result.x = x;
+	result.y = y;
+	result.w = w;
+	result.h = h;
+	result.access = access;
+	result.ccw_angle = ccw_angle;
+	return result;
+}
+
+QList<IPCD356ARecord> fixtureRecords()
+{
+	QList<IPCD356ARecord> records;
+	records << record(IPCD356A::ThroughHole, "NET1J1R1", "J1", "pin1", "connector0", true, true, true, 1016, 2540, -1270, 1880, 0, 0, 0)
+			<< record(IPCD356A::ThroughHoleContinuation, "NET1J1R1", "J1", "pin1", "connector0", true, true, true, 1016, 2540, -1270, 1880, 0, 16, 0)
+			<< record(IPCD356A::SurfaceMount, "NET2-GND", "U1", "GND", "connector12", false, false, false, 0, -350, 12700, 600, 1500, 1, -90)
+			<< record(IPCD356A::SurfaceMount, "NET3VERYLONGNETLABEL", "LED12345", "anode", "connector123456", false, false, false, 0, 0, 0, 900, 900, 1, 405)
+			<< record(IPCD356A::SurfaceMount, "NET4", "C1", "+", "p1", false, true, true, 40, 123456, -654321, 50, 0, 1, 180);
+	return records;
+}
+
+const QStringList Comments({ "Created with Fritzing (https://fritzing.org/)", "1.0.3" });
+
+const char * Fixture =
+	"C  Created with Fritzing (https://fritzing.org/)\n"
+	"C  1.0.3\n"
+	"P  CODE  00\n"
+	"P  UNITS CUST 1\n"
+	"P  TITLE board.fzz\n"
+	"P  VER   IPC-D-356A\n"
+	"317NET1J1R1         J1    -   0MD1016PA00X+002540Y-001270X1880Y0000R000 S0     \n"
+	"017NET1J1R1         J1    -   0MD1016PA16X+002540Y-001270X1880Y0000R000 S0     \n"
+	"327NET2-GND         U1    -  12  0000UA01X-000350Y+012700X0600Y1500R270 S0     \n"
+	"327NET3VERYLONGNE   LED123-   A  0000UA01X+000000Y+000000X0900Y0900R045 S0     \n"
+	"327NET4             C1    -   + D0040PA01X+123456Y-654321X0050Y0000R180 S0     \n"
+	"999\n";
+
+}
+
+BOOST_AUTO_TEST_CASE( ipc_pin_identifiers )
+{
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("c12", "pin").toStdString(), "c12");
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("connector12", "pin").toStdString(), "12");
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("connector123456", "pin").toStdString(), "1234");
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("connector", "pin").toStdString(), "conn");
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("connector1", "Cathode").toStdString(), "C");
+	BOOST_CHECK_EQUAL(getPinNumberOrIdentifier("connector1", "-").toStdString(), "-");
+}
+
+BOOST_AUTO_TEST_CASE( ipc_fixture )
+{
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	BOOST_REQUIRE(writeIPC_D_356A(buffer, "board.fzz", Comments, fixtureRecords()));
+	BOOST_CHECK_EQUAL(buffer.data().toStdString(), std::string(Fixture));
+}
+
+BOOST_AUTO_TEST_CASE( ipc_large_board )
+{
+	// a panel with tens of thousands of test points goes out in chunks and byte for byte the same as record by record
+	QList<IPCD356ARecord> records;
+	QByteArray expected;
+	QList<IPCD356ARecord> fixture = fixtureRecords();
+	for (int i = 0; i < 50000; i++) {
+		IPCD356ARecord r = fixture.at(i % fixture.count());
+		r.x += i;
+		records << r;
+		expected += electricalTestRecord(r).toUtf8();
+	}
+
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	BOOST_REQUIRE(writeIPC_D_356A(buffer, "panel.fzz", Comments, records));
+
+	QByteArray data = buffer.data();
+	BOOST_REQUIRE(data.endsWith(expected + "999\n"));
+}
@@ -0,0 +1,153 @@
+#define BOOST_TEST_MODULE LEVELOFDETAIL Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "items/levelofdetail.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QSvgRenderer>
+#include <QtMath>
+
+#include <cmath>
+
+/*
+Testing levelofdetail.cpp: the thresholds, the pixmap resolution per zoom level, and that
+the pixmap path looks like the exact rendering. How much cheaper it is when zoomed out is
+measured in tests/benchmarks/bench_levelofdetail.
+*/
+
+struct ApplicationFixture {
+	ApplicationFixture() {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+		static int argc = 1;
+		static char arg0[] = "test_levelofdetail";
+		static char * argv[] = { arg0, nullptr };
+		app = new QApplication(argc, argv);
+	}
+	~ApplicationFixture() {
+		delete app;
+	}
+	QApplication * app = nullptr;
+};
+
+BOOST_GLOBAL_FIXTURE( ApplicationFixture );
+
+namespace {
+
+// a breadboard-like svg: a body with a grid of holes
+QByteArray gridSvg(int columns, int rows)
+{
+	QByteArray svg;
+	int width = columns * 9;
+	int height = rows * 9;
+	svg += QString("<svg xmlns='http://www.w3.org/2000/svg' width='%1px' height='%2px' viewBox='0 0 %1 %2'>")
+		.arg(width).arg(height).toUtf8();
+	svg += QString("<rect x='0' y='0' width='%1' height='%2' fill='#d9d9d9' stroke='#999999' stroke-width='2'/>")
+		.arg(width).arg(height).toUtf8();
+	for (int y = 0; y < rows; y++) {
+		for (int x = 0; x < columns; x++) {
+			svg += QString("<circle cx='%1' cy='%2' r='2.5' fill='#404040' stroke='#202020' stroke-width='0.5'/>")
+				.arg(x * 9 + 4.5).arg(y * 9 + 4.5).toUtf8();
+		}
+	}
+	svg += "</svg>";
+	return svg;
+}
+
+QImage paintAt(QSvgRenderer & renderer, const QRectF & bounds, double zoom, bool pixmap)
+{
+	QImage image(qCeil(bounds.width() * zoom) + 2, qCeil(bounds.height() * zoom) + 2, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::white);
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.scale(zoom, zoom);
+	if (!pixmap || !LevelOfDetail::paintPixmap(&painter, &renderer, 1, bounds, zoom)) {
+		renderer.render(&painter, bounds);
+	}
+	painter.end();
+	return image;
+}
+
+double meanDifference(const QImage & a, const QImage & b)
+{
+	double total = 0;
+	for (int y = 0; y < a.height(); y++) {
+		for (int x = 0; x < a.width(); x++) {
+			total += std::abs(qGray(a.pixel(x, y)) - qGray(b.pixel(x, y)));
+		}
+	}
+	return total / (a.width() * a.height());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( levelofdetail_thresholds )
+{
+	QRectF connector(0, 0, 7, 7);
+	BOOST_CHECK(!LevelOfDetail::tooSmall(connector, 1));
+	BOOST_CHECK(!LevelOfDetail::tooSmall(connector, 0.3));
+	BOOST_CHECK(LevelOfDetail::tooSmall(connector, 0.2));
+
+	// a long thin leg stays visible as long as its length does
+	QRectF leg(0, 0, 90, 0.5);
+	BOOST_CHECK(!LevelOfDetail::tooSmall(leg, 0.05));
+
+	QRectF label(0, 0, 60, 12);
+	BOOST_CHECK(!LevelOfDetail::unreadable(label, 0.5));
+	BOOST_CHECK(LevelOfDetail::unreadable(label, 0.25));
+
+	BOOST_CHECK(!LevelOfDetail::simplified(1));
+	BOOST_CHECK(!LevelOfDetail::simplified(LevelOfDetail::PixmapBelow));
+	BOOST_CHECK(LevelOfDetail::simplified(LevelOfDetail::PixmapBelow / 2));
+
+	// anything but the view's own widget gets the full detail
+	QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+	painter.scale(0.1, 0.1);
+	QStyleOptionGraphicsItem option;
+	BOOST_CHECK_EQUAL(LevelOfDetail::of(&option, &painter, nullptr), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( levelofdetail_pixmap_octaves )
+{
+	QRectF bounds(0, 0, 1000, 500);
+
+	// never less than one device pixel per pixmap pixel, never more than two
+	for (double zoom = LevelOfDetail::PixmapBelow * 0.999; zoom > 0.01; zoom *= 0.9) {
+		QSize size = LevelOfDetail::pixmapSize(bounds, zoom, 1);
+		BOOST_CHECK_GE(size.width(), qFloor(bounds.width() * zoom));
+		BOOST_CHECK_LE(size.width(), qCeil(bounds.width() * zoom * 2));
+	}
+
+	// one pixmap for a whole octave
+	BOOST_CHECK(LevelOfDetail::pixmapSize(bounds, 0.39, 1) == LevelOfDetail::pixmapSize(bounds, 0.21, 1));
+	BOOST_CHECK(LevelOfDetail::pixmapSize(bounds, 0.39, 1) != LevelOfDetail::pixmapSize(bounds, 0.19, 1));
+	BOOST_CHECK(LevelOfDetail::pixmapSize(bounds, 0.3, 2) == LevelOfDetail::pixmapSize(bounds, 0.3, 1) * 2);
+
+	// capped when zoomed out very far
+	BOOST_CHECK(LevelOfDetail::pixmapSize(bounds, 0.0001, 1) == LevelOfDetail::pixmapSize(bounds, 0.001, 1));
+	BOOST_CHECK(LevelOfDetail::pixmapSize(QRectF(0, 0, 1, 1), 0.001, 1) == QSize(1, 1));
+}
+
+BOOST_AUTO_TEST_CASE( levelofdetail_pixmap_matches )
+{
+	QSvgRenderer renderer(gridSvg(60, 20));
+	BOOST_REQUIRE(renderer.isValid());
+	QRectF bounds(0, 0, 540, 180);
+
+	// exact rendering from the threshold up
+	BOOST_CHECK(paintAt(renderer, bounds, 1, true) == paintAt(renderer, bounds, 1, false));
+	BOOST_CHECK(paintAt(renderer, bounds, LevelOfDetail::PixmapBelow, true) == paintAt(renderer, bounds, LevelOfDetail::PixmapBelow, false));
+
+	QList<double> zooms;
+	zooms << 0.35 << 0.2 << 0.1 << 0.05;
+	for (double zoom : zooms) {
+		double difference = meanDifference(paintAt(renderer, bounds, zoom, true), paintAt(renderer, bounds, zoom, false));
+		BOOST_TEST_MESSAGE("zoom " << zoom << ": mean gray difference " << difference);
+		BOOST_CHECK_LT(difference, 8.0);
+	}
+
+	LevelOfDetail::clear();
+}
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE LOCALCLIPBOARD Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <QDomDocument>
+#include <QMimeData>
+
+// Get access to the xml LocalMimeData has written, to check when it writes it
+#define protected public
+#include "sketch/localclipboard.h"
+#undef protected
+
+#include <memory>
+
+/*
+Testing localclipboard.cpp: a copy comes back only from the clipboard data it was made for,
+every paste gets a document of its own, and the xml is only written when something asks for it.
+Copy and paste are timed in tests/benchmarks/bench_localclipboard and, as a whole duplicate,
+in tests/benchmarks/bench_sketch.
+*/
+
+namespace {
+
+// what SketchWidget::copyHeart writes, for a number of parts wired in a chain
+QByteArray copiedXml(int parts)
+{
+	QString xml = "<module><boundingRects><boundingRect view='breadboardView' x='0' y='0' width='100' height='100'/></boundingRects><instances>";
+	for (int i = 0; i < parts; i++) {
+		xml += QString("<instance moduleIdRef='ResistorModuleID' modelIndex='%1' path=':/resources/parts/core/resistor.fzp'>"
+		               "<property name='resistance' value='220'/><title>R%1</title><views>").arg(i + 1);
+		for (const char * view : { "breadboardView", "schematicView", "pcbView" }) {
+			xml += QString("<%1 layer='breadboard'><geometry z='2.5' x='%2' y='10'/><connectors>"
+			               "<connector connectorId='connector0' layer='breadboard'><geometry x='0' y='0'/>"
+			               "<connects><connect connectorId='connector1' modelIndex='%3' layer='breadboard'/></connects>"
+			               "</connector></connectors></%1>").arg(view).arg(i * 40).arg(i);
+		}
+		xml += "</views></instance>";
+	}
+	xml += "</instances></module>";
+	return xml.toUtf8();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( localclipboard_roundtrip )
+{
+	QDomDocument copied;
+	BOOST_REQUIRE(copied.setContent(copiedXml(3)));
+
+	std::unique_ptr<QMimeData> mimeData(LocalClipboard::mimeData(copied));
+	BOOST_CHECK(mimeData->hasFormat(LocalClipboard::MimeType));
+	BOOST_CHECK(mimeData->hasFormat("application/x-dnditemsdata"));
+
+	QDomDocument pasted;
+	BOOST_REQUIRE(LocalClipboard::get(mimeData.get(), pasted));
+	BOOST_CHECK_EQUAL(pasted.toString().toStdString(), copied.toString().toStdString());
+
+	// pasting renumbers the document, which must not show up in the next paste
+	pasted.documentElement().firstChildElement("instances").firstChildElement("instance").setAttribute("modelIndex", "99");
+	QDomDocument again;
+	BOOST_REQUIRE(LocalClipboard::get(mimeData.get(), again));
+	BOOST_CHECK_EQUAL(again.toString().toStdString(), copied.toString().toStdString());
+
+	// none of that needed the xml, which is there when asked for
+	auto * localMimeData = dynamic_cast<LocalMimeData *>(mimeData.get());
+	BOOST_REQUIRE(localMimeData != nullptr);
+	BOOST_CHECK(localMimeData->m_xml.isEmpty());
+	BOOST_CHECK(mimeData->data("application/x-dnditemsdata") == copied.toByteArray());
+	BOOST_CHECK_EQUAL(mimeData->text().toStdString(), copied.toString().toStdString());
+
+	LocalClipboard::clear();
+	BOOST_CHECK(!LocalClipboard::get(mimeData.get(), again));
+}
+
+BOOST_AUTO_TEST_CASE( localclipboard_foreign )
+{
+	QDomDocument copied;
+	BOOST_REQUIRE(copied.setContent(copiedXml(1)));
+	QDomDocument pasted;
+
+	// the xml alone, without the marker
+	std::unique_ptr<QMimeData> copiedHere(LocalClipboard::mimeData(copied));
+	QMimeData plain;
+	plain.setData("application/x-dnditemsdata", copiedXml(1));
+	BOOST_CHECK(!LocalClipboard::get(&plain, pasted));
+	BOOST_CHECK(!LocalClipboard::get(nullptr, pasted));
+
+	// copied by another process
+	QMimeData other;
+	other.setData(LocalClipboard::MimeType, QByteArray("someone else"));
+	BOOST_CHECK(!LocalClipboard::get(&other, pasted));
+
+	// an older copy from this process
+	std::unique_ptr<QMimeData> older(LocalClipboard::mimeData(copied));
+	std::unique_ptr<QMimeData> newer(LocalClipboard::mimeData(copied));
+	BOOST_CHECK(!LocalClipboard::get(older.get(), pasted));
+	BOOST_CHECK(LocalClipboard::get(newer.get(), pasted));
+
+	LocalClipboard::clear();
+}
@@ -29,8 +29,10 @@ INCLUDEPATH += $$absolute_path(../../../src)
 
 HEADERS += $$files(../../../src/simulation/ngspice_simulator.h)
 HEADERS += $$files(../../../src/debugdialog.h)
+HEADERS += $$files(../../../src/simulation/spicenetlistdiff.h)
 
 SOURCES += $$files(../../../src/simulation/ngspice_simulator.cpp)
 SOURCES += $$files(../../../src/debugdialog.cpp)
+SOURCES += $$files(../../../src/simulation/spicenetlistdiff.cpp)
 #INCLUDEPATH += $$top_srcdir
 # unix:QMAKE_POST_LINK = $$PWD/generated/test_svg
@@ -0,0 +1,57 @@
+#include "simulation/spicenetlistdiff.h"
+
+/*
+Testing spicenetlistdiff.cpp, which decides if a netlist can be applied to the loaded circuit with alter/altermod.
+*/
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+const QString Netlist = "NgSpice Simulation Netlist\n"
+						"DLED1 1 0 LED_GENERIC\n"
+						"R1 1 2 68\n"
+						"VCC1 2 0 DC 3V\n"
+						"*Typ RED,GREEN,YELLOW,AMBER GaAs LED: Vf=2.1V Vr=4V If=40mA trr=3uS\n"
+						".MODEL LED_GENERIC D (IS=93.1P RS=42M N=4.61 BV=4 IBV=10U CJO=2.97P VJ=.75 M=.333 TT=4.32U)\n"
+						".options savecurrents\n"
+						".OP\n"
+						".END\n";
+
+}
+
+BOOST_AUTO_TEST_CASE( spicenetlistdiff_identical )
+{
+	QStringList commands;
+	BOOST_CHECK(SpiceNetlistDiff::parameterChanges(Netlist, Netlist, commands));
+	BOOST_CHECK(commands.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( spicenetlistdiff_values )
+{
+	QString netlist = Netlist;
+	netlist.replace("R1 1 2 68", "R1 1 2 220").replace("DC 3V", "DC 5V").replace("RS=42M", "RS = 50M");
+
+	QStringList commands;
+	BOOST_CHECK(SpiceNetlistDiff::parameterChanges(Netlist, netlist, commands));
+	BOOST_CHECK_EQUAL(commands.count(), 3);
+	BOOST_CHECK(commands.contains("alter R1 = 220"));
+	BOOST_CHECK(commands.contains("alter VCC1 = 5V"));
+	BOOST_CHECK(commands.contains("altermod LED_GENERIC rs = 50M"));
+}
+
+BOOST_AUTO_TEST_CASE( spicenetlistdiff_topology )
+{
+	QStringList commands;
+	QString netlist = Netlist;
+	BOOST_CHECK(!SpiceNetlistDiff::parameterChanges(Netlist, netlist.replace("R1 1 2 68", "R1 1 3 68"), commands));
+
+	netlist = Netlist;
+	BOOST_CHECK(!SpiceNetlistDiff::parameterChanges(Netlist, netlist.replace("R1 1 2 68\n", "R1 1 2 68\nR2 2 0 1k\n"), commands));
+
+	netlist = Netlist;
+	BOOST_CHECK(!SpiceNetlistDiff::parameterChanges(Netlist, netlist.replace(".OP", ".TRAN 1ms 100ms"), commands));
+
+	netlist = Netlist;
+	BOOST_CHECK(!SpiceNetlistDiff::parameterChanges(Netlist, netlist.replace(" TT=4.32U", ""), commands));
+}
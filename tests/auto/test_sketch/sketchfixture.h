@@ -0,0 +1,34 @@
+#ifndef SKETCHFIXTURE_H
+#define SKETCHFIXTURE_H
+
+#include "viewlayer.h"
+
+#include <QString>
+
+class FApplication;
+class MainWindow;
+class SketchWidget;
+class ConnectorItem;
+
+// the whole application, started once for all the test cases, and small sketches to load into it
+
+struct SketchFixture {
+	SketchFixture();
+	~SketchFixture();
+
+	static FApplication * application;
+
+	static QString write(const QString & name, const QString & xml);	// returns the path, or an empty string
+	static MainWindow * open(const QString & path);
+	static void close(MainWindow *);
+
+	static SketchWidget * view(MainWindow *, ViewLayer::ViewID);
+	static ConnectorItem * connector(SketchWidget *, const QString & title, const QString & connectorID);
+
+	static QString resistorXml(int modelIndex, const QString & title, double x, const QString & connects0 = QString());
+	static QString wireXml(int modelIndex, const QString & title, double x0, double x1, int index0, int index1);
+	static QString connectXml(const QString & connectorID, int modelIndex, const QString & layer);
+	static QString sketchXml(const QString & instances, const QString & views = QString());
+};
+
+#endif
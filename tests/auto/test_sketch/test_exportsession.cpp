@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+
+#include "sketchfixture.h"
+
+#include "mainwindow/mainwindow.h"
+#include "sketch/breadboardsketchwidget.h"
+#include "sketch/pcbsketchwidget.h"
+
+#include <algorithm>
+
+/*
+Testing MainWindow::clearSketch, which ExportSession calls between sketches: a sketch loaded
+into a cleared window has to come out as it does from a fresh one.
+*/
+
+namespace {
+
+// a sketch that sets the per view state its <views> can carry, but not the grid, which is kept in QSettings
+QString withViewSettings()
+{
+	QString views = "<view name='breadboardView' backgroundColor='#102030' colorWiresByLength='1'/>"
+	                "<view name='schematicView' backgroundColor='#203040'/>"
+	                "<view name='pcbView' backgroundColor='#304050' viewFromBelow='1' autorouteTraceWidth='48'"
+	                " autorouteViaHoleSize='0.5mm' autorouteViaRingThickness='0.3mm' DRC_Keepout='0.02in' GPG_Keepout='0.02in'/>";
+	return SketchFixture::sketchXml(SketchFixture::resistorXml(1, "R1", 0), views);
+}
+
+QString withoutViewSettings()
+{
+	return SketchFixture::sketchXml(SketchFixture::resistorXml(1, "R1", 0) + SketchFixture::resistorXml(2, "R2", 72));
+}
+
+// what MainWindow saves in <views>, plus the trace width new pcb traces get
+QString viewState(MainWindow * mainWindow)
+{
+	QStringList state;
+	Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
+		state << QString("%1: background %2 grid %3 %4 %5 below %6")
+		         .arg(sketchWidget->viewName(), sketchWidget->background().name(), sketchWidget->gridSizeText())
+		         .arg(sketchWidget->showingGrid()).arg(sketchWidget->alignedToGrid()).arg(sketchWidget->viewFromBelow());
+		QHash<QString, QString> autorouterSettings = sketchWidget->getAutorouterSettings();
+		QStringList keys = autorouterSettings.keys();
+		std::sort(keys.begin(), keys.end());
+		Q_FOREACH (QString key, keys) {
+			state << QString("  %1=%2").arg(key, autorouterSettings.value(key));
+		}
+	}
+
+	auto * breadboard = qobject_cast<BreadboardSketchWidget *>(SketchFixture::view(mainWindow, ViewLayer::BreadboardView));
+	if (breadboard != nullptr) {
+		state << QString("colorWiresByLength %1").arg(breadboard->coloringWiresByLength());
+	}
+	state << QString("traceWidth %1").arg(mainWindow->pcbView()->getTraceWidth());
+	return state.join("\n");
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( exportsession_cleared_window_is_fresh )
+{
+	QString a = SketchFixture::write("a.fz", withViewSettings());
+	QString b = SketchFixture::write("b.fz", withoutViewSettings());
+	BOOST_REQUIRE(!a.isEmpty() && !b.isEmpty());
+
+	MainWindow * reused = SketchFixture::open(a);
+	BOOST_REQUIRE(reused != nullptr);
+	QString stateA = viewState(reused);
+	BOOST_CHECK(stateA.contains("colorWiresByLength 1"));
+
+	reused->clearSketch();
+	BOOST_REQUIRE(reused->loadWhich(b, false, false, false, ""));
+
+	MainWindow * fresh = SketchFixture::open(b);
+	BOOST_REQUIRE(fresh != nullptr);
+	QString stateB = viewState(fresh);
+	BOOST_CHECK(stateB != stateA);
+	BOOST_CHECK_EQUAL(viewState(reused).toStdString(), stateB.toStdString());
+
+	SketchFixture::close(fresh);
+	SketchFixture::close(reused);
+}
@@ -0,0 +1,98 @@
+#include <boost/test/unit_test.hpp>
+
+#include "sketchfixture.h"
+
+#include "mainwindow/mainwindow.h"
+#include "sketch/sketchwidget.h"
+#include "connectors/connectoritem.h"
+#include "routingstatus.h"
+
+/*
+Testing the incremental routing status in sketchwidget.cpp: rescoring only the flagged nets
+has to come out the same as scoring the whole sketch again.
+*/
+
+namespace {
+
+// R1-R2 and R3-R4 joined by breadboard wires: two nets
+QString twoNets()
+{
+	QString instances;
+	instances += SketchFixture::resistorXml(1, "R1", 0, SketchFixture::connectXml("connector0", 5, "breadboardWire"));
+	instances += SketchFixture::resistorXml(2, "R2", 72, SketchFixture::connectXml("connector1", 5, "breadboardWire"));
+	instances += SketchFixture::resistorXml(3, "R3", 144, SketchFixture::connectXml("connector0", 6, "breadboardWire"));
+	instances += SketchFixture::resistorXml(4, "R4", 216, SketchFixture::connectXml("connector1", 6, "breadboardWire"));
+	instances += SketchFixture::wireXml(5, "Wire1", 0, 72, 1, 2);
+	instances += SketchFixture::wireXml(6, "Wire2", 144, 216, 3, 4);
+	return SketchFixture::sketchXml(instances);
+}
+
+void checkEqual(const RoutingStatus & incremental, const RoutingStatus & full)
+{
+	BOOST_CHECK_EQUAL(incremental.m_netCount, full.m_netCount);
+	BOOST_CHECK_EQUAL(incremental.m_netRoutedCount, full.m_netRoutedCount);
+	BOOST_CHECK_EQUAL(incremental.m_connectorsLeftToRoute, full.m_connectorsLeftToRoute);
+	BOOST_CHECK_EQUAL(incremental.m_jumperItemCount, full.m_jumperItemCount);
+}
+
+}
+
+// the way a voltage or bus change merges nets: connected directly, only one side flagged
+BOOST_AUTO_TEST_CASE( routingstatus_merge_flagged_on_one_side )
+{
+	MainWindow * mainWindow = SketchFixture::open(SketchFixture::write("twonets.fz", twoNets()));
+	BOOST_REQUIRE(mainWindow != nullptr);
+	SketchWidget * breadboard = SketchFixture::view(mainWindow, ViewLayer::BreadboardView);
+	BOOST_REQUIRE(breadboard != nullptr);
+	ConnectorItem * r2 = SketchFixture::connector(breadboard, "R2", "connector0");
+	ConnectorItem * r3 = SketchFixture::connector(breadboard, "R3", "connector0");
+	BOOST_REQUIRE(r2 != nullptr && r3 != nullptr);
+
+	RoutingStatus separate;
+	breadboard->updateRoutingStatus(separate, true);
+	BOOST_REQUIRE_EQUAL(separate.m_netCount, 2);
+
+	r2->tempConnectTo(r3, false);
+	r3->tempConnectTo(r2, false);
+	breadboard->ratsnestConnect(r2, true);
+	RoutingStatus incremental;
+	breadboard->updateRoutingStatus(incremental, false);
+	RoutingStatus full;
+	breadboard->updateRoutingStatus(full, true);
+	checkEqual(incremental, full);
+	BOOST_CHECK_EQUAL(incremental.m_netCount, 1);
+
+	// and apart again, flagged on the other side
+	r2->tempRemove(r3, false);
+	r3->tempRemove(r2, false);
+	breadboard->ratsnestConnect(r3, false);
+	breadboard->updateRoutingStatus(incremental, false);
+	breadboard->updateRoutingStatus(full, true);
+	checkEqual(incremental, full);
+	BOOST_CHECK_EQUAL(incremental.m_netCount, separate.m_netCount);
+
+	SketchFixture::close(mainWindow);
+}
+
+// deleting a wire flags no connector: its net is found through the deleted connectors
+BOOST_AUTO_TEST_CASE( routingstatus_deleted_wire )
+{
+	MainWindow * mainWindow = SketchFixture::open(SketchFixture::write("deletedwire.fz", twoNets()));
+	BOOST_REQUIRE(mainWindow != nullptr);
+	SketchWidget * breadboard = SketchFixture::view(mainWindow, ViewLayer::BreadboardView);
+	BOOST_REQUIRE(breadboard != nullptr);
+	ConnectorItem * end = SketchFixture::connector(breadboard, "Wire1", "connector0");
+	BOOST_REQUIRE(end != nullptr);
+
+	RoutingStatus before;
+	breadboard->updateRoutingStatus(before, false);
+
+	breadboard->deleteItem(end->attachedTo(), true, false, false);
+	RoutingStatus incremental;
+	breadboard->updateRoutingStatus(incremental, false);
+	RoutingStatus full;
+	breadboard->updateRoutingStatus(full, true);
+	checkEqual(incremental, full);
+
+	SketchFixture::close(mainWindow);
+}
@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE SKETCH Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "sketchfixture.h"
+
+#include "fapplication.h"
+#include "mainwindow/mainwindow.h"
+#include "sketch/sketchwidget.h"
+#include "connectors/connectoritem.h"
+#include "items/itembase.h"
+#include "utils/fmessagebox.h"
+#include "utils/textutils.h"
+
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <stdexcept>
+
+/*
+Testing sketch level behaviour that needs the whole application: sketches are written to a
+temporary folder and loaded into MainWindows the way the command line services load them.
+*/
+
+FApplication * SketchFixture::application = nullptr;
+
+namespace {
+
+QTemporaryDir * TheFolder = nullptr;
+
+}
+
+SketchFixture::SketchFixture()
+{
+	qputenv("QT_QPA_PLATFORM", "offscreen");
+	QStandardPaths::setTestModeEnabled(true);		// keep the view settings the sketches write out of the user's own
+
+	static int argc = 1;
+	static char arg0[] = "test_sketch";
+	static char arg1[] = "-parts";
+	static QByteArray parts = qgetenv("FRITZING_PARTS");
+	static char * argv[] = { arg0, arg1, parts.data(), nullptr };
+	if (!parts.isEmpty()) argc = 3;
+
+	application = new FApplication(argc, argv);
+	if (application->init() != FInitResultNormal) throw std::runtime_error("FApplication::init failed");
+
+	FMessageBox::BlockMessages = true;
+	application->createUserDataStoreFolderStructures();
+	application->registerFonts();
+	if (!application->loadReferenceModel("", false)) throw std::runtime_error("no parts library, set FRITZING_PARTS");
+
+	TheFolder = new QTemporaryDir;
+}
+
+SketchFixture::~SketchFixture()
+{
+	delete TheFolder;
+	TheFolder = nullptr;
+	delete application;
+	application = nullptr;
+}
+
+BOOST_GLOBAL_FIXTURE( SketchFixture );
+
+QString SketchFixture::write(const QString & name, const QString & xml)
+{
+	QString path = TheFolder->filePath(name);
+	if (!TextUtils::writeUtf8(path, xml)) return QString();
+
+	return path;
+}
+
+MainWindow * SketchFixture::open(const QString & path)
+{
+	MainWindow * mainWindow = application->openWindowForService(false, 3);
+	if (mainWindow == nullptr) return nullptr;
+
+	mainWindow->setCloseSilently(true);
+	if (!mainWindow->loadWhich(path, false, false, false, "")) {
+		close(mainWindow);
+		return nullptr;
+	}
+
+	return mainWindow;
+}
+
+void SketchFixture::close(MainWindow * mainWindow)
+{
+	mainWindow->setCloseSilently(true);
+	mainWindow->close();
+	QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+SketchWidget * SketchFixture::view(MainWindow * mainWindow, ViewLayer::ViewID viewID)
+{
+	Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
+		if (sketchWidget->viewID() == viewID) return sketchWidget;
+	}
+	return nullptr;
+}
+
+ConnectorItem * SketchFixture::connector(SketchWidget * sketchWidget, const QString & title, const QString & connectorID)
+{
+	Q_FOREACH (QGraphicsItem * item, sketchWidget->scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == nullptr) continue;
+		if (itemBase->layerKinChief() != itemBase) continue;
+		if (itemBase->instanceTitle() != title) continue;
+
+		return itemBase->findConnectorItemWithSharedID(connectorID);
+	}
+	return nullptr;
+}
+
+// a resistor at x in every view; connects0 goes into its breadboard connector0
+QString SketchFixture::resistorXml(int modelIndex, const QString & title, double x, const QString & connects0)
+{
+	QString xml = QString("<instance moduleIdRef='ResistorModuleID' modelIndex='%1' path=':/resources/parts/core/resistor.fzp'>"
+	                      "<property name='resistance' value='220'/><title>%2</title><views>").arg(modelIndex).arg(title);
+	for (const char * view : { "breadboardView", "schematicView", "pcbView" }) {
+		QString layer = QString(view) == "pcbView" ? "copper0" : QString(view).remove("View");
+		QString connects = (QString(view) == "breadboardView" && !connects0.isEmpty()) ? "<connects>" + connects0 + "</connects>" : QString();
+		xml += QString("<%1 layer='%2'><geometry z='2.5' x='%3' y='72'/><connectors>"
+		               "<connector connectorId='connector0' layer='%2'><geometry x='0' y='0'/>%4</connector>"
+		               "<connector connectorId='connector1' layer='%2'><geometry x='0' y='0'/></connector>"
+		               "</connectors></%1>").arg(view, layer).arg(x).arg(connects);
+	}
+	return xml + "</views></instance>";
+}
+
+// a breadboard wire from connector0 of the resistor with index0, at x0, to connector0 of the one with index1, at x1
+QString SketchFixture::wireXml(int modelIndex, const QString & title, double x0, double x1, int index0, int index1)
+{
+	return QString("<instance moduleIdRef='WireModuleID' modelIndex='%1' path=':/resources/parts/core/wire.fzp'>"
+	               "<title>%2</title><views><breadboardView layer='breadboardWire'>"
+	               "<geometry z='3.5' x='%3' y='72' x1='0' y1='0' x2='%4' y2='0' wireFlags='64'/>"
+	               "<wireExtras mils='22.2222' color='#418dd9' opacity='1' banded='0'/><connectors>"
+	               "<connector connectorId='connector0' layer='breadboardWire'><geometry x='0' y='0'/><connects>%5</connects></connector>"
+	               "<connector connectorId='connector1' layer='breadboardWire'><geometry x='0' y='0'/><connects>%6</connects></connector>"
+	               "</connectors></breadboardView></views></instance>")
+	       .arg(modelIndex).arg(title).arg(x0).arg(x1 - x0)
+	       .arg(connectXml("connector0", index0, "breadboard"), connectXml("connector0", index1, "breadboard"));
+}
+
+QString SketchFixture::connectXml(const QString & connectorID, int modelIndex, const QString & layer)
+{
+	return QString("<connect connectorId='%1' modelIndex='%2' layer='%3'/>").arg(connectorID).arg(modelIndex).arg(layer);
+}
+
+QString SketchFixture::sketchXml(const QString & instances, const QString & views)
+{
+	QString xml = "<?xml version='1.0' encoding='UTF-8'?>\n<module fritzingVersion='1.0.0'>";
+	if (!views.isEmpty()) {
+		xml += "<views>" + views + "</views>";
+	}
+	return xml + "<instances>" + instances + "</instances></module>\n";
+}
@@ -0,0 +1,23 @@
+# /*******************************************************************
+# Part of the Fritzing project - http://fritzing.org
+# Copyright (c) 2024 Fritzing GmbH
+# Fritzing is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# Fritzing is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with Fritzing. If not, see <http://www.gnu.org/licenses/>.
+# ********************************************************************/
+
+# Links the whole application, so the tests can load sketches into a MainWindow.
+# The resistors come from the parts library; point FRITZING_PARTS at it if it is not
+# found the usual way.
+
+include($$absolute_path(../../fritzingapp.pri))
+
+HEADERS += sketchfixture.h
+SOURCES += test_sketch.cpp test_routingstatus.cpp test_exportsession.cpp
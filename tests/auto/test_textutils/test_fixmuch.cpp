@@ -0,0 +1,116 @@
+#include "textutils.h"
+
+/*
+Testing the single pass TextUtils::fixMuch against the DOM based TextUtils::fixMuchDom:
+both have to return the same text, byte for byte. The two are timed against each
+other in tests/benchmarks/bench_svg.
+*/
+
+#include <boost/test/unit_test.hpp>
+
+#include <QDirIterator>
+#include <QFile>
+
+namespace {
+
+void checkSame(const QString & svg, bool fixStrokeWidth, const QString & name)
+{
+	QString streamed = svg;
+	QString dom = svg;
+	bool streamedChanged = TextUtils::fixMuch(streamed, fixStrokeWidth);
+	bool domChanged = TextUtils::fixMuchDom(dom, fixStrokeWidth);
+	BOOST_CHECK_MESSAGE(streamedChanged == domChanged, name.toStdString());
+	BOOST_CHECK_MESSAGE(streamed == dom, (name + "\nfixMuch:\n" + streamed + "\nfixMuchDom:\n" + dom).toStdString());
+}
+
+QStringList librarySvgFiles()
+{
+	QStringList dirs;
+	dirs << QString(FRITZING_SOURCE_DIR) + "/resources/parts/svg";
+	QString partsDir = qEnvironmentVariable("FRITZING_PARTS_DIR");
+	if (!partsDir.isEmpty()) {
+		dirs << partsDir;
+	}
+
+	QStringList files;
+	Q_FOREACH (QString dir, dirs) {
+		QDirIterator iterator(dir, QStringList("*.svg"), QDir::Files, QDirIterator::Subdirectories);
+		while (iterator.hasNext()) {
+			files << iterator.next();
+		}
+	}
+
+	return files;
+}
+
+QString readFile(const QString & path)
+{
+	QFile file(path);
+	if (!file.open(QFile::ReadOnly)) return QString();
+
+	return QString::fromUtf8(file.readAll());
+}
+
+const QString Header = "<?xml version='1.0' encoding='UTF-8'?>\n"
+					   "<svg xmlns='http://www.w3.org/2000/svg' xmlns:xlink='http://www.w3.org/1999/xlink' "
+					   "xmlns:sodipodi='http://sodipodi.sourceforge.net/DTD/sodipodi-0.dtd' "
+					   "xmlns:inkscape='http://www.inkscape.org/namespaces/inkscape' "
+					   "width='1in' height='1in' %1>\n";
+
+}
+
+BOOST_AUTO_TEST_CASE( fixMuch_unchanged )
+{
+	QString svg = Header.arg("viewBox='0 0 100 100'") + "<rect x='1' y='1' width='10' height='10' fill='red'/>\n</svg>\n";
+	QString copy = svg;
+	BOOST_CHECK(!TextUtils::fixMuch(copy, true));
+	BOOST_CHECK(copy == svg);
+}
+
+BOOST_AUTO_TEST_CASE( fixMuchDom_removes_every_pattern )
+{
+	QString svg = Header.arg("viewBox='0 0 100 100'") + "<defs><pattern id='p1'/><pattern id='p2'/><pattern id='p3'/></defs><rect/>\n</svg>\n";
+	BOOST_CHECK(TextUtils::fixMuchDom(svg, false));
+	BOOST_CHECK(!svg.contains("<pattern"));
+	BOOST_CHECK(svg.contains("<rect"));
+}
+
+BOOST_AUTO_TEST_CASE( fixMuch_cases )
+{
+	QStringList bodies;
+	bodies << "<sodipodi:namedview id='base' inkscape:zoom='1'/><g inkscape:label='layer'><rect width='10' height='10'/></g>"
+		   << "<rect width='2mm' height='0.1in' style='stroke-width:1px;fill:none'/>"
+		   << "<defs><pattern id='p1'/><pattern id='p2'/><marker id='m'/><clipPath id='c'><rect/></clipPath></defs><rect/>"
+		   << "<text x='1' y='2' font-size='3'>a<tspan x='5' dy='1'>b</tspan><tspan>c</tspan></text>"
+		   << "<g stroke='none'><line stroke='black'/></g><g stroke-width='3'><line stroke='black'/></g><line stroke='black'/>"
+		   << "<path style='stroke:#000;stroke-width:2;opacity:0.5' d='M0 0L1 1'/><path style='stroke:red' d='M0 0L1 1'/>"
+		   << "<g transform='translate(1,1)'><rect transform='rotate(45)'/></g>"
+		   << "<defs><rect id='r' width='1' height='1'/></defs><use id='u' xlink:href='#r' transform='translate(2,2)'/>"
+		   << "<defs><rect id='r' width='1' height='1'/></defs><use id='u' href='#r' transform='translate(2,2)'/>"
+		   << "<g inkscape:label=\"double\" sodipodi:role='single'><rect/></g>"
+		   << "<text x='1' y='2' xml:space='preserve' inkscape:label='t'>a<tspan x='5' dy='1px'>b</tspan></text>"
+		   << "<!-- before --><rect width='5px'/>\n<!-- after stroke-width:1px -->"
+		   << "<text x='1' y='2'>2.54mm 'a&amp;b' \"3mm\" x&lt;y</text>"
+		   << "<g xlink:title='t' title=\"a\tb\"><rect fill='#fff'/></g>";
+
+	Q_FOREACH (QString body, bodies) {
+		Q_FOREACH (QString viewBox, QStringList() << "viewBox='0 0 100 100'" << "viewBox='-5 10 100 100'") {
+			QString svg = Header.arg(viewBox) + body + "\n</svg>\n";
+			checkSame(svg, true, body);
+			checkSame(svg, false, body);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( fixMuch_library )
+{
+	QStringList files = librarySvgFiles();
+	BOOST_REQUIRE(files.count() > 0);
+
+	QList<QString> svgs;
+	Q_FOREACH (QString file, files) {
+		svgs << readFile(file);
+		checkSame(svgs.last(), true, file);
+		checkSame(svgs.last(), false, file);
+	}
+}
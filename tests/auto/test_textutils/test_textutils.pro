@@ -37,3 +37,4 @@ SOURCES += $$files(../../../src/utils/textutils.cpp)
 INCLUDEPATH += $$absolute_path(../../../src/utils)
 # FLIBS += textutils
 
+DEFINES += FRITZING_SOURCE_DIR=\\\"$$absolute_path(../../..)\\\"
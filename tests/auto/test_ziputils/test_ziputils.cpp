@@ -0,0 +1,186 @@
+#define BOOST_TEST_MODULE ZIPUTILS Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "utils/ziputils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <quazip/quazipfileinfo.h>
+
+/*
+Testing ziputils.cpp: archives round trip, and stay readable by the plain QuaZip reading
+older Fritzing releases use.
+*/
+
+namespace {
+
+QByteArray randomBytes(QRandomGenerator & random, int size)
+{
+	QByteArray bytes(size, Qt::Uninitialized);
+	for (int i = 0; i < size; i++) {
+		bytes[i] = (char) random.bounded(256);
+	}
+	return bytes;
+}
+
+QString writeFile(const QDir & dir, const QString & name, const QByteArray & contents)
+{
+	QFile file(dir.filePath(name));
+	BOOST_REQUIRE(file.open(QIODevice::WriteOnly));
+	file.write(contents);
+	file.close();
+	return file.fileName();
+}
+
+struct SketchFiles {
+	QTemporaryDir source;
+	QHash<QString, QByteArray> contents;
+	QStringList filepaths;
+
+	void add(const QString & name, const QByteArray & bytes) {
+		contents.insert(name, bytes);
+		filepaths.append(writeFile(QDir(source.path()), name, bytes));
+	}
+
+	SketchFiles() {
+		QRandomGenerator random(2024);
+		QByteArray fz;
+		for (int i = 0; i < 2000; i++) {
+			fz += QString("<instance moduleIdRef=\"ResistorModuleID\" modelIndex=\"%1\" path=\":/resources/parts/core/resistor.fzp\"/>\n").arg(i).toUtf8();
+		}
+		add("sketch.fz", fz);
+		add("part.custom.fzp", fz.left(5000));
+		add("svg.breadboard.custom.svg", QByteArray("<svg xmlns='http://www.w3.org/2000/svg'/>"));
+		add("photo.png", randomBytes(random, 300000));
+		add("sketch.ino", QByteArray("void setup() {}\nvoid loop() {}\n"));
+		add("empty.txt", QByteArray());
+	}
+};
+
+void checkUnzipped(const SketchFiles & files, const QString & dirPath)
+{
+	QDir dir(dirPath);
+	BOOST_CHECK_EQUAL(dir.entryList(QDir::Files).count(), files.contents.count());
+	for (auto it = files.contents.constBegin(); it != files.contents.constEnd(); ++it) {
+		QFile file(dir.filePath(it.key()));
+		BOOST_REQUIRE(file.open(QIODevice::ReadOnly));
+		BOOST_CHECK(file.readAll() == it.value());
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( ziputils_round_trip )
+{
+	SketchFiles files;
+	QTemporaryDir target;
+	QString zipFilepath = QDir(target.path()).filePath("sketch.fzz");
+
+	QString error;
+	BOOST_REQUIRE(ZipUtils::zip(files.filepaths, zipFilepath, error));
+	BOOST_CHECK(error.isEmpty());
+
+	// the temp file was renamed into place
+	BOOST_CHECK(QDir(target.path()).entryList(QDir::Files | QDir::Hidden) == QStringList() << "sketch.fzz");
+
+	QTemporaryDir unzipped;
+	BOOST_REQUIRE(ZipUtils::unzip(zipFilepath, unzipped.path(), error));
+	checkUnzipped(files, unzipped.path());
+}
+
+BOOST_AUTO_TEST_CASE( ziputils_readable_by_quazip )
+{
+	SketchFiles files;
+	QTemporaryDir target;
+	QString zipFilepath = QDir(target.path()).filePath("sketch.fzz");
+	QString error;
+	BOOST_REQUIRE(ZipUtils::zip(files.filepaths, zipFilepath, error));
+
+	// read it back the way FolderUtils::unzipTo did before, byte by byte
+	QuaZip zip(zipFilepath);
+	BOOST_REQUIRE(zip.open(QuaZip::mdUnzip));
+	BOOST_CHECK_EQUAL(zip.getEntriesCount(), files.contents.count());
+
+	QuaZipFile file(&zip);
+	int count = 0;
+	for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+		QuaZipFileInfo info;
+		BOOST_REQUIRE(zip.getCurrentFileInfo(&info));
+		BOOST_CHECK_EQUAL((int) info.method, ZipUtils::storeOnly(info.name) ? 0 : Z_DEFLATED);
+		BOOST_CHECK(files.contents.contains(info.name));
+
+		BOOST_REQUIRE(file.open(QIODevice::ReadOnly));
+		QByteArray bytes;
+		char c;
+		while (file.getChar(&c)) bytes.append(c);
+		BOOST_CHECK(bytes == files.contents.value(info.name));
+		BOOST_CHECK(file.atEnd());
+
+		// closing verifies the crc
+		file.close();
+		BOOST_CHECK_EQUAL(file.getZipError(), UNZ_OK);
+		count++;
+	}
+	zip.close();
+	BOOST_CHECK_EQUAL(count, files.contents.count());
+
+	// entries keep the order they were given in
+	zip.open(QuaZip::mdUnzip);
+	QStringList names;
+	for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+		names.append(zip.getCurrentFileName());
+	}
+	QStringList expected;
+	Q_FOREACH (QString filepath, files.filepaths) {
+		expected.append(QFileInfo(filepath).fileName());
+	}
+	BOOST_CHECK(names == expected);
+}
+
+BOOST_AUTO_TEST_CASE( ziputils_overwrite_and_large_entries )
+{
+	SketchFiles files;
+	QRandomGenerator random(7);
+
+	// bigger than what is compressed in memory, so it is streamed
+	QByteArray large;
+	QByteArray block = randomBytes(random, 4096);
+	for (int i = 0; i < 5000; i++) {
+		large += (i % 3 == 0) ? block : QByteArray(4096, (char) i);
+	}
+	files.add("large.fz", large);
+
+	QTemporaryDir target;
+	QString zipFilepath = writeFile(QDir(target.path()), "sketch.fzz", QByteArray("an older save"));
+
+	QString error;
+	BOOST_REQUIRE(ZipUtils::zip(files.filepaths, zipFilepath, error));
+	BOOST_CHECK(QFileInfo(zipFilepath).size() < large.size());
+
+	QTemporaryDir unzipped;
+	BOOST_REQUIRE(ZipUtils::unzip(zipFilepath, unzipped.path(), error));
+	checkUnzipped(files, unzipped.path());
+}
+
+BOOST_AUTO_TEST_CASE( ziputils_errors )
+{
+	QTemporaryDir target;
+	QString zipFilepath = QDir(target.path()).filePath("sketch.fzz");
+	QString error;
+
+	// a missing input leaves neither the archive nor a temp file behind
+	BOOST_CHECK(!ZipUtils::zip(QStringList() << QDir(target.path()).filePath("missing.fz"), zipFilepath, error));
+	BOOST_CHECK(!error.isEmpty());
+	BOOST_CHECK(QDir(target.path()).entryList(QDir::Files | QDir::Hidden).isEmpty());
+
+	QString notAZip = writeFile(QDir(target.path()), "broken.fzz", QByteArray("not a zip"));
+	error.clear();
+	BOOST_CHECK(!ZipUtils::unzip(notAZip, target.path(), error));
+	BOOST_CHECK(!error.isEmpty());
+}
@@ -0,0 +1,166 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "utils/bezier.h"
+
+#include <QApplication>
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include <limits>
+
+/*
+Benchmarks for the bezier searches behind dragging a curved wire or trace: the nearest point
+on the curve, with the per unit stepping findSplit used before as the reference, and the
+cached length. Each one runs over 100, 1000 and 5000 random curves.
+
+	bench_bezier [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+struct Curves {
+	QList<Bezier> curves;
+	QList<QPointF> points;		// each one near its curve, the way a mouse press is
+};
+
+Curves makeCurves(int count)
+{
+	QRandomGenerator random(1213);
+	auto point = [&random]() {
+		return QPointF(random.bounded(200.0), random.bounded(200.0));
+	};
+
+	Curves result;
+	for (int i = 0; i < count; i++) {
+		result.curves.append(Bezier(point(), point(), point(), point()));
+		result.points.append(result.curves.last().pointAt(random.bounded(1.0)) + QPointF(random.bounded(2.0) - 1, random.bounded(2.0) - 1));
+	}
+	return result;
+}
+
+// the search findSplit used before: one step per unit of length
+double steppingT(const Bezier & bezier, QPointF p)
+{
+	double bestT = 0;
+	double best = std::numeric_limits<double>::max();
+	double increment = 1.0 / qMax(1.0, bezier.computeCubicCurveLength(1.0, 24));
+	for (double t = 0; t <= 1; t += increment) {
+		QPointF d = p - bezier.pointAt(t);
+		double distance = d.x() * d.x() + d.y() * d.y();
+		if (distance < best) {
+			best = distance;
+			bestT = t;
+		}
+	}
+	return bestT;
+}
+
+void addSizes()
+{
+	QTest::addColumn<int>("curves");
+	for (int curves : { 100, 1000, 5000 }) {
+		QTest::addRow("%d curves", curves) << curves;
+	}
+}
+
+}
+
+class BezierBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void stepping_data();
+	void stepping();
+	void nearestT_data();
+	void nearestT();
+	void length_data();
+	void length();
+};
+
+void BezierBenchmarks::stepping_data()
+{
+	addSizes();
+}
+
+void BezierBenchmarks::stepping()
+{
+	QFETCH(int, curves);
+	Curves data = makeCurves(curves);
+
+	double sum = 0;
+	QBENCHMARK {
+		for (int i = 0; i < data.curves.count(); i++) {
+			sum += steppingT(data.curves.at(i), data.points.at(i));
+		}
+	}
+	QVERIFY(sum >= 0);
+}
+
+void BezierBenchmarks::nearestT_data()
+{
+	addSizes();
+}
+
+void BezierBenchmarks::nearestT()
+{
+	QFETCH(int, curves);
+	Curves data = makeCurves(curves);
+
+	double sum = 0;
+	QBENCHMARK {
+		for (int i = 0; i < data.curves.count(); i++) {
+			sum += data.curves.at(i).nearestT(data.points.at(i));
+		}
+	}
+	QVERIFY(sum >= 0);
+}
+
+void BezierBenchmarks::length_data()
+{
+	addSizes();
+}
+
+void BezierBenchmarks::length()
+{
+	QFETCH(int, curves);
+	Curves data = makeCurves(curves);
+
+	double sum = 0;
+	QBENCHMARK {
+		for (int i = 0; i < data.curves.count(); i++) {
+			sum += data.curves.at(i).length();
+		}
+	}
+	QVERIFY(sum > 0);
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+	BezierBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_bezier.moc"
@@ -0,0 +1,121 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svg/contourtracer.h"
+
+#include <QGuiApplication>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include <cmath>
+
+/*
+Benchmarks for tracing imported logo images into outlines, on generated logos of 256, 1024
+and 4096 pixels square, both lossless and with the staircases smoothed.
+
+	bench_contourtracer [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+// a logo-like picture: rings with holes, islands inside the holes, and some noise
+QImage logoImage(int size)
+{
+	QImage image(size, size, QImage::Format_ARGB32);
+	QRandomGenerator random(99);
+	double center = size / 2.0;
+	for (int y = 0; y < size; y++) {
+		auto * line = reinterpret_cast<QRgb *>(image.scanLine(y));
+		for (int x = 0; x < size; x++) {
+			double r = std::hypot(x - center, y - center) / size;
+			bool on = (int) (r * 40) % 3 == 0 || ((x / 7 + y / 5) % 11 == 0 && random.bounded(4) == 0);
+			line[x] = on ? qRgb(0, 0, 0) : qRgb(200, 180, 160);
+		}
+	}
+	return image;
+}
+
+void addSizes()
+{
+	QTest::addColumn<int>("size");
+	for (int size : { 256, 1024, 4096 }) {
+		QTest::addRow("%dx%d", size, size) << size;
+	}
+}
+
+}
+
+class ContourTracerBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void trace_data();
+	void trace();
+	void smooth_data();
+	void smooth();
+};
+
+void ContourTracerBenchmarks::trace_data()
+{
+	addSizes();
+}
+
+void ContourTracerBenchmarks::trace()
+{
+	QFETCH(int, size);
+	const QImage image = logoImage(size);
+
+	ClipperLib::Paths paths;
+	QBENCHMARK {
+		paths = ContourTracer::trace(image);
+	}
+	QVERIFY(!paths.empty());
+}
+
+void ContourTracerBenchmarks::smooth_data()
+{
+	addSizes();
+}
+
+void ContourTracerBenchmarks::smooth()
+{
+	QFETCH(int, size);
+	const QImage image = logoImage(size);
+
+	ClipperLib::Paths paths;
+	QBENCHMARK {
+		paths = ContourTracer::trace(image, ContourTracer::RemoveCollinear | ContourTracer::SmoothStaircases, 1.0);
+	}
+	QVERIFY(!paths.empty());
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QGuiApplication app(argc, argv);
+	ContourTracerBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_contourtracer.moc"
@@ -0,0 +1,104 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "debugdialog.h"
+
+#include <QApplication>
+#include <QTemporaryDir>
+#include <QtTest>
+
+/*
+Benchmarks for DebugDialog logging: the same burst of messages written on the calling thread
+and handed to the background writer, each flushed to the log file before the round ends.
+
+	bench_debugdialog [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+void discardMessages(QtMsgType, const QMessageLogContext &, const QString &)
+{
+}
+
+}
+
+class DebugDialogBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+	void log_data();
+	void log();
+
+private:
+	QTemporaryDir m_dir;
+};
+
+void DebugDialogBenchmarks::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+	qInstallMessageHandler(discardMessages);
+	DebugDialog::setEnabled(true);
+}
+
+void DebugDialogBenchmarks::cleanupTestCase()
+{
+	DebugDialog::cleanup();
+	qInstallMessageHandler(nullptr);
+}
+
+void DebugDialogBenchmarks::log_data()
+{
+	QTest::addColumn<bool>("synchronous");
+	QTest::addColumn<int>("messages");
+	for (int messages : { 1000, 20000 }) {
+		QTest::addRow("%d messages, synchronous", messages) << true << messages;
+		QTest::addRow("%d messages, background writer", messages) << false << messages;
+	}
+}
+
+void DebugDialogBenchmarks::log()
+{
+	QFETCH(bool, synchronous);
+	QFETCH(int, messages);
+	DebugDialog::setSynchronous(synchronous);
+	DebugDialog::setLogFileName(m_dir.filePath(QString("debug%1%2.txt").arg(messages).arg(synchronous)));
+
+	QBENCHMARK {
+		for (int i = 0; i < messages; i++) {
+			DebugDialog::debug(QString("message %1").arg(i));
+		}
+		DebugDialog::flush();
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+	DebugDialogBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_debugdialog.moc"
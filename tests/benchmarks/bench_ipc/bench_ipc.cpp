@@ -0,0 +1,101 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "ipc/ipc_d_356_writer.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QtTest>
+
+/*
+Benchmarks for the IPC-D-356A netlist export, on panels of 500, 5000 and 50000 test points.
+
+	bench_ipc [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+QList<IPCD356ARecord> panelRecords(int count)
+{
+	QList<IPCD356ARecord> records;
+	for (int i = 0; i < count; i++) {
+		IPCD356ARecord r;
+		r.cmd = (i % 2 == 0) ? IPCD356A::ThroughHole : IPCD356A::SurfaceMount;
+		r.netLabel = QString("NET%1").arg(i / 4);
+		r.partLabel = QString("U%1").arg(i / 16);
+		r.connectorName = "pin";
+		r.connectorId = QString("connector%1").arg(i % 16);
+		r.isMiddle = r.cmd == IPCD356A::ThroughHole;
+		r.isPlated = r.isMiddle;
+		r.isDrilled = r.isMiddle;
+		r.r = r.isDrilled ? 1016 : 0;
+		r.x = (i % 200) * 2540;
+		r.y = -(i / 200) * 2540;
+		r.w = 1880;
+		r.h = r.isDrilled ? 0 : 1500;
+		r.access = r.isMiddle ? 0 : 1;
+		r.ccw_angle = (i % 4) * 90;
+		records << r;
+	}
+	return records;
+}
+
+}
+
+class IPCBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void write_data();
+	void write();
+};
+
+void IPCBenchmarks::write_data()
+{
+	QTest::addColumn<int>("records");
+	for (int records : { 500, 5000, 50000 }) {
+		QTest::addRow("%d records", records) << records;
+	}
+}
+
+void IPCBenchmarks::write()
+{
+	QFETCH(int, records);
+	const QList<IPCD356ARecord> panel = panelRecords(records);
+	const QStringList comments({ "Created with Fritzing (https://fritzing.org/)" });
+
+	bool result = false;
+	QBENCHMARK {
+		QBuffer buffer;
+		buffer.open(QIODevice::WriteOnly);
+		result = writeIPC_D_356A(buffer, "panel.fzz", comments, panel);
+	}
+	QVERIFY(result);
+}
+
+int main(int argc, char * argv[])
+{
+	QCoreApplication app(argc, argv);
+	IPCBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_ipc.moc"
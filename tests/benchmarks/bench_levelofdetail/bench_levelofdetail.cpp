@@ -0,0 +1,122 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "items/levelofdetail.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QtTest>
+
+/*
+Benchmarks for painting a full view of breadboard-like parts, 200 of them on a 1920x1080
+image, exactly and through the level of detail pixmaps, from 100% zoom down to 5%.
+
+	bench_levelofdetail [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+// a breadboard-like svg: a body with a grid of holes
+QByteArray gridSvg(int columns, int rows)
+{
+	QByteArray svg;
+	int width = columns * 9;
+	int height = rows * 9;
+	svg += QString("<svg xmlns='http://www.w3.org/2000/svg' width='%1px' height='%2px' viewBox='0 0 %1 %2'>")
+		.arg(width).arg(height).toUtf8();
+	svg += QString("<rect x='0' y='0' width='%1' height='%2' fill='#d9d9d9' stroke='#999999' stroke-width='2'/>")
+		.arg(width).arg(height).toUtf8();
+	for (int y = 0; y < rows; y++) {
+		for (int x = 0; x < columns; x++) {
+			svg += QString("<circle cx='%1' cy='%2' r='2.5' fill='#404040' stroke='#202020' stroke-width='0.5'/>")
+				.arg(x * 9 + 4.5).arg(y * 9 + 4.5).toUtf8();
+		}
+	}
+	svg += "</svg>";
+	return svg;
+}
+
+}
+
+class LevelOfDetailBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void paint_data();
+	void paint();
+	void cleanupTestCase();
+};
+
+void LevelOfDetailBenchmarks::paint_data()
+{
+	QTest::addColumn<double>("zoom");
+	QTest::addColumn<bool>("pixmap");
+	for (double zoom : { 1.0, 0.5, 0.25, 0.1, 0.05 }) {
+		QTest::addRow("zoom %g, exact", zoom) << zoom << false;
+		QTest::addRow("zoom %g, level of detail", zoom) << zoom << true;
+	}
+}
+
+void LevelOfDetailBenchmarks::paint()
+{
+	static const int Parts = 200;
+
+	QFETCH(double, zoom);
+	QFETCH(bool, pixmap);
+	QSvgRenderer renderer(gridSvg(60, 20));
+	QVERIFY(renderer.isValid());
+	QRectF bounds(0, 0, 540, 180);
+	QImage image(1920, 1080, QImage::Format_ARGB32_Premultiplied);
+
+	QBENCHMARK {
+		image.fill(Qt::white);
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing);
+		painter.scale(zoom, zoom);
+		for (int i = 0; i < Parts; i++) {
+			QRectF r = bounds.translated((i % 10) * bounds.width(), (i / 10) * bounds.height());
+			if (!pixmap || !LevelOfDetail::paintPixmap(&painter, &renderer, 1, r, zoom)) {
+				renderer.render(&painter, r);
+			}
+		}
+	}
+
+	LevelOfDetail::clear();
+}
+
+void LevelOfDetailBenchmarks::cleanupTestCase()
+{
+	LevelOfDetail::clear();
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+	LevelOfDetailBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_levelofdetail.moc"
@@ -0,0 +1,133 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "sketch/localclipboard.h"
+
+#include <QCoreApplication>
+#include <QDomDocument>
+#include <QMimeData>
+#include <QtTest>
+
+#include <memory>
+
+/*
+Benchmarks for the clipboard half of a duplicate, one copy and one paste of 100 and 1000
+parts: through the xml, as before, and through the in-process snapshot. The whole duplicate,
+with loading the pasted parts, is measured by bench_sketch.
+
+	bench_localclipboard [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+// what SketchWidget::copyHeart writes, for a number of parts wired in a chain
+QByteArray copiedXml(int parts)
+{
+	QString xml = "<module><boundingRects><boundingRect view='breadboardView' x='0' y='0' width='100' height='100'/></boundingRects><instances>";
+	for (int i = 0; i < parts; i++) {
+		xml += QString("<instance moduleIdRef='ResistorModuleID' modelIndex='%1' path=':/resources/parts/core/resistor.fzp'>"
+		               "<property name='resistance' value='220'/><title>R%1</title><views>").arg(i + 1);
+		for (const char * view : { "breadboardView", "schematicView", "pcbView" }) {
+			xml += QString("<%1 layer='breadboard'><geometry z='2.5' x='%2' y='10'/><connectors>"
+			               "<connector connectorId='connector0' layer='breadboard'><geometry x='0' y='0'/>"
+			               "<connects><connect connectorId='connector1' modelIndex='%3' layer='breadboard'/></connects>"
+			               "</connector></connectors></%1>").arg(view).arg(i * 40).arg(i);
+		}
+		xml += "</views></instance>";
+	}
+	xml += "</instances></module>";
+	return xml.toUtf8();
+}
+
+void addSizes()
+{
+	QTest::addColumn<int>("parts");
+	for (int parts : { 100, 1000 }) {
+		QTest::addRow("%d parts", parts) << parts;
+	}
+}
+
+}
+
+class LocalClipboardBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void throughXml_data();
+	void throughXml();
+	void throughSnapshot_data();
+	void throughSnapshot();
+	void cleanupTestCase();
+};
+
+void LocalClipboardBenchmarks::throughXml_data()
+{
+	addSizes();
+}
+
+void LocalClipboardBenchmarks::throughXml()
+{
+	QFETCH(int, parts);
+	QDomDocument copied;
+	QVERIFY(copied.setContent(copiedXml(parts)));
+
+	bool result = false;
+	QBENCHMARK {
+		QByteArray xml = copied.toByteArray();
+		QDomDocument pasted;
+		result = static_cast<bool>(pasted.setContent(xml));
+	}
+	QVERIFY(result);
+}
+
+void LocalClipboardBenchmarks::throughSnapshot_data()
+{
+	addSizes();
+}
+
+void LocalClipboardBenchmarks::throughSnapshot()
+{
+	QFETCH(int, parts);
+	QDomDocument copied;
+	QVERIFY(copied.setContent(copiedXml(parts)));
+
+	bool result = false;
+	QBENCHMARK {
+		std::unique_ptr<QMimeData> mimeData(LocalClipboard::mimeData(copied));
+		QDomDocument pasted;
+		result = LocalClipboard::get(mimeData.get(), pasted);
+	}
+	QVERIFY(result);
+}
+
+void LocalClipboardBenchmarks::cleanupTestCase()
+{
+	LocalClipboard::clear();
+}
+
+int main(int argc, char * argv[])
+{
+	QCoreApplication app(argc, argv);
+	LocalClipboardBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_localclipboard.moc"
@@ -0,0 +1,416 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "fapplication.h"
+#include "mainwindow/mainwindow.h"
+#include "sketch/pcbsketchwidget.h"
+#include "connectors/connectoritem.h"
+#include "items/itembase.h"
+#include "utils/graphutils.h"
+#include "utils/fmessagebox.h"
+#include "utils/textutils.h"
+#include "waitpushundostack.h"
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtMath>
+#include <QtTest>
+
+#include <algorithm>
+
+/*
+Benchmarks for the sketch level hot paths: following connections, choosing ratsnest lines,
+copper fill, autorouting and duplicating. They run on sketches generated the way tests/perf/generate_sketch.py
+does it, resistors on a grid whose connectors are spread over half as many nets, loaded into a
+MainWindow like the -benchmark service. The core parts come from the parts library, found the
+usual way or with -f/-parts as for Fritzing itself; all other options go to QTest.
+
+	bench_sketch [-parts FOLDER] [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+const double Pitch = 72.0;				// grid spacing in pixels (0.8 in at 90 dpi)
+const double ResistorSpan = 33.39;		// breadboard distance between connector0 and connector1
+
+QString connectorXml(const QString & layer, const QString & connectorID, const QStringList & connects)
+{
+	QString xml = QString("<connector connectorId='%1' layer='%2'><geometry x='0' y='0'/>").arg(connectorID, layer);
+	if (!connects.isEmpty()) {
+		xml += "<connects>" + connects.join("") + "</connects>";
+	}
+	return xml + "</connector>";
+}
+
+QString connectXml(const QString & connectorID, int modelIndex, const QString & layer)
+{
+	return QString("<connect connectorId='%1' modelIndex='%2' layer='%3'/>").arg(connectorID).arg(modelIndex).arg(layer);
+}
+
+// parts resistors on a grid, their connectors spread over nets, wires breadboard wires joining
+// connectors of the same net so the rest shows up as ratsnest lines, and a two layer board
+QString generateSketch(int parts, int nets, int wires)
+{
+	QRandomGenerator random(1);
+	int columns = qMax(1, qCeil(qSqrt(parts)));
+	int rows = qMax(1, (parts + columns - 1) / columns);
+	auto position = [columns](int part) {
+		return QPointF((part % columns) * Pitch, (part / columns) * Pitch);
+	};
+
+	// connector c is connector(c % 2) of resistor c / 2, which has model index c / 2 + 2
+	QList<QList<int>> members(qMax(1, nets));
+	for (int c = 0; c < parts * 2; c++) {
+		int net = c < members.count() ? c : random.bounded(members.count());
+		members[net].append(c);
+	}
+
+	QList<QPair<int, int>> candidates;
+	for (const QList<int> & net : members) {
+		for (int i = 1; i < net.count(); i++) {
+			candidates.append(qMakePair(net.at(i - 1), net.at(i)));
+		}
+	}
+	std::shuffle(candidates.begin(), candidates.end(), random);
+	candidates = candidates.mid(0, wires);
+
+	QHash<int, QStringList> connects;
+	QString wireXml;
+	for (int n = 0; n < candidates.count(); n++) {
+		int a = candidates.at(n).first;
+		int b = candidates.at(n).second;
+		int index = parts + 2 + n;
+		connects[a].append(connectXml("connector0", index, "breadboardWire"));
+		connects[b].append(connectXml("connector1", index, "breadboardWire"));
+		QPointF p0 = position(a / 2) + QPointF(a % 2 ? ResistorSpan : 0, 0);
+		QPointF p1 = position(b / 2) + QPointF(b % 2 ? ResistorSpan : 0, 0);
+		wireXml += QString("<instance moduleIdRef='WireModuleID' modelIndex='%1' path=':/resources/parts/core/wire.fzp'>"
+		                   "<title>Wire%2</title><views><breadboardView layer='breadboardWire'>"
+		                   "<geometry z='3.5' x='%3' y='%4' x1='0' y1='0' x2='%5' y2='%6' wireFlags='64'/>"
+		                   "<wireExtras mils='22.2222' color='#418dd9' opacity='1' banded='0'/><connectors>")
+		           .arg(index).arg(n + 1).arg(p0.x()).arg(p0.y()).arg(p1.x() - p0.x()).arg(p1.y() - p0.y());
+		wireXml += connectorXml("breadboardWire", "connector0", QStringList(connectXml(a % 2 ? "connector1" : "connector0", a / 2 + 2, "breadboard")));
+		wireXml += connectorXml("breadboardWire", "connector1", QStringList(connectXml(b % 2 ? "connector1" : "connector0", b / 2 + 2, "breadboard")));
+		wireXml += "</connectors></breadboardView></views></instance>";
+	}
+
+	QString partXml;
+	for (int i = 0; i < parts; i++) {
+		QPointF p = position(i);
+		partXml += QString("<instance moduleIdRef='ResistorModuleID' modelIndex='%1' path=':/resources/parts/core/resistor.fzp'>"
+		                   "<property name='resistance' value='220'/><title>R%2</title><views>").arg(i + 2).arg(i + 1);
+		const struct {
+			const char * view;
+			const char * layer;
+			QPointF offset;
+		} Views[] = {
+			{ "breadboardView", "breadboard", QPointF(0, 0) },
+			{ "schematicView", "schematic", QPointF(0, 0) },
+			{ "pcbView", "copper0", QPointF(Pitch, Pitch) },
+		};
+		for (const auto & view : Views) {
+			bool breadboard = QString(view.view) == "breadboardView";
+			partXml += QString("<%1 layer='%2'><geometry z='2.5' x='%3' y='%4'/><connectors>")
+			           .arg(view.view, view.layer).arg(p.x() + view.offset.x()).arg(p.y() + view.offset.y());
+			partXml += connectorXml(view.layer, "connector0", breadboard ? connects.value(i * 2) : QStringList());
+			partXml += connectorXml(view.layer, "connector1", breadboard ? connects.value(i * 2 + 1) : QStringList());
+			partXml += QString("</connectors></%1>").arg(view.view);
+		}
+		partXml += "</views></instance>";
+	}
+
+	// board size in mm, with one pitch of margin on each side
+	double width = (columns + 1) * Pitch * 25.4 / 90;
+	double height = (rows + 1) * Pitch * 25.4 / 90;
+	QString xml;
+	QTextStream stream(&xml);
+	stream << "<?xml version='1.0' encoding='UTF-8'?>\n<module fritzingVersion='1.0.0'><boards>"
+	       << "<board moduleId='TwoLayerRectanglePCBModuleID' title='PCB1' instance='PCB1' width='" << width << "mm' height='" << height << "mm'/>"
+	       << "</boards><instances>"
+	       << "<instance moduleIdRef='TwoLayerRectanglePCBModuleID' modelIndex='1' path=':/resources/parts/core/rectangle_pcb_two_layers.fzp'>"
+	       << "<property name='layers' value='2'/><property name='width' value='" << width << "'/><property name='height' value='" << height << "'/>"
+	       << "<title>PCB1</title><views><pcbView layer='board'><geometry z='1.5' x='0' y='0'/></pcbView></views></instance>"
+	       << partXml << wireXml
+	       << "</instances></module>\n";
+	return xml;
+}
+
+void addSizes(const QList<int> & sizes)
+{
+	QTest::addColumn<int>("parts");
+	for (int parts : sizes) {
+		QTest::addRow("%d parts", parts) << parts;
+	}
+}
+
+SketchWidget * findView(MainWindow * mainWindow, ViewLayer::ViewID viewID)
+{
+	Q_FOREACH (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
+		if (sketchWidget->viewID() == viewID) return sketchWidget;
+	}
+	return nullptr;
+}
+
+}
+
+class SketchBenchmarks : public QObject
+{
+	Q_OBJECT
+
+public:
+	SketchBenchmarks(FApplication *);
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+	void collectEqualPotential_data();
+	void collectEqualPotential();
+	void chooseRatsnestGraph_data();
+	void chooseRatsnestGraph();
+	void groundFill_data();
+	void groundFill();
+	void autoroute_data();
+	void autoroute();
+	void duplicate_data();
+	void duplicate();
+
+private:
+	MainWindow * sketch(int parts);
+
+private:
+	FApplication * m_application = nullptr;
+	QTemporaryDir m_dir;
+	QHash<int, MainWindow *> m_sketches;
+};
+
+SketchBenchmarks::SketchBenchmarks(FApplication * application) : m_application(application)
+{
+}
+
+void SketchBenchmarks::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+}
+
+void SketchBenchmarks::cleanupTestCase()
+{
+	Q_FOREACH (MainWindow * mainWindow, m_sketches) {
+		mainWindow->close();
+		delete mainWindow;
+	}
+	m_sketches.clear();
+}
+
+// each size is generated and loaded once, the benchmarks leave it as they found it
+MainWindow * SketchBenchmarks::sketch(int parts)
+{
+	MainWindow * mainWindow = m_sketches.value(parts, nullptr);
+	if (mainWindow != nullptr) return mainWindow;
+
+	QString filename = m_dir.filePath(QString("synthetic_%1p.fz").arg(parts));
+	if (!TextUtils::writeUtf8(filename, generateSketch(parts, qMax(1, parts / 2), parts))) return nullptr;
+
+	mainWindow = m_application->openWindowForService(false, 3);
+	if (mainWindow == nullptr) return nullptr;
+
+	mainWindow->setCloseSilently(true);
+	if (!mainWindow->loadWhich(filename, false, false, false, "")) {
+		mainWindow->close();
+		delete mainWindow;
+		return nullptr;
+	}
+
+	m_sketches.insert(parts, mainWindow);
+	return mainWindow;
+}
+
+void SketchBenchmarks::collectEqualPotential_data()
+{
+	addSizes({ 10, 100, 500, 2500 });
+}
+
+void SketchBenchmarks::collectEqualPotential()
+{
+	QFETCH(int, parts);
+	MainWindow * mainWindow = sketch(parts);
+	QVERIFY(mainWindow != nullptr);
+	SketchWidget * breadboard = findView(mainWindow, ViewLayer::BreadboardView);
+	QVERIFY(breadboard != nullptr);
+
+	QList<ConnectorItem *> partConnectorItems;
+	Q_FOREACH (QGraphicsItem * item, breadboard->scene()->items()) {
+		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (connectorItem == nullptr) continue;
+		if (connectorItem->attachedToItemType() == ModelPart::Wire) continue;
+
+		partConnectorItems.append(connectorItem);
+	}
+	QVERIFY(partConnectorItems.count() >= parts * 2);
+
+	// every net once, the way SketchWidget::collectAllNets walks them
+	int netCount = 0;
+	QBENCHMARK {
+		QSet<ConnectorItem *> visited;
+		netCount = 0;
+		Q_FOREACH (ConnectorItem * connectorItem, partConnectorItems) {
+			if (visited.contains(connectorItem)) continue;
+
+			QList<ConnectorItem *> connectorItems;
+			connectorItems.append(connectorItem);
+			ConnectorItem::collectEqualPotential(connectorItems, true, ViewGeometry::NoFlag);
+			for (ConnectorItem * equal : connectorItems) visited.insert(equal);
+			netCount++;
+		}
+	}
+	QVERIFY(netCount > 0);
+}
+
+void SketchBenchmarks::chooseRatsnestGraph_data()
+{
+	addSizes({ 10, 100, 500, 2500 });
+}
+
+void SketchBenchmarks::chooseRatsnestGraph()
+{
+	QFETCH(int, parts);
+	MainWindow * mainWindow = sketch(parts);
+	QVERIFY(mainWindow != nullptr);
+	PCBSketchWidget * pcb = mainWindow->pcbView();
+
+	QHash<ConnectorItem *, int> indexer;
+	QList< QList<ConnectorItem *>* > nets;
+	pcb->collectAllNets(indexer, nets, false, pcb->routeBothSides(), false);
+	QVERIFY(!nets.isEmpty());
+
+	ViewGeometry::WireFlags flags = (ViewGeometry::RatsnestFlag | ViewGeometry::NormalFlag | ViewGeometry::PCBTraceFlag | ViewGeometry::SchematicTraceFlag) ^ pcb->getTraceFlag();
+	int lines = 0;
+	QBENCHMARK {
+		lines = 0;
+		Q_FOREACH (QList<ConnectorItem *> * net, nets) {
+			ConnectorPairHash result;
+			GraphUtils::chooseRatsnestGraph(net, flags, result);
+			lines += result.count();
+		}
+	}
+	qDeleteAll(nets);
+	QVERIFY(lines > 0);
+}
+
+void SketchBenchmarks::groundFill_data()
+{
+	addSizes({ 10, 100, 500 });
+}
+
+void SketchBenchmarks::groundFill()
+{
+	QFETCH(int, parts);
+	MainWindow * mainWindow = sketch(parts);
+	QVERIFY(mainWindow != nullptr);
+	PCBSketchWidget * pcb = mainWindow->pcbView();
+
+	// the fill ends up in a command that is never pushed, so the sketch stays as it is
+	bool filled = false;
+	QBENCHMARK {
+		QUndoCommand parentCommand;
+		filled = pcb->groundFill(false, ViewLayer::UnknownLayer, &parentCommand);
+	}
+	QVERIFY(filled);
+}
+
+void SketchBenchmarks::autoroute_data()
+{
+	addSizes({ 10, 25, 50 });
+}
+
+void SketchBenchmarks::autoroute()
+{
+	QFETCH(int, parts);
+	MainWindow * mainWindow = sketch(parts);
+	QVERIFY(mainWindow != nullptr);
+	PCBSketchWidget * pcb = mainWindow->pcbView();
+	mainWindow->setCurrentView(ViewLayer::PCBView);
+
+	// a routing run takes long enough to be measured once; undoing it is not part of the time
+	int before = pcb->undoStack()->count();
+	QBENCHMARK_ONCE {
+		QMetaObject::invokeMethod(mainWindow, "newAutoroute", Qt::DirectConnection);
+	}
+	QVERIFY(pcb->undoStack()->count() > before);
+	pcb->undoStack()->undo();
+}
+
+// Edit > Duplicate of the whole breadboard view, which goes through the in-process clipboard;
+// duplicating 1000 parts should take well under a second
+void SketchBenchmarks::duplicate_data()
+{
+	addSizes({ 100, 1000 });
+}
+
+void SketchBenchmarks::duplicate()
+{
+	QFETCH(int, parts);
+	MainWindow * mainWindow = sketch(parts);
+	QVERIFY(mainWindow != nullptr);
+	SketchWidget * breadboard = findView(mainWindow, ViewLayer::BreadboardView);
+	QVERIFY(breadboard != nullptr);
+	mainWindow->setCurrentView(ViewLayer::BreadboardView);
+	QMetaObject::invokeMethod(mainWindow, "selectAll", Qt::DirectConnection);
+
+	int before = breadboard->undoStack()->count();
+	QBENCHMARK_ONCE {
+		QMetaObject::invokeMethod(mainWindow, "duplicate", Qt::DirectConnection);
+	}
+	QVERIFY(breadboard->undoStack()->count() > before);
+	breadboard->undoStack()->undo();
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+
+	FApplication application(argc, argv);
+	if (application.init() != FInitResultNormal) return 1;
+
+	FMessageBox::BlockMessages = true;
+	application.createUserDataStoreFolderStructures();
+	application.registerFonts();
+	if (!application.loadReferenceModel("", false)) return 1;
+
+	// FApplication::init() has taken what it understands, QTest gets the rest
+	QStringList testArguments;
+	QStringList arguments = application.arguments();
+	for (int i = 0; i < arguments.count(); i++) {
+		static const QStringList FolderOptions = { "-f", "-folder", "--folder", "-pp", "-pa", "-parts", "--parts", "--partsparent" };
+		if (FolderOptions.contains(arguments.at(i), Qt::CaseInsensitive)) {
+			i++;
+			continue;
+		}
+		testArguments.append(arguments.at(i));
+	}
+
+	SketchBenchmarks benchmarks(&application);
+	return QTest::qExec(&benchmarks, testArguments);
+}
+
+#include "bench_sketch.moc"
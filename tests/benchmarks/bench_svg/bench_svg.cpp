@@ -0,0 +1,252 @@
+/*******************************************************************
+
+Part of the Fritzing project - https://fritzing.org
+Copyright (c) 2024 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svg/svg2gerber.h"
+#include "svg/svgfilesplitter.h"
+#include "svg/svgflattener.h"
+#include "utils/graphicsutils.h"
+#include "utils/textutils.h"
+
+#include <QApplication>
+#include <QDomDocument>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtMath>
+#include <QtTest>
+
+/*
+Benchmarks for the svg building blocks that every part goes through when it is loaded, moved
+and exported. Each one runs on generated footprints of 16, 256 and 4096 pads, so that a
+regression shows up as a change in how the time scales, not only in the time itself.
+
+	bench_svg [QTest options, e.g. -csv or -o results.xml,xml]
+*/
+
+namespace {
+
+// a pcb footprint with a grid of pads: inkscape markup, inch units, transforms and text,
+// which is what fixMuch, the splitter and the gerber export see in real parts
+QString footprintSvg(int pads)
+{
+	int columns = qMax(1, qCeil(qSqrt(pads)));
+	int rows = (pads + columns - 1) / columns;
+	int width = columns * 100 + 100;			// 1000 dpi, 0.1 inch pitch
+	int height = rows * 100 + 100;
+
+	QString svg;
+	QTextStream stream(&svg);
+	stream << "<?xml version='1.0' encoding='UTF-8'?>\n"
+	       << "<svg xmlns='http://www.w3.org/2000/svg' xmlns:sodipodi='http://sodipodi.sourceforge.net/DTD/sodipodi-0.dtd'"
+	       << " xmlns:inkscape='http://www.inkscape.org/namespaces/inkscape'"
+	       << " width='" << width / 1000.0 << "in' height='" << height / 1000.0 << "in' viewBox='0 0 " << width << " " << height << "'>\n"
+	       << "<sodipodi:namedview id='namedview' inkscape:zoom='1' inkscape:cx='0' inkscape:cy='0'/>\n"
+	       << "<g id='silkscreen' inkscape:label='silkscreen'>"
+	       << "<rect x='10' y='10' width='" << width - 20 << "' height='" << height - 20 << "' fill='none' stroke='#000000' stroke-width='10'/>"
+	       << "<text x='50' y='40' font-size='30' font-family='OCRA'><tspan x='50' y='40'>U1</tspan></text>"
+	       << "</g>\n"
+	       << "<g id='copper1'><g id='copper0' transform='translate(50,50)'>\n";
+	for (int i = 0; i < pads; i++) {
+		int x = (i % columns) * 100 + 50;
+		int y = (i / columns) * 100 + 50;
+		switch (i % 3) {
+		case 0:
+			stream << "<circle id='connector" << i << "pin' cx='" << x << "' cy='" << y
+			       << "' r='30' fill='none' stroke='#F7BD13' stroke-width='20'/>\n";
+			break;
+		case 1:
+			stream << "<rect id='connector" << i << "pad' x='" << x - 30 << "' y='" << y - 30
+			       << "' width='60' height='60' fill='#F7BD13' transform='rotate(45 " << x << " " << y << ")'/>\n";
+			break;
+		default:
+			stream << "<path id='connector" << i << "pin' d='M" << x - 30 << "," << y
+			       << " a30,30 0 1 0 60,0 a30,30 0 1 0 -60,0 z' fill='none' stroke='#F7BD13' stroke-width='20'/>\n";
+			break;
+		}
+	}
+	stream << "</g></g>\n</svg>\n";
+	return svg;
+}
+
+void addSizes()
+{
+	QTest::addColumn<int>("pads");
+	for (int pads : { 16, 256, 4096 }) {
+		QTest::addRow("%d pads", pads) << pads;
+	}
+}
+
+}
+
+class SvgBenchmarks : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void fixMuch_data();
+	void fixMuch();
+	void fixMuchDom_data();
+	void fixMuchDom();
+	void split_data();
+	void split();
+	void shift_data();
+	void shift();
+	void flatten_data();
+	void flatten();
+	void svg2gerber_data();
+	void svg2gerber();
+
+private:
+	QTemporaryDir m_dir;
+};
+
+void SvgBenchmarks::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+}
+
+void SvgBenchmarks::fixMuch_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::fixMuch()
+{
+	QFETCH(int, pads);
+	const QString source = footprintSvg(pads);
+
+	bool changed = false;
+	QBENCHMARK {
+		QString svg = source;
+		changed = TextUtils::fixMuch(svg, true);
+	}
+	QVERIFY(changed);
+}
+
+// the DOM based version fixMuch replaced, kept as the reference for its results
+void SvgBenchmarks::fixMuchDom_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::fixMuchDom()
+{
+	QFETCH(int, pads);
+	const QString source = footprintSvg(pads);
+
+	bool changed = false;
+	QBENCHMARK {
+		QString svg = source;
+		changed = TextUtils::fixMuchDom(svg, true);
+	}
+	QVERIFY(changed);
+}
+
+void SvgBenchmarks::split_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::split()
+{
+	QFETCH(int, pads);
+	QString filename = m_dir.filePath(QString("footprint%1.svg").arg(pads));
+	QVERIFY(TextUtils::writeUtf8(filename, footprintSvg(pads)));
+
+	bool result = false;
+	QBENCHMARK {
+		SvgFileSplitter splitter;
+		result = splitter.split(filename, "copper0");
+	}
+	QVERIFY(result);
+}
+
+void SvgBenchmarks::shift_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::shift()
+{
+	QFETCH(int, pads);
+	QString svg = footprintSvg(pads);
+	SvgFileSplitter splitter;
+	QVERIFY(splitter.splitString(svg, "copper0"));
+
+	// there and back again, the way SketchWidget shifts a layer for export
+	QString shifted;
+	QBENCHMARK {
+		shifted = splitter.shift(25, 25, "copper0", true);
+		splitter.shift(-25, -25, "copper0", true);
+	}
+	QVERIFY(!shifted.isEmpty());
+}
+
+void SvgBenchmarks::flatten_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::flatten()
+{
+	QFETCH(int, pads);
+	QDomDocument source;
+	QVERIFY(source.setContent(footprintSvg(pads)));
+
+	// flattening works in place, so each round starts from a fresh copy
+	QBENCHMARK {
+		QDomDocument document = source.cloneNode(true).toDocument();
+		QDomElement root = document.documentElement();
+		SvgFlattener flattener;
+		flattener.flattenChildren(root, SvgAttributesMap());
+	}
+}
+
+void SvgBenchmarks::svg2gerber_data()
+{
+	addSizes();
+}
+
+void SvgBenchmarks::svg2gerber()
+{
+	QFETCH(int, pads);
+	const QString svg = footprintSvg(pads);
+	QSizeF svgSize = TextUtils::parseForWidthAndHeight(svg) * GraphicsUtils::StandardFritzingDPI;
+
+	QString gerber;
+	QBENCHMARK {
+		SVG2gerber converter;
+		converter.convert(svg, true, "copper0", SVG2gerber::ForCopper, svgSize);
+		gerber = converter.getGerber();
+	}
+	QVERIFY(gerber.contains("M02*"));
+}
+
+int main(int argc, char * argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+	SvgBenchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "bench_svg.moc"
@@ -0,0 +1,3 @@
+TEMPLATE = subdirs
+
+SUBDIRS = bench_svg bench_sketch bench_debugdialog bench_bezier bench_ipc bench_contourtracer bench_levelofdetail bench_localclipboard
@@ -0,0 +1,93 @@
+# /*******************************************************************
+# Part of the Fritzing project - http://fritzing.org
+# Copyright (c) 2024 Fritzing GmbH
+# Fritzing is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# Fritzing is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with Fritzing. If not, see <http://www.gnu.org/licenses/>.
+# ********************************************************************/
+
+# Links the whole application, without its main(), into a test or benchmark so it can load
+# sketches into a MainWindow the way the command line services do. Include it first.
+
+CONFIG += c++17
+
+unix:!macx {
+    CONFIG += link_pkgconfig
+    HARDWARE_PLATFORM = $$system(uname -m)
+    contains(HARDWARE_PLATFORM, x86_64) {
+        DEFINES += LINUX_64
+    } else {
+        DEFINES += LINUX_32
+    }
+    LIBS += -lz
+}
+macx {
+    LIBS += -lz
+    LIBS += -framework CoreFoundation
+    LIBS += -framework Carbon
+    LIBS += -framework IOKit
+    LIBS += -liconv
+}
+
+QT += concurrent core gui network printsupport serialport sql svg widgets xml
+equals(QT_MAJOR_VERSION, 6) {
+  QT += core5compat svgwidgets openglwidgets
+}
+
+FRITZING_ROOT = $$absolute_path(.., $$PWD)
+
+# the .pri files list their files relative to phoenix.pro, and some of them look for
+# the sibling libraries from there
+_PRO_FILE_PWD_ = $$FRITZING_ROOT
+absolute_boost = 1
+
+include($$FRITZING_ROOT/pri/openssl3.pri)
+include($$FRITZING_ROOT/pri/libgit2detect.pri)
+include($$FRITZING_ROOT/pri/boostdetect.pri)
+include($$FRITZING_ROOT/pri/spicedetect.pri)
+include($$FRITZING_ROOT/pri/quazipdetect.pri)
+include($$FRITZING_ROOT/pri/svgppdetect.pri)
+include($$FRITZING_ROOT/pri/kitchensink.pri)
+include($$FRITZING_ROOT/pri/mainwindow.pri)
+include($$FRITZING_ROOT/pri/partsbinpalette.pri)
+include($$FRITZING_ROOT/pri/partseditor.pri)
+include($$FRITZING_ROOT/pri/referencemodel.pri)
+include($$FRITZING_ROOT/pri/svg.pri)
+include($$FRITZING_ROOT/pri/help.pri)
+include($$FRITZING_ROOT/pri/version.pri)
+include($$FRITZING_ROOT/pri/eagle.pri)
+include($$FRITZING_ROOT/pri/utils.pri)
+include($$FRITZING_ROOT/pri/dock.pri)
+include($$FRITZING_ROOT/pri/items.pri)
+include($$FRITZING_ROOT/pri/autoroute.pri)
+include($$FRITZING_ROOT/src/dialogs/dialogs.pri)
+include($$FRITZING_ROOT/src/ipc/ipc.pri)
+include($$FRITZING_ROOT/pri/connectors.pri)
+include($$FRITZING_ROOT/pri/infoview.pri)
+include($$FRITZING_ROOT/pri/model.pri)
+include($$FRITZING_ROOT/pri/sketch.pri)
+include($$FRITZING_ROOT/pri/program.pri)
+include($$FRITZING_ROOT/pri/testing.pri)
+include($$FRITZING_ROOT/pri/simulation.pri)
+include($$FRITZING_ROOT/test/version.pri)
+include($$FRITZING_ROOT/pri/clipper1detect.pri)
+
+for(file, HEADERS): APP_HEADERS += $$absolute_path($$file, $$FRITZING_ROOT)
+for(file, SOURCES): APP_SOURCES += $$absolute_path($$file, $$FRITZING_ROOT)
+for(file, FORMS): APP_FORMS += $$absolute_path($$file, $$FRITZING_ROOT)
+for(dir, INCLUDEPATH): APP_INCLUDEPATH += $$absolute_path($$dir, $$FRITZING_ROOT)
+HEADERS = $$APP_HEADERS
+SOURCES = $$APP_SOURCES
+SOURCES -= $$FRITZING_ROOT/src/main.cpp
+FORMS = $$APP_FORMS
+INCLUDEPATH = $$APP_INCLUDEPATH
+INCLUDEPATH += $$FRITZING_ROOT/src
+
+RESOURCES += $$FRITZING_ROOT/phoenixresources.qrc
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+#
+# Generates a synthetic Fritzing sketch (.fz) for the -benchmark service.
+#
+# usage:
+#	generate_sketch.py --parts N --nets M --wires K --out FILE [--seed S]
+#
+# N resistors are laid out on a grid in all three views and their connectors are
+# distributed over M nets.  K breadboard wires join connectors of the same net, so
+# the remaining connections show up as ratsnest lines in schematic and pcb view.
+# A two layer board is sized to hold all parts.
+
+import argparse
+import math
+import random
+from xml.sax.saxutils import quoteattr
+
+PITCH = 72.0		# grid spacing in pixels (0.8 in at 90 dpi)
+RESISTOR_SPAN = 33.39	# breadboard distance between connector0 and connector1
+
+def connector_xml(view_layer, connector_id, connects, indent):
+	pad = "\t" * indent
+	lines = [pad + '<connector connectorId="%s" layer="%s">' % (connector_id, view_layer),
+		pad + '\t<geometry x="0" y="0"/>']
+	if connects:
+		lines.append(pad + '\t<connects>')
+		for (cid, index, layer) in connects:
+			lines.append(pad + '\t\t<connect connectorId="%s" modelIndex="%d" layer="%s"/>' % (cid, index, layer))
+		lines.append(pad + '\t</connects>')
+	lines.append(pad + '</connector>')
+	return "\n".join(lines)
+
+def resistor_xml(index, title, pos, connects):
+	x, y = pos
+	views = [("breadboardView", "breadboard", x, y),
+		("schematicView", "schematic", x, y),
+		("pcbView", "copper0", x + PITCH, y + PITCH)]
+	out = ['\t\t<instance moduleIdRef="ResistorModuleID" modelIndex="%d" path=":/resources/parts/core/resistor.fzp">' % index,
+		'\t\t\t<property name="resistance" value="220"/>',
+		'\t\t\t<title>%s</title>' % title,
+		'\t\t\t<views>']
+	for (view, layer, vx, vy) in views:
+		out.append('\t\t\t\t<%s layer="%s">' % (view, layer))
+		out.append('\t\t\t\t\t<geometry z="2.5" x="%g" y="%g"/>' % (vx, vy))
+		out.append('\t\t\t\t\t<connectors>')
+		for cid in ("connector0", "connector1"):
+			c = connects.get(cid, []) if view == "breadboardView" else []
+			out.append(connector_xml(layer, cid, c, 6))
+		out.append('\t\t\t\t\t</connectors>')
+		out.append('\t\t\t\t</%s>' % view)
+	out.append('\t\t\t</views>')
+	out.append('\t\t</instance>')
+	return "\n".join(out)
+
+def wire_xml(index, title, p0, p1, end0, end1):
+	out = ['\t\t<instance moduleIdRef="WireModuleID" modelIndex="%d" path=":/resources/parts/core/wire.fzp">' % index,
+		'\t\t\t<title>%s</title>' % title,
+		'\t\t\t<views>',
+		'\t\t\t\t<breadboardView layer="breadboardWire">',
+		'\t\t\t\t\t<geometry z="3.5" x="%g" y="%g" x1="0" y1="0" x2="%g" y2="%g" wireFlags="64"/>' % (p0[0], p0[1], p1[0] - p0[0], p1[1] - p0[1]),
+		'\t\t\t\t\t<wireExtras mils="22.2222" color="#418dd9" opacity="1" banded="0"/>',
+		'\t\t\t\t\t<connectors>',
+		connector_xml("breadboardWire", "connector0", [end0], 6),
+		connector_xml("breadboardWire", "connector1", [end1], 6),
+		'\t\t\t\t\t</connectors>',
+		'\t\t\t\t</breadboardView>',
+		'\t\t\t</views>',
+		'\t\t</instance>']
+	return "\n".join(out)
+
+def board_xml(index, width, height):
+	return "\n".join([
+		'\t\t<instance moduleIdRef="TwoLayerRectanglePCBModuleID" modelIndex="%d" path=":/resources/parts/core/rectangle_pcb_two_layers.fzp">' % index,
+		'\t\t\t<property name="layers" value="2"/>',
+		'\t\t\t<property name="width" value="%g"/>' % width,
+		'\t\t\t<property name="height" value="%g"/>' % height,
+		'\t\t\t<title>PCB1</title>',
+		'\t\t\t<views>',
+		'\t\t\t\t<pcbView layer="board">',
+		'\t\t\t\t\t<geometry z="1.5" x="0" y="0"/>',
+		'\t\t\t\t</pcbView>',
+		'\t\t\t</views>',
+		'\t\t</instance>'])
+
+def generate(parts, nets, wires, seed):
+	rng = random.Random(seed)
+	columns = max(1, int(math.ceil(math.sqrt(parts))))
+	rows = max(1, int(math.ceil(parts / float(columns))))
+
+	positions = []
+	for i in range(parts):
+		positions.append(((i % columns) * PITCH, (i // columns) * PITCH))
+
+	# model indexes: board 1, parts 2..N+1, wires after that
+	partIndex = lambda i: i + 2
+	connectors = [(i, cid) for i in range(parts) for cid in ("connector0", "connector1")]
+	netOf = {}
+	members = [[] for _ in range(max(1, nets))]
+	for n, c in enumerate(connectors):
+		net = n % len(members) if n < len(members) else rng.randrange(len(members))
+		netOf[c] = net
+		members[net].append(c)
+
+	candidates = []
+	for m in members:
+		for a, b in zip(m, m[1:]):
+			candidates.append((a, b))
+	rng.shuffle(candidates)
+	candidates = candidates[:wires]
+
+	def connectorPos(c):
+		x, y = positions[c[0]]
+		return (x + (RESISTOR_SPAN if c[1] == "connector1" else 0), y)
+
+	connects = {}
+	wireXml = []
+	for n, (a, b) in enumerate(candidates):
+		index = parts + 2 + n
+		connects.setdefault(a, []).append(("connector0", index, "breadboardWire"))
+		connects.setdefault(b, []).append(("connector1", index, "breadboardWire"))
+		wireXml.append(wire_xml(index, "Wire%d" % (n + 1), connectorPos(a), connectorPos(b),
+			(a[1], partIndex(a[0]), "breadboard"), (b[1], partIndex(b[0]), "breadboard")))
+
+	partXml = []
+	for i in range(parts):
+		c = {cid: connects.get((i, cid), []) for cid in ("connector0", "connector1")}
+		partXml.append(resistor_xml(partIndex(i), "R%d" % (i + 1), positions[i], c))
+
+	# board size in mm, with one pitch of margin on each side
+	width = (columns + 1) * PITCH * 25.4 / 90
+	height = (rows + 1) * PITCH * 25.4 / 90
+	out = ['<?xml version="1.0" encoding="UTF-8"?>',
+		'<module fritzingVersion="1.0.0">',
+		'\t<boards>',
+		'\t\t<board moduleId="TwoLayerRectanglePCBModuleID" title="PCB1" instance="PCB1" width="%gmm" height="%gmm"/>' % (width, height),
+		'\t</boards>',
+		'\t<instances>',
+		board_xml(1, width, height)]
+	out.extend(partXml)
+	out.extend(wireXml)
+	out.extend(['\t</instances>', '</module>', ''])
+	return "\n".join(out)
+
+def main():
+	parser = argparse.ArgumentParser(description="generate a synthetic Fritzing sketch")
+	parser.add_argument("--parts", type=int, default=100, help="number of resistors")
+	parser.add_argument("--nets", type=int, default=50, help="number of nets")
+	parser.add_argument("--wires", type=int, default=100, help="number of breadboard wires")
+	parser.add_argument("--seed", type=int, default=1, help="random seed")
+	parser.add_argument("--out", required=True, help="output .fz file")
+	args = parser.parse_args()
+
+	with open(args.out, "w") as f:
+		f.write(generate(args.parts, args.nets, args.wires, args.seed))
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,36 @@
+#!/bin/sh
+#
+# Generates the synthetic benchmark sketches and runs them through the
+# Fritzing -benchmark service without a display.  Timings are written to
+# OUTDIR/benchmark-results.json.
+#
+# usage:
+#	run_benchmarks.sh FRITZING_EXECUTABLE [OUTDIR]
+
+set -e
+
+if [ -z "$1" ]; then
+	echo "usage: $0 FRITZING_EXECUTABLE [OUTDIR]"
+	exit 2
+fi
+
+FRITZING="$1"
+OUTDIR="${2:-$(mktemp -d)}"
+HERE="$(cd "$(dirname "$0")" && pwd)"
+
+mkdir -p "$OUTDIR"
+
+# parts nets wires
+while read -r parts nets wires; do
+	python3 "$HERE/generate_sketch.py" --parts "$parts" --nets "$nets" --wires "$wires" \
+		--out "$OUTDIR/synthetic_${parts}p_${nets}n_${wires}w.fz"
+done <<SIZES
+10 5 10
+100 50 100
+500 200 600
+2500 1000 5000
+SIZES
+
+QT_QPA_PLATFORM=offscreen "$FRITZING" -benchmark "$OUTDIR"
+
+echo "results: $OUTDIR/benchmark-results.json"